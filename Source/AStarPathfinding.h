@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "CustomPriorityQueue.h"
+#include "FrameAllocator.h"
+#include "CustomSmallVector.h"
 
 /**
  * AStarPathfinding:
@@ -75,13 +77,13 @@ private:
     }
 
     // Get neighboring nodes (8-directional for 2D, or custom)
-    static void GetNeighbors(FAStarNode* CurrentNode, TArray<FAStarNode*>& Neighbors, 
+    static void GetNeighbors(FAStarNode* CurrentNode, CustomSmallVector<FAStarNode*, 8>& Neighbors, 
                             const TArray<FAStarNode*>& AllNodes, float GridSize = 100.0f)
     {
-        Neighbors.Empty();
+        Neighbors.Reset();
 
         // Define 8 directions (or 26 for 3D)
-        TArray<FVector> Directions = {
+        const FVector Directions[] = {
             FVector(GridSize, 0, 0),      // Right
             FVector(-GridSize, 0, 0),     // Left
             FVector(0, GridSize, 0),      // Forward
@@ -161,8 +163,11 @@ public:
         // Open list (nodes to be evaluated) - using custom priority queue
         CustomPriorityQueue<FAStarNode*> OpenList;
         
-        // Closed list (nodes already evaluated)
-        TArray<FAStarNode*> ClosedList;
+        // Closed list (nodes already evaluated) in the frame arena
+        TFrameArray<FAStarNode*> ClosedList;
+
+        // At most 8 neighbors per node, so the list never leaves its inline buffer
+        CustomSmallVector<FAStarNode*, 8> Neighbors;
 
         // Add start node to open list
         StartNode->HCost = CalculateHeuristic(StartNode->Position, EndNode->Position);
@@ -186,7 +191,6 @@ public:
             }
 
             // Get neighbors
-            TArray<FAStarNode*> Neighbors;
             GetNeighbors(CurrentNode, Neighbors, AllNodes, GridSize);
 
             for (FAStarNode* Neighbor : Neighbors)
@@ -3,7 +3,9 @@
 #include "BTT_Attack.h"
 #include "Enemy_Controller.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
 #include "EnemyKeys.h"
+#include "EnemyDirectorEnhanced.h"
 
 // Constructor implementation
 UBTT_Attack::UBTT_Attack(FObjectInitializer const& pObjectInit)
@@ -19,11 +21,31 @@ EBTNodeResult::Type UBTT_Attack::ExecuteTask(UBehaviorTreeComponent& pTreeCompon
     AEnemy_Controller* pAiController = Cast<AEnemy_Controller>(pTreeComponent.GetAIOwner());
     AEnemy* pEnemy = Cast<AEnemy>(pAiController->GetPawn());
 
+    // Director-driven path: the combat state machine replaces montage polling.
+    AEnemyDirectorEnhanced* pDirector = pEnemy->GetCombatDirector();
+    if (pDirector != nullptr)
+    {
+        const int iCombatIndex = pEnemy->GetCombatIndex();
+        if (pDirector->IsCombatReady(iCombatIndex))
+        {
+            // Ready but out of range: let the tree move on (chase) right away.
+            bool bCanAttack = pAiController->GetBlackboard()->GetValue<UBlackboardKeyType_Bool>(pAiController->GetBlackboardKeys().IsPlayerInRange);
+            if (!bCanAttack || !pDirector->TryBeginAttack(iCombatIndex))
+            {
+                return EBTNodeResult::Succeeded;
+            }
+        }
+
+        // Mid-swing or cooling down: sleep until the director reports the transition back to Ready.
+        WaitForMessage(pTreeComponent, EnemyKeys::CombatReady);
+        return EBTNodeResult::InProgress;
+    }
+
     // Ensure the enemy isn't currently mid-swing to prevent animation clipping/spamming.
     if (AttackMontageFinished(pEnemy))
     {
         // Check the Blackboard state to see if the "IsPlayerInRange" service has determined valid range.
-        bool bCanAttack = pAiController->GetBlackboard()->GetValueAsBool(EnemyKeys::IsPlayerInRange);
+        bool bCanAttack = pAiController->GetBlackboard()->GetValue<UBlackboardKeyType_Bool>(pAiController->GetBlackboardKeys().IsPlayerInRange);
         
         // If animation is done and player is close enough, execute the attack.
         if (bCanAttack)
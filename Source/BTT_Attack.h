@@ -10,6 +10,9 @@
  * UBTT_Attack:
  * Custom Behavior Tree Task that handles the logic for triggering an enemy attack.
  * It ensures attacks only happen when the previous animation is finished and the target is in range.
+ * When a director tracks the enemy's combat state, the task stays latent while the enemy is attacking
+ * or cooling down and is woken by the director's EnemyKeys::CombatReady message, instead of the tree
+ * re-entering the task every tick to poll the montage.
  */
 UCLASS()
 class PROJECT_GOLDFISH_API UBTT_Attack : public UBTTask_BlackboardBase
@@ -24,5 +27,6 @@ public:
 	EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& pTreeComponent, uint8* pNodeMemory);
 
 	// Helper function to check if the specific attack animation montage has finished playing.
+	// Only used for enemies without a director combat slot.
 	bool AttackMontageFinished(AEnemy* pEnemy);
 };
\ No newline at end of file
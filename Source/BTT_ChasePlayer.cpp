@@ -1,6 +1,7 @@
 
 #include "BTT_ChasePlayer.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "Runtime/NavigationSystem/Public/NavigationSystem.h"
 #include "Enemy_Controller.h"
 #include "EnemyKeys.h"
@@ -25,9 +26,9 @@ EBTNodeResult::Type UBTT_ChasePlayer::ExecuteTask(UBehaviorTreeComponent& pTreeC
     // Only proceed if the navigation system is valid (navmesh exists)
     if (pNavSystem != nullptr)
     {
-        // 1. Retrieve the target destination vector from the Blackboard using the key defined in EnemyKeys.
+        // 1. Retrieve the target destination vector from the Blackboard using the controller's cached key ID.
         // 2. Instruct the AI Controller to move the pawn to that location using standard pathfinding.
-        FVector pLocation  = pAIController->GetBlackboard()->GetValueAsVector(EnemyKeys::TargetLocation);
+        FVector pLocation  = pAIController->GetBlackboard()->GetValue<UBlackboardKeyType_Vector>(pAIController->GetBlackboardKeys().TargetLocation);
         pAIController->MoveToLocation(pLocation);
     }
 
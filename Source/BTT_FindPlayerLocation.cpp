@@ -1,10 +1,12 @@
 
 #include "BTT_FindPlayerLocation.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "Runtime/NavigationSystem/Public/NavigationSystem.h"
 #include "Enemy_Controller.h"
 #include "EnemyKeys.h"
 #include "Kismet/GameplayStatics.h"
+#include "PlayerCache.h"
 
 // Constructor implementation
 UBTT_FindPlayerLocation::UBTT_FindPlayerLocation(FObjectInitializer const& a_pObjectInit)
@@ -24,15 +26,14 @@ EBTNodeResult::Type UBTT_FindPlayerLocation::ExecuteTask(UBehaviorTreeComponent&
     // Get the navigation system to ensure valid navigation exists (though we rely mostly on player position here)
     UNavigationSystemV1* pNavSystem = UNavigationSystemV1::GetCurrent(pWorld);
 
-    // Retrieve the player controller and the player pawn to find their location
-    APlayerController* pPlayerController = UGameplayStatics::GetPlayerController(pWorld, 0);
-    APawn* pPlayer = pPlayerController->GetPawn();
+    // Retrieve the cached player pawn to find their location
+    APawn* pPlayer = pWorld->GetSubsystem<UPlayerCache>()->GetPlayerPawn();
 
-    if (pNavSystem != nullptr)
+    if (pNavSystem != nullptr && pPlayer != nullptr)
     {
         // Update the Blackboard key "TargetLocation" with the player's current world position.
         // This is the critical step that allows the "Chase" task to know where to go.
-        pAIController->GetBlackboard()->SetValueAsVector(EnemyKeys::TargetLocation, pPlayer->GetActorLocation());
+        pAIController->GetBlackboard()->SetValue<UBlackboardKeyType_Vector>(pAIController->GetBlackboardKeys().TargetLocation, pPlayer->GetActorLocation());
     }
 
     // Signal that the task finished successfully.
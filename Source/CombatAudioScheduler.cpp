@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CombatAudioScheduler.h"
+#include "Components/AudioComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundBase.h"
+#include "PlayerCache.h"
+
+UCombatAudioScheduler::UCombatAudioScheduler()
+{
+	// Default voice budget per category.
+	m_VoiceLimits[(int32)ECombatSoundCategory::Weapon] = 4;
+	m_VoiceLimits[(int32)ECombatSoundCategory::Impact] = 4;
+	m_VoiceLimits[(int32)ECombatSoundCategory::EnemyDamaged] = 6;
+	m_VoiceLimits[(int32)ECombatSoundCategory::EnemyAttack] = 6;
+	m_VoiceLimits[(int32)ECombatSoundCategory::EnemyDeath] = 6;
+}
+
+void UCombatAudioScheduler::RequestSound(USoundBase* Sound, const FVector& Location, ECombatSoundCategory Category, float Priority)
+{
+	if (Sound == nullptr || Category >= ECombatSoundCategory::Count)
+		return;
+
+	FSoundRequest& request = m_Requests.AddDefaulted_GetRef();
+	request.Sound = Sound;
+	request.Location = Location;
+	request.Category = Category;
+	request.Priority = Priority;
+}
+
+void UCombatAudioScheduler::SetVoiceLimit(ECombatSoundCategory Category, int32 MaxVoices)
+{
+	if (Category < ECombatSoundCategory::Count)
+	{
+		m_VoiceLimits[(int32)Category] = FMath::Max(0, MaxVoices);
+	}
+}
+
+void UCombatAudioScheduler::GetFrameStats(int32& OutRequests, int32& OutPlayed, int32& OutCulledByDistance, int32& OutCoalesced,
+                                          int32& OutCulledByVoiceLimit, int32& OutEvicted) const
+{
+	OutRequests = m_iRequests;
+	OutPlayed = m_iPlayed;
+	OutCulledByDistance = m_iCulledByDistance;
+	OutCoalesced = m_iCoalesced;
+	OutCulledByVoiceLimit = m_iCulledByVoiceLimit;
+	OutEvicted = m_iEvicted;
+}
+
+TStatId UCombatAudioScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatAudioScheduler, STATGROUP_Tickables);
+}
+
+void UCombatAudioScheduler::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UWorld* pWorld = GetWorld();
+	const double now = pWorld->GetTimeSeconds();
+
+	// Forget voices that finished and coalesce history older than the window.
+	for (TArray<FActiveVoice>& voices : m_ActiveVoices)
+	{
+		voices.RemoveAllSwap([](const FActiveVoice& Voice) { return !Voice.Component.IsValid() || !Voice.Component->IsPlaying(); }, EAllowShrinking::No);
+	}
+	m_RecentSounds.RemoveAllSwap([this, now](const FRecentSound& Recent) { return now - Recent.Time > m_fCoalesceWindow; }, EAllowShrinking::No);
+
+	m_iRequests = m_Requests.Num();
+	m_iPlayed = m_iCulledByDistance = m_iCoalesced = m_iCulledByVoiceLimit = m_iEvicted = 0;
+	if (m_Requests.Num() == 0)
+		return;
+
+	// Listener is the player's camera; without one nothing is audible.
+	APlayerController* pController = pWorld->GetSubsystem<UPlayerCache>()->GetPlayerController();
+	if (pController == nullptr || pController->PlayerCameraManager == nullptr)
+	{
+		m_iCulledByDistance = m_Requests.Num();
+		m_Requests.Reset();
+		return;
+	}
+	const FVector listener = pController->PlayerCameraManager->GetCameraLocation();
+
+	// Distance culling and scoring.
+	for (int32 i = m_Requests.Num() - 1; i >= 0; i--)
+	{
+		FSoundRequest& request = m_Requests[i];
+		const float fMaxDistance = FMath::Min(m_fMaxAudibleDistance, request.Sound->GetMaxDistance());
+		const float fDistance = (float)FVector::Dist(request.Location, listener);
+		if (fDistance > fMaxDistance)
+		{
+			m_Requests.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			m_iCulledByDistance++;
+			continue;
+		}
+
+		request.Score = request.Priority * (1.0f - fDistance / FMath::Max(fMaxDistance, 1.0f));
+	}
+
+	// Highest score first, so the best requests claim voices before the rest are considered.
+	m_Requests.Sort([](const FSoundRequest& A, const FSoundRequest& B) { return A.Score > B.Score; });
+
+	for (const FSoundRequest& request : m_Requests)
+	{
+		if (IsCoalesced(request, now))
+		{
+			m_iCoalesced++;
+			continue;
+		}
+
+		if (!AdmitVoice(request))
+		{
+			m_iCulledByVoiceLimit++;
+			continue;
+		}
+
+		m_RecentSounds.Add({ request.Sound, request.Location, now });
+		m_iPlayed++;
+	}
+
+	m_Requests.Reset();
+}
+
+bool UCombatAudioScheduler::IsCoalesced(const FSoundRequest& Request, double Now) const
+{
+	const float fRadiusSquared = m_fCoalesceRadius * m_fCoalesceRadius;
+	for (const FRecentSound& recent : m_RecentSounds)
+	{
+		if (recent.Sound == Request.Sound && FVector::DistSquared(recent.Location, Request.Location) <= fRadiusSquared)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UCombatAudioScheduler::AdmitVoice(const FSoundRequest& Request)
+{
+	TArray<FActiveVoice>& voices = m_ActiveVoices[(int32)Request.Category];
+	const int32 iLimit = m_VoiceLimits[(int32)Request.Category];
+	if (iLimit <= 0)
+		return false;
+
+	if (voices.Num() >= iLimit)
+	{
+		// Category full: evict the lowest scoring voice only if this request beats it.
+		int32 iLowest = 0;
+		for (int32 i = 1; i < voices.Num(); i++)
+		{
+			if (voices[i].Score < voices[iLowest].Score)
+			{
+				iLowest = i;
+			}
+		}
+
+		if (voices[iLowest].Score >= Request.Score)
+			return false;
+
+		if (UAudioComponent* pEvicted = voices[iLowest].Component.Get())
+		{
+			pEvicted->Stop();
+		}
+		voices.RemoveAtSwap(iLowest, 1, EAllowShrinking::No);
+		m_iEvicted++;
+	}
+
+	UAudioComponent* pComponent = UGameplayStatics::SpawnSoundAtLocation(GetWorld(), Request.Sound, Request.Location);
+	if (pComponent == nullptr)
+		return false;
+
+	voices.Add({ pComponent, Request.Score });
+	return true;
+}
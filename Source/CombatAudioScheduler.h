@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatAudioScheduler.generated.h"
+
+class USoundBase;
+class UAudioComponent;
+
+// Voice budget groups for combat sounds.
+UENUM(BlueprintType)
+enum class ECombatSoundCategory : uint8
+{
+	Weapon,
+	Impact,
+	EnemyDamaged,
+	EnemyAttack,
+	EnemyDeath,
+	Count UMETA(Hidden)
+};
+
+/**
+ * UCombatAudioScheduler:
+ * Single entry point for combat sounds. Requests are collected during the frame and admitted once per tick:
+ * - Distance culling: requests beyond the sound's attenuation range (or m_fMaxAudibleDistance) are dropped.
+ * - Coalescing: the same sound requested again within m_fCoalesceWindow seconds and m_fCoalesceRadius units is merged.
+ * - Voice limits: each category has a maximum number of playing voices.
+ * - Priority eviction: a full category stops its lowest scoring voice if a new request scores higher.
+ *   Score = priority scaled down with distance to the listener, so near and important sounds win.
+ * Culled request counts are kept per frame.
+ */
+UCLASS()
+class PROJECT_GOLDFISH_API UCombatAudioScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UCombatAudioScheduler();
+
+	// Ask for a sound to be played this frame. It may be coalesced or culled.
+	UFUNCTION(BlueprintCallable, Category="Audio")
+	void RequestSound(USoundBase* Sound, const FVector& Location, ECombatSoundCategory Category, float Priority = 1.0f);
+
+	// Change the voice budget of a category.
+	UFUNCTION(BlueprintCallable, Category="Audio")
+	void SetVoiceLimit(ECombatSoundCategory Category, int32 MaxVoices);
+
+	// Requests seen and culled (by reason) in the last processed frame.
+	UFUNCTION(BlueprintPure, Category="Performance")
+	void GetFrameStats(int32& OutRequests, int32& OutPlayed, int32& OutCulledByDistance, int32& OutCoalesced,
+	                   int32& OutCulledByVoiceLimit, int32& OutEvicted) const;
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	float m_fMaxAudibleDistance = 5000.0f;
+	float m_fCoalesceWindow = 0.05f;
+	float m_fCoalesceRadius = 300.0f;
+
+private:
+	struct FSoundRequest
+	{
+		USoundBase* Sound = nullptr;
+		FVector Location = FVector::ZeroVector;
+		ECombatSoundCategory Category = ECombatSoundCategory::Weapon;
+		float Priority = 1.0f;
+		float Score = 0.0f;
+	};
+
+	struct FActiveVoice
+	{
+		TWeakObjectPtr<UAudioComponent> Component;
+		float Score = 0.0f;
+	};
+
+	struct FRecentSound
+	{
+		USoundBase* Sound = nullptr;
+		FVector Location = FVector::ZeroVector;
+		double Time = 0.0;
+	};
+
+	TArray<FSoundRequest> m_Requests;
+	TArray<FActiveVoice> m_ActiveVoices[(int32)ECombatSoundCategory::Count];
+	int32 m_VoiceLimits[(int32)ECombatSoundCategory::Count];
+	TArray<FRecentSound> m_RecentSounds;
+
+	// Stats for the last processed frame.
+	int32 m_iRequests = 0;
+	int32 m_iPlayed = 0;
+	int32 m_iCulledByDistance = 0;
+	int32 m_iCoalesced = 0;
+	int32 m_iCulledByVoiceLimit = 0;
+	int32 m_iEvicted = 0;
+
+	// True if the same sound played (or was admitted this frame) close by within the coalesce window.
+	bool IsCoalesced(const FSoundRequest& Request, double Now) const;
+
+	// Admit a request into its category, evicting a lower scoring voice if needed.
+	bool AdmitVoice(const FSoundRequest& Request);
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CompileGameplayDataCommandlet.h"
+#include "GameplayDataTable.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UCompileGameplayDataCommandlet::UCompileGameplayDataCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UCompileGameplayDataCommandlet::Main(const FString& Params)
+{
+	const FString dataDir = FPaths::ProjectContentDir() / TEXT("Data");
+
+	FString enemiesPath = dataDir / TEXT("Enemies.csv");
+	FString weaponsPath = dataDir / TEXT("Weapons.csv");
+	FString wavesPath = dataDir / TEXT("Waves.csv");
+	FString outPath = GameplayData::GetDefaultPath();
+	FParse::Value(*Params, TEXT("Enemies="), enemiesPath);
+	FParse::Value(*Params, TEXT("Weapons="), weaponsPath);
+	FParse::Value(*Params, TEXT("Waves="), wavesPath);
+	FParse::Value(*Params, TEXT("Out="), outPath);
+
+	// A missing source is an empty table, not an error.
+	auto LoadCsv = [](const FString& Path) -> FString
+	{
+		FString text;
+		if (!FFileHelper::LoadFileToString(text, *Path))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[Gameplay Data] %s not found; table left empty"), *Path);
+		}
+		return text;
+	};
+
+	TArray<uint8> data;
+	FString errors;
+	if (!GameplayData::Compile(LoadCsv(enemiesPath), LoadCsv(weaponsPath), LoadCsv(wavesPath), data, errors))
+	{
+		TArray<FString> lines;
+		errors.ParseIntoArrayLines(lines);
+		for (const FString& line : lines)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[Gameplay Data] %s"), *line);
+		}
+		return 1;
+	}
+
+	// Read the result back through the runtime view so a bad layout never ships.
+	FGameplayDataView view;
+	if (!view.Initialize(data.GetData(), data.Num()) || !FFileHelper::SaveArrayToFile(data, *outPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Gameplay Data] Failed to validate or write %s"), *outPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[Gameplay Data] Wrote %s (%d bytes): %d enemies, %d weapons, %d waves"),
+		*outPath, data.Num(), view.GetNumRecords(GameplayData::Enemies), view.GetNumRecords(GameplayData::Weapons),
+		view.GetNumRecords(GameplayData::Waves));
+	return 0;
+}
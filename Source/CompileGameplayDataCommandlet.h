@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CompileGameplayDataCommandlet.generated.h"
+
+/**
+ * UCompileGameplayDataCommandlet:
+ * Compiles the gameplay CSV tables into the cooked file read by UGameplayDataSubsystem (format in GameplayDataTable.h).
+ *
+ * Usage:
+ *   UnrealEditor-Cmd project_goldfish.uproject -run=CompileGameplayData
+ *     [-Enemies=<csv>] [-Weapons=<csv>] [-Waves=<csv>] [-Out=<gdt>]
+ *
+ * Defaults to Content/Data/{Enemies,Weapons,Waves}.csv and Content/Data/GameplayData.gdt.
+ * A missing CSV produces an empty table. Returns non-zero (and writes nothing) if any table is malformed.
+ */
+UCLASS()
+class PROJECT_GOLDFISH_API UCompileGameplayDataCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCompileGameplayDataCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,115 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 64-bit key hash shared by the membership filters.
+ * Built on GetTypeHash (so FString keys are case-insensitive, like slot names on disk) and spread with a
+ * SplitMix64 finalizer so the low and high words can be used as independent hashes.
+ */
+namespace CustomFilterHash
+{
+    inline uint64 Mix(uint64 Value)
+    {
+        Value += 0x9E3779B97F4A7C15ull;
+        Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+        return Value ^ (Value >> 31);
+    }
+
+    template<typename KeyType>
+    uint64 Hash(const KeyType& Key)
+    {
+        return Mix(GetTypeHash(Key));
+    }
+}
+
+/**
+ * CustomBloomFilter:
+ * Probabilistic set membership in a fixed bit array. MayContain never returns a false negative;
+ * a false positive happens at roughly the rate the filter was sized for. Items cannot be removed
+ * (use CustomCuckooFilter for that).
+ * * Sizing: m = -n ln(p) / ln(2)^2 bits and k = (m / n) ln(2) hash functions for n expected items at rate p.
+ * The k bit positions come from double hashing (h1 + i * h2) of one 64-bit hash.
+ * * Time Complexity:
+ * - Add / MayContain: O(k)
+ * * Space Complexity: about 9.6 bits per item at a 1% false-positive rate, independent of key size
+ * * Use Case: Skipping expensive lookups (disk, cache, registry) for keys that are mostly absent.
+ */
+template<typename KeyType>
+class PROJECT_GOLDFISH_API CustomBloomFilter
+{
+private:
+    TArray<uint64> Bits;
+    uint32 NumBits;
+    int32 NumHashes;
+    int32 NumItems = 0;
+
+    uint32 BitIndex(uint64 Hash, int32 i) const
+    {
+        const uint32 H1 = static_cast<uint32>(Hash);
+        const uint32 H2 = static_cast<uint32>(Hash >> 32) | 1u;
+        return static_cast<uint32>((static_cast<uint64>(H1) + static_cast<uint64>(i) * H2) % NumBits);
+    }
+
+public:
+    explicit CustomBloomFilter(int32 ExpectedItems = 1024, float FalsePositiveRate = 0.01f)
+    {
+        const double Items = FMath::Max(ExpectedItems, 1);
+        const double Rate = FMath::Clamp(static_cast<double>(FalsePositiveRate), 1e-6, 0.5);
+        const double Ln2 = 0.6931471805599453;
+
+        NumBits = static_cast<uint32>(FMath::Max(64.0, FMath::CeilToDouble(-Items * FMath::Loge(Rate) / (Ln2 * Ln2))));
+        NumHashes = FMath::Clamp(FMath::RoundToInt32(NumBits / Items * Ln2), 1, 16);
+        Bits.SetNumZeroed((NumBits + 63) / 64);
+    }
+
+    void Add(const KeyType& Key)
+    {
+        const uint64 Hash = CustomFilterHash::Hash(Key);
+        for (int32 i = 0; i < NumHashes; ++i)
+        {
+            const uint32 Bit = BitIndex(Hash, i);
+            Bits[Bit >> 6] |= uint64(1) << (Bit & 63);
+        }
+        NumItems++;
+    }
+
+    // False: the key was never added. True: it probably was.
+    bool MayContain(const KeyType& Key) const
+    {
+        const uint64 Hash = CustomFilterHash::Hash(Key);
+        for (int32 i = 0; i < NumHashes; ++i)
+        {
+            const uint32 Bit = BitIndex(Hash, i);
+            if ((Bits[Bit >> 6] & (uint64(1) << (Bit & 63))) == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Clear()
+    {
+        for (uint64& Word : Bits)
+        {
+            Word = 0;
+        }
+        NumItems = 0;
+    }
+
+    // Expected false-positive rate for the items added so far: (1 - e^(-kn/m))^k.
+    float GetEstimatedFalsePositiveRate() const
+    {
+        const double FillRatio = 1.0 - FMath::Exp(-static_cast<double>(NumHashes) * NumItems / NumBits);
+        return static_cast<float>(FMath::Pow(FillRatio, static_cast<double>(NumHashes)));
+    }
+
+    int32 Num() const { return NumItems; }
+    int32 GetNumBits() const { return static_cast<int32>(NumBits); }
+    int32 GetNumHashes() const { return NumHashes; }
+    int64 GetMemoryBytes() const { return Bits.GetAllocatedSize(); }
+};
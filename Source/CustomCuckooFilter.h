@@ -0,0 +1,224 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CustomBloomFilter.h"
+
+/**
+ * CustomCuckooFilter:
+ * Probabilistic set membership that, unlike CustomBloomFilter, supports removal.
+ * Stores a 16-bit fingerprint of each key in one of two candidate buckets of 4 slots
+ * (partial-key cuckoo hashing: the alternate bucket is derived from the fingerprint alone,
+ * so entries can be relocated without the original key).
+ * * Rules: never a false negative, provided only keys that were added are removed.
+ * Adding the same key twice stores two copies; remove it as many times as it was added.
+ * * Time Complexity:
+ * - MayContain / Remove: O(1) (two buckets)
+ * - Add: O(1) amortized; up to MaxKicks relocations near capacity
+ * * Space Complexity: 16 bits per slot, about 17 bits per item at the usual 95% load
+ * * False-positive rate: about 2 * 4 * LoadFactor / 2^16 (0.012% when full)
+ * * Use Case: "Definitely not present" checks over sets that shrink as well as grow (save slots on disk).
+ */
+template<typename KeyType>
+class PROJECT_GOLDFISH_API CustomCuckooFilter
+{
+private:
+    static constexpr int32 SlotsPerBucket = 4;
+    static constexpr int32 MaxKicks = 500;
+
+    // 0 marks an empty slot; fingerprints are never 0.
+    TArray<uint16> Slots;
+    uint32 BucketMask;
+    int32 NumItems = 0;
+
+    // One fingerprint that could not be placed when the table filled up (kept so nothing is ever lost).
+    uint16 VictimFingerprint = 0;
+    uint32 VictimBucket = 0;
+
+    // Xorshift state for picking which entry to kick out.
+    uint32 KickState = 0x2545F491u;
+
+    static uint16 Fingerprint(uint64 Hash)
+    {
+        const uint16 Value = static_cast<uint16>(Hash >> 48);
+        return Value != 0 ? Value : 1;
+    }
+
+    uint32 AltBucket(uint32 Bucket, uint16 InFingerprint) const
+    {
+        return (Bucket ^ static_cast<uint32>(CustomFilterHash::Mix(InFingerprint))) & BucketMask;
+    }
+
+    bool BucketContains(uint32 Bucket, uint16 InFingerprint) const
+    {
+        const uint16* BucketSlots = &Slots[Bucket * SlotsPerBucket];
+        for (int32 i = 0; i < SlotsPerBucket; ++i)
+        {
+            if (BucketSlots[i] == InFingerprint)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool BucketInsert(uint32 Bucket, uint16 InFingerprint)
+    {
+        uint16* BucketSlots = &Slots[Bucket * SlotsPerBucket];
+        for (int32 i = 0; i < SlotsPerBucket; ++i)
+        {
+            if (BucketSlots[i] == 0)
+            {
+                BucketSlots[i] = InFingerprint;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool BucketRemove(uint32 Bucket, uint16 InFingerprint)
+    {
+        uint16* BucketSlots = &Slots[Bucket * SlotsPerBucket];
+        for (int32 i = 0; i < SlotsPerBucket; ++i)
+        {
+            if (BucketSlots[i] == InFingerprint)
+            {
+                BucketSlots[i] = 0;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32 NextRandom()
+    {
+        KickState ^= KickState << 13;
+        KickState ^= KickState >> 17;
+        KickState ^= KickState << 5;
+        return KickState;
+    }
+
+public:
+    // Capacity is the number of items expected; the table is sized so that is about 95% load at most.
+    explicit CustomCuckooFilter(int32 Capacity = 1024)
+    {
+        const uint32 MinBuckets = static_cast<uint32>(FMath::CeilToDouble(FMath::Max(Capacity, 1) / (SlotsPerBucket * 0.95)));
+        const uint32 NumBuckets = FMath::RoundUpToPowerOfTwo(FMath::Max(MinBuckets, 2u));
+        BucketMask = NumBuckets - 1;
+        Slots.SetNumZeroed(NumBuckets * SlotsPerBucket);
+    }
+
+    // Returns false (and records nothing) once the filter is full; rebuild it with more capacity.
+    bool Add(const KeyType& Key)
+    {
+        if (VictimFingerprint != 0)
+        {
+            return false;
+        }
+
+        const uint64 Hash = CustomFilterHash::Hash(Key);
+        uint16 CurrentFingerprint = Fingerprint(Hash);
+        const uint32 Bucket1 = static_cast<uint32>(Hash) & BucketMask;
+        const uint32 Bucket2 = AltBucket(Bucket1, CurrentFingerprint);
+
+        NumItems++;
+        if (BucketInsert(Bucket1, CurrentFingerprint) || BucketInsert(Bucket2, CurrentFingerprint))
+        {
+            return true;
+        }
+
+        // Both full: evict a random entry to its alternate bucket, repeatedly.
+        uint32 Bucket = (NextRandom() & 1) ? Bucket1 : Bucket2;
+        for (int32 Kick = 0; Kick < MaxKicks; ++Kick)
+        {
+            uint16& Slot = Slots[Bucket * SlotsPerBucket + (NextRandom() % SlotsPerBucket)];
+            Swap(Slot, CurrentFingerprint);
+
+            Bucket = AltBucket(Bucket, CurrentFingerprint);
+            if (BucketInsert(Bucket, CurrentFingerprint))
+            {
+                return true;
+            }
+        }
+
+        // Table is full. The last evicted fingerprint waits in the victim stash, so the key still counts as added.
+        VictimFingerprint = CurrentFingerprint;
+        VictimBucket = Bucket;
+        return true;
+    }
+
+    // False: the key is not in the filter. True: it probably is.
+    bool MayContain(const KeyType& Key) const
+    {
+        const uint64 Hash = CustomFilterHash::Hash(Key);
+        const uint16 KeyFingerprint = Fingerprint(Hash);
+        const uint32 Bucket1 = static_cast<uint32>(Hash) & BucketMask;
+        const uint32 Bucket2 = AltBucket(Bucket1, KeyFingerprint);
+
+        if (BucketContains(Bucket1, KeyFingerprint) || BucketContains(Bucket2, KeyFingerprint))
+        {
+            return true;
+        }
+        return VictimFingerprint == KeyFingerprint && (VictimBucket == Bucket1 || VictimBucket == Bucket2);
+    }
+
+    // Remove one copy of a key that was added. Returns false if no matching fingerprint was found.
+    bool Remove(const KeyType& Key)
+    {
+        const uint64 Hash = CustomFilterHash::Hash(Key);
+        const uint16 KeyFingerprint = Fingerprint(Hash);
+        const uint32 Bucket1 = static_cast<uint32>(Hash) & BucketMask;
+        const uint32 Bucket2 = AltBucket(Bucket1, KeyFingerprint);
+
+        if (VictimFingerprint == KeyFingerprint && (VictimBucket == Bucket1 || VictimBucket == Bucket2))
+        {
+            VictimFingerprint = 0;
+            NumItems--;
+            return true;
+        }
+
+        if (BucketRemove(Bucket1, KeyFingerprint) || BucketRemove(Bucket2, KeyFingerprint))
+        {
+            NumItems--;
+
+            // A slot just opened up: try to place the stashed victim again.
+            if (VictimFingerprint != 0)
+            {
+                const uint16 Pending = VictimFingerprint;
+                VictimFingerprint = 0;
+                if (!BucketInsert(VictimBucket, Pending) && !BucketInsert(AltBucket(VictimBucket, Pending), Pending))
+                {
+                    VictimFingerprint = Pending;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void Clear()
+    {
+        for (uint16& Slot : Slots)
+        {
+            Slot = 0;
+        }
+        VictimFingerprint = 0;
+        NumItems = 0;
+    }
+
+    float GetLoadFactor() const
+    {
+        return static_cast<float>(NumItems) / Slots.Num();
+    }
+
+    // Upper bound on the false-positive rate at the current load: 2 buckets * 4 slots * load / 2^16.
+    float GetEstimatedFalsePositiveRate() const
+    {
+        return static_cast<float>(2.0 * SlotsPerBucket * GetLoadFactor() / 65535.0);
+    }
+
+    int32 Num() const { return NumItems; }
+    int32 GetCapacity() const { return Slots.Num(); }
+    int64 GetMemoryBytes() const { return Slots.GetAllocatedSize(); }
+};
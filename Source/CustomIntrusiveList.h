@@ -0,0 +1,183 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * CustomIntrusiveListNode:
+ * Link embedded in an object so it can be threaded onto a CustomIntrusiveList without any allocation.
+ * An object needs one node per list it can be a member of at the same time.
+ */
+template<typename ElementType>
+struct CustomIntrusiveListNode
+{
+    ElementType* Prev = nullptr;
+    ElementType* Next = nullptr;
+
+    // The list currently holding this node (null if unlinked), so membership checks are O(1).
+    const void* Owner = nullptr;
+
+    bool IsLinked() const { return Owner != nullptr; }
+};
+
+/**
+ * CustomIntrusiveList:
+ * A doubly linked list threaded through nodes that live inside the elements themselves.
+ * The list never owns or allocates anything; it only links objects that already exist.
+ * * Time Complexity:
+ * - PushFront / PushBack / PopFront / Remove: O(1)
+ * - Contains: O(1) (via the node's owner)
+ * * Space Complexity: O(1) beyond the embedded nodes
+ * * Use Case: Object pools (free lists of pooled actors), request queues, recency lists.
+ */
+template<typename ElementType, CustomIntrusiveListNode<ElementType> ElementType::*NodeMember>
+class PROJECT_GOLDFISH_API CustomIntrusiveList
+{
+private:
+    ElementType* Head = nullptr;
+    ElementType* Tail = nullptr;
+    int32 Count = 0;
+
+    static CustomIntrusiveListNode<ElementType>& NodeOf(ElementType* Element)
+    {
+        return Element->*NodeMember;
+    }
+
+public:
+    CustomIntrusiveList() = default;
+
+    // Elements point back at the list, so it can't be copied or moved.
+    CustomIntrusiveList(const CustomIntrusiveList&) = delete;
+    CustomIntrusiveList& operator=(const CustomIntrusiveList&) = delete;
+
+    ~CustomIntrusiveList()
+    {
+        Clear();
+    }
+
+    int32 Num() const { return Count; }
+    bool IsEmpty() const { return Count == 0; }
+    ElementType* First() const { return Head; }
+    ElementType* LastElement() const { return Tail; }
+
+    bool Contains(const ElementType* Element) const
+    {
+        return Element != nullptr && (Element->*NodeMember).Owner == this;
+    }
+
+    void PushFront(ElementType* Element)
+    {
+        CustomIntrusiveListNode<ElementType>& Node = NodeOf(Element);
+        check(!Node.IsLinked());
+
+        Node.Prev = nullptr;
+        Node.Next = Head;
+        Node.Owner = this;
+        if (Head != nullptr)
+        {
+            NodeOf(Head).Prev = Element;
+        }
+        else
+        {
+            Tail = Element;
+        }
+        Head = Element;
+        Count++;
+    }
+
+    void PushBack(ElementType* Element)
+    {
+        CustomIntrusiveListNode<ElementType>& Node = NodeOf(Element);
+        check(!Node.IsLinked());
+
+        Node.Prev = Tail;
+        Node.Next = nullptr;
+        Node.Owner = this;
+        if (Tail != nullptr)
+        {
+            NodeOf(Tail).Next = Element;
+        }
+        else
+        {
+            Head = Element;
+        }
+        Tail = Element;
+        Count++;
+    }
+
+    // Unlink an element from anywhere in the list. Returns false if it isn't in this list.
+    bool Remove(ElementType* Element)
+    {
+        if (!Contains(Element))
+        {
+            return false;
+        }
+
+        CustomIntrusiveListNode<ElementType>& Node = NodeOf(Element);
+        if (Node.Prev != nullptr)
+        {
+            NodeOf(Node.Prev).Next = Node.Next;
+        }
+        else
+        {
+            Head = Node.Next;
+        }
+
+        if (Node.Next != nullptr)
+        {
+            NodeOf(Node.Next).Prev = Node.Prev;
+        }
+        else
+        {
+            Tail = Node.Prev;
+        }
+
+        Node.Prev = nullptr;
+        Node.Next = nullptr;
+        Node.Owner = nullptr;
+        Count--;
+        return true;
+    }
+
+    // Unlink and return the first element (null if empty).
+    ElementType* PopFront()
+    {
+        ElementType* Element = Head;
+        if (Element != nullptr)
+        {
+            Remove(Element);
+        }
+        return Element;
+    }
+
+    // Unlink every element.
+    void Clear()
+    {
+        while (Head != nullptr)
+        {
+            PopFront();
+        }
+    }
+
+    // Range-based for support. Don't unlink the current element while iterating.
+    class Iterator
+    {
+    public:
+        explicit Iterator(ElementType* InCurrent) : Current(InCurrent) {}
+
+        ElementType* operator*() const { return Current; }
+        Iterator& operator++()
+        {
+            Current = (Current->*NodeMember).Next;
+            return *this;
+        }
+        bool operator!=(const Iterator& Other) const { return Current != Other.Current; }
+
+    private:
+        ElementType* Current;
+    };
+
+    Iterator begin() const { return Iterator(Head); }
+    Iterator end() const { return Iterator(nullptr); }
+};
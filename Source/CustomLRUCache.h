@@ -0,0 +1,237 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CustomHashMap.h"
+
+/**
+ * CustomLRUCache:
+ * A capacity- and byte-bounded Least Recently Used cache.
+ * Built on CustomHashMap (key -> entry) plus an intrusive doubly linked recency list
+ * threaded through the entries themselves, so no extra list nodes are allocated.
+ * * Time Complexity:
+ * - Insert: O(1) average (plus O(k) for the k entries evicted)
+ * - Find: O(1) average (moves the entry to the front of the recency list)
+ * - Remove: O(1) average
+ * * Space Complexity: O(n) where n is bounded by MaxEntries and MaxBytes
+ * * Validation: every entry carries a caller-supplied Stamp (e.g. file mtime + size).
+ * A lookup with a different stamp drops the stale entry and reports a miss.
+ * * Use Case: Save slot cache in UGameStateManager.
+ */
+template<typename KeyType, typename ValueType>
+class PROJECT_GOLDFISH_API CustomLRUCache
+{
+private:
+    // Entry doubles as the recency list node (intrusive Prev/Next).
+    struct CacheEntry
+    {
+        KeyType Key;
+        ValueType Value;
+        int64 SizeBytes;
+        uint64 Stamp;
+        CacheEntry* Prev;
+        CacheEntry* Next;
+
+        CacheEntry(const KeyType& InKey, const ValueType& InValue, int64 InSizeBytes, uint64 InStamp)
+            : Key(InKey), Value(InValue), SizeBytes(InSizeBytes), Stamp(InStamp), Prev(nullptr), Next(nullptr)
+        {
+        }
+    };
+
+    CustomHashMap<KeyType, CacheEntry*> Entries;
+
+    // Head = most recently used, Tail = least recently used (next to evict).
+    CacheEntry* Head;
+    CacheEntry* Tail;
+
+    int32 NumEntries;
+    int64 TotalBytes;
+    int32 MaxEntries;
+    int64 MaxBytes;
+
+    // Statistics.
+    int32 Hits;
+    int32 Misses;
+    int32 Evictions;
+    int32 Invalidations;
+
+    void Unlink(CacheEntry* Entry)
+    {
+        if (Entry->Prev) Entry->Prev->Next = Entry->Next;
+        else Head = Entry->Next;
+
+        if (Entry->Next) Entry->Next->Prev = Entry->Prev;
+        else Tail = Entry->Prev;
+
+        Entry->Prev = Entry->Next = nullptr;
+    }
+
+    void PushFront(CacheEntry* Entry)
+    {
+        Entry->Prev = nullptr;
+        Entry->Next = Head;
+        if (Head) Head->Prev = Entry;
+        Head = Entry;
+        if (Tail == nullptr) Tail = Entry;
+    }
+
+    void DestroyEntry(CacheEntry* Entry)
+    {
+        Unlink(Entry);
+        Entries.Remove(Entry->Key);
+        TotalBytes -= Entry->SizeBytes;
+        NumEntries--;
+        delete Entry;
+    }
+
+    // Drops least recently used entries until both limits are respected.
+    void EnforceLimits()
+    {
+        while (Tail != nullptr && ((MaxEntries > 0 && NumEntries > MaxEntries) || (MaxBytes > 0 && TotalBytes > MaxBytes)))
+        {
+            DestroyEntry(Tail);
+            Evictions++;
+        }
+    }
+
+public:
+    // Constructor: MaxEntries/MaxBytes <= 0 disables that bound.
+    CustomLRUCache(int32 InMaxEntries = 16, int64 InMaxBytes = 4 * 1024 * 1024)
+        : Entries(FMath::Max(16, InMaxEntries * 2))
+        , Head(nullptr), Tail(nullptr)
+        , NumEntries(0), TotalBytes(0)
+        , MaxEntries(InMaxEntries), MaxBytes(InMaxBytes)
+        , Hits(0), Misses(0), Evictions(0), Invalidations(0)
+    {
+    }
+
+    ~CustomLRUCache()
+    {
+        Clear();
+    }
+
+    // Entries are owned through raw pointers; copying would double-free.
+    CustomLRUCache(const CustomLRUCache&) = delete;
+    CustomLRUCache& operator=(const CustomLRUCache&) = delete;
+
+    // Insert or update an entry and mark it most recently used.
+    // Values larger than the whole byte budget are not cached.
+    void Insert(const KeyType& Key, const ValueType& Value, int64 SizeBytes, uint64 Stamp = 0)
+    {
+        CacheEntry* Existing = nullptr;
+        if (Entries.Find(Key, Existing))
+        {
+            DestroyEntry(Existing);
+        }
+
+        if (MaxBytes > 0 && SizeBytes > MaxBytes)
+        {
+            return;
+        }
+
+        CacheEntry* Entry = new CacheEntry(Key, Value, SizeBytes, Stamp);
+        Entries.Insert(Key, Entry);
+        PushFront(Entry);
+        NumEntries++;
+        TotalBytes += SizeBytes;
+
+        EnforceLimits();
+    }
+
+    // Retrieve a value if present and its stamp still matches. Counts hits/misses.
+    bool Find(const KeyType& Key, uint64 CurrentStamp, ValueType& OutValue)
+    {
+        CacheEntry* Entry = nullptr;
+        if (!Entries.Find(Key, Entry))
+        {
+            Misses++;
+            return false;
+        }
+
+        if (Entry->Stamp != CurrentStamp)
+        {
+            // Backing data changed since the entry was cached.
+            DestroyEntry(Entry);
+            Invalidations++;
+            Misses++;
+            return false;
+        }
+
+        Unlink(Entry);
+        PushFront(Entry);
+        OutValue = Entry->Value;
+        Hits++;
+        return true;
+    }
+
+    // Check if a Key is cached (does not touch recency or statistics).
+    bool Contains(const KeyType& Key) const
+    {
+        return Entries.Contains(Key);
+    }
+
+    // Delete an entry.
+    bool Remove(const KeyType& Key)
+    {
+        CacheEntry* Entry = nullptr;
+        if (Entries.Find(Key, Entry))
+        {
+            DestroyEntry(Entry);
+            return true;
+        }
+        return false;
+    }
+
+    // Utility: Return all keys, most recently used first.
+    TArray<KeyType> GetKeys() const
+    {
+        TArray<KeyType> Keys;
+        Keys.Reserve(NumEntries);
+        for (CacheEntry* Entry = Head; Entry != nullptr; Entry = Entry->Next)
+        {
+            Keys.Add(Entry->Key);
+        }
+        return Keys;
+    }
+
+    // Reset the cache (statistics are kept).
+    void Clear()
+    {
+        CacheEntry* Entry = Head;
+        while (Entry != nullptr)
+        {
+            CacheEntry* Next = Entry->Next;
+            delete Entry;
+            Entry = Next;
+        }
+
+        Head = Tail = nullptr;
+        Entries.Clear();
+        NumEntries = 0;
+        TotalBytes = 0;
+    }
+
+    // Change the bounds, evicting immediately if the cache is now over budget.
+    void SetLimits(int32 InMaxEntries, int64 InMaxBytes)
+    {
+        MaxEntries = InMaxEntries;
+        MaxBytes = InMaxBytes;
+        EnforceLimits();
+    }
+
+    void ResetStats()
+    {
+        Hits = Misses = Evictions = Invalidations = 0;
+    }
+
+    // Getters for cache state.
+    int32 GetSize() const { return NumEntries; }
+    int64 GetBytes() const { return TotalBytes; }
+    bool IsEmpty() const { return NumEntries == 0; }
+    float GetLoadFactor() const { return Entries.GetLoadFactor(); }
+    int32 GetHits() const { return Hits; }
+    int32 GetMisses() const { return Misses; }
+    int32 GetEvictions() const { return Evictions; }
+    int32 GetInvalidations() const { return Invalidations; }
+};
\ No newline at end of file
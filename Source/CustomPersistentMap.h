@@ -0,0 +1,376 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * CustomPersistentMap:
+ * An immutable hash map implemented as a Hash Array Mapped Trie (HAMT, CHAMP layout).
+ * Each node consumes 5 bits of the key hash and keeps two 32-bit bitmaps: one for entries stored inline and
+ * one for child nodes, so a node only allocates the slots it uses. Set and Remove return a new version that
+ * copies the nodes on one root-to-leaf path and shares the rest with the original.
+ * * Time Complexity:
+ * - Find / Contains: O(log32 n) (at most 7 levels, then a linear scan of full-hash collisions)
+ * - Set / Remove: O(log32 n), allocating one node per level
+ * - Copying a version (snapshot): O(1)
+ * * Space Complexity: O(n) for the first version, O(log32 n) per change for each derived version
+ * * Use Case: Versioned key/value state (history, keyframes) where each version differs from the last by a few keys.
+ */
+template<typename KeyType, typename ValueType>
+class PROJECT_GOLDFISH_API CustomPersistentMap
+{
+private:
+    static constexpr int32 Bits = 5;
+    static constexpr uint32 Mask = (1u << Bits) - 1;
+
+    // Below this depth every hash bit is used up; colliding keys share one node and are scanned linearly.
+    static constexpr int32 MaxShift = 32;
+
+    struct FEntry
+    {
+        KeyType Key;
+        ValueType Value;
+        uint32 Hash;
+    };
+
+    struct FNode
+    {
+        uint32 DataMap = 0;
+        uint32 NodeMap = 0;
+        TArray<FEntry> Entries;
+        TArray<TSharedPtr<const FNode>> Children;
+    };
+    using FNodeRef = TSharedPtr<const FNode>;
+
+    FNodeRef Root;
+    int32 Count = 0;
+
+    static uint32 HashKey(const KeyType& Key)
+    {
+        // Spread the low bits: the top levels of the trie only look at the first few.
+        uint32 Hash = GetTypeHash(Key);
+        Hash ^= Hash >> 16;
+        Hash *= 0x7FEB352Du;
+        Hash ^= Hash >> 15;
+        Hash *= 0x846CA68Bu;
+        return Hash ^ (Hash >> 16);
+    }
+
+    static uint32 BitFor(uint32 Hash, int32 Shift)
+    {
+        return 1u << ((Hash >> Shift) & Mask);
+    }
+
+    static int32 SlotFor(uint32 Map, uint32 Bit)
+    {
+        return FMath::CountBits(Map & (Bit - 1));
+    }
+
+    // A subtree holding two entries whose hashes agree below Shift.
+    static FNodeRef MergeEntries(int32 Shift, const FEntry& A, const FEntry& B)
+    {
+        TSharedRef<FNode> Node = MakeShared<FNode>();
+        if (Shift >= MaxShift)
+        {
+            Node->Entries.Add(A);
+            Node->Entries.Add(B);
+            return Node;
+        }
+
+        const uint32 BitA = BitFor(A.Hash, Shift);
+        const uint32 BitB = BitFor(B.Hash, Shift);
+        if (BitA == BitB)
+        {
+            Node->NodeMap = BitA;
+            Node->Children.Add(MergeEntries(Shift + Bits, A, B));
+        }
+        else
+        {
+            Node->DataMap = BitA | BitB;
+            Node->Entries.Add(BitA < BitB ? A : B);
+            Node->Entries.Add(BitA < BitB ? B : A);
+        }
+        return Node;
+    }
+
+    static FNodeRef SetIn(const FNode& Node, int32 Shift, const FEntry& NewEntry, bool& bOutAdded)
+    {
+        TSharedRef<FNode> Copy = MakeShared<FNode>(Node);
+
+        if (Shift >= MaxShift)
+        {
+            for (FEntry& Entry : Copy->Entries)
+            {
+                if (Entry.Key == NewEntry.Key)
+                {
+                    Entry.Value = NewEntry.Value;
+                    return Copy;
+                }
+            }
+            Copy->Entries.Add(NewEntry);
+            bOutAdded = true;
+            return Copy;
+        }
+
+        const uint32 Bit = BitFor(NewEntry.Hash, Shift);
+        if (Node.DataMap & Bit)
+        {
+            const int32 Slot = SlotFor(Node.DataMap, Bit);
+            const FEntry& Existing = Node.Entries[Slot];
+            if (Existing.Hash == NewEntry.Hash && Existing.Key == NewEntry.Key)
+            {
+                Copy->Entries[Slot].Value = NewEntry.Value;
+                return Copy;
+            }
+
+            // Two keys in one slot: push both down into a new child.
+            FNodeRef Child = MergeEntries(Shift + Bits, Existing, NewEntry);
+            Copy->Entries.RemoveAt(Slot);
+            Copy->DataMap &= ~Bit;
+            Copy->NodeMap |= Bit;
+            Copy->Children.Insert(MoveTemp(Child), SlotFor(Copy->NodeMap, Bit));
+            bOutAdded = true;
+        }
+        else if (Node.NodeMap & Bit)
+        {
+            const int32 Slot = SlotFor(Node.NodeMap, Bit);
+            Copy->Children[Slot] = SetIn(*Node.Children[Slot], Shift + Bits, NewEntry, bOutAdded);
+        }
+        else
+        {
+            Copy->DataMap |= Bit;
+            Copy->Entries.Insert(NewEntry, SlotFor(Copy->DataMap, Bit));
+            bOutAdded = true;
+        }
+        return Copy;
+    }
+
+    // Returns Node itself when Key is absent, and null when the node ends up empty.
+    static FNodeRef RemoveIn(const FNodeRef& Node, int32 Shift, uint32 Hash, const KeyType& Key)
+    {
+        if (Shift >= MaxShift)
+        {
+            for (int32 i = 0; i < Node->Entries.Num(); ++i)
+            {
+                if (Node->Entries[i].Key == Key)
+                {
+                    if (Node->Entries.Num() == 1)
+                    {
+                        return nullptr;
+                    }
+                    TSharedRef<FNode> Copy = MakeShared<FNode>(*Node);
+                    Copy->Entries.RemoveAt(i);
+                    return Copy;
+                }
+            }
+            return Node;
+        }
+
+        const uint32 Bit = BitFor(Hash, Shift);
+        if (Node->DataMap & Bit)
+        {
+            const int32 Slot = SlotFor(Node->DataMap, Bit);
+            const FEntry& Existing = Node->Entries[Slot];
+            if (Existing.Hash != Hash || !(Existing.Key == Key))
+            {
+                return Node;
+            }
+            if (Node->Entries.Num() == 1 && Node->Children.Num() == 0)
+            {
+                return nullptr;
+            }
+
+            TSharedRef<FNode> Copy = MakeShared<FNode>(*Node);
+            Copy->Entries.RemoveAt(Slot);
+            Copy->DataMap &= ~Bit;
+            return Copy;
+        }
+
+        if (Node->NodeMap & Bit)
+        {
+            const int32 Slot = SlotFor(Node->NodeMap, Bit);
+            const FNodeRef& Child = Node->Children[Slot];
+            FNodeRef NewChild = RemoveIn(Child, Shift + Bits, Hash, Key);
+            if (NewChild == Child)
+            {
+                return Node;
+            }
+
+            TSharedRef<FNode> Copy = MakeShared<FNode>(*Node);
+            if (NewChild.IsValid() && !(NewChild->Children.Num() == 0 && NewChild->Entries.Num() == 1))
+            {
+                Copy->Children[Slot] = MoveTemp(NewChild);
+                return Copy;
+            }
+
+            // The child is gone or down to one entry: drop it and pull that entry up into this node.
+            Copy->Children.RemoveAt(Slot);
+            Copy->NodeMap &= ~Bit;
+            if (NewChild.IsValid())
+            {
+                Copy->DataMap |= Bit;
+                Copy->Entries.Insert(NewChild->Entries[0], SlotFor(Copy->DataMap, Bit));
+            }
+            if (Copy->Entries.Num() == 0 && Copy->Children.Num() == 0)
+            {
+                return nullptr;
+            }
+            return Copy;
+        }
+
+        return Node;
+    }
+
+    template<typename FunctionType>
+    static void ForEachIn(const FNode& Node, FunctionType& Function)
+    {
+        for (const FEntry& Entry : Node.Entries)
+        {
+            Function(Entry.Key, Entry.Value);
+        }
+        for (const FNodeRef& Child : Node.Children)
+        {
+            ForEachIn(*Child, Function);
+        }
+    }
+
+    static void CountNodeBytes(const FNodeRef& Node, TSet<const void*>& Visited, int64& InOutBytes)
+    {
+        bool bAlreadyCounted = false;
+        Visited.Add(Node.Get(), &bAlreadyCounted);
+        if (bAlreadyCounted)
+        {
+            return;
+        }
+
+        InOutBytes += sizeof(FNode) + Node->Entries.GetAllocatedSize() + Node->Children.GetAllocatedSize();
+        for (const FNodeRef& Child : Node->Children)
+        {
+            CountNodeBytes(Child, Visited, InOutBytes);
+        }
+    }
+
+public:
+    int32 Num() const
+    {
+        return Count;
+    }
+
+    bool IsEmpty() const
+    {
+        return Count == 0;
+    }
+
+    // Pointer to the value for Key, or nullptr. Valid as long as this version (or one sharing the node) lives.
+    const ValueType* Find(const KeyType& Key) const
+    {
+        if (!Root.IsValid())
+        {
+            return nullptr;
+        }
+
+        const uint32 Hash = HashKey(Key);
+        const FNode* Node = Root.Get();
+        for (int32 Shift = 0; Shift < MaxShift; Shift += Bits)
+        {
+            const uint32 Bit = BitFor(Hash, Shift);
+            if (Node->DataMap & Bit)
+            {
+                const FEntry& Entry = Node->Entries[SlotFor(Node->DataMap, Bit)];
+                return Entry.Hash == Hash && Entry.Key == Key ? &Entry.Value : nullptr;
+            }
+            if (!(Node->NodeMap & Bit))
+            {
+                return nullptr;
+            }
+            Node = Node->Children[SlotFor(Node->NodeMap, Bit)].Get();
+        }
+
+        // Collision node.
+        for (const FEntry& Entry : Node->Entries)
+        {
+            if (Entry.Key == Key)
+            {
+                return &Entry.Value;
+            }
+        }
+        return nullptr;
+    }
+
+    bool Contains(const KeyType& Key) const
+    {
+        return Find(Key) != nullptr;
+    }
+
+    // New version with Key mapped to Value (inserted or replaced).
+    CustomPersistentMap Set(const KeyType& Key, const ValueType& Value) const
+    {
+        const FEntry NewEntry{ Key, Value, HashKey(Key) };
+
+        CustomPersistentMap Result(*this);
+        bool bAdded = false;
+        if (Root.IsValid())
+        {
+            Result.Root = SetIn(*Root, 0, NewEntry, bAdded);
+        }
+        else
+        {
+            TSharedRef<FNode> Node = MakeShared<FNode>();
+            Node->DataMap = BitFor(NewEntry.Hash, 0);
+            Node->Entries.Add(NewEntry);
+            Result.Root = Node;
+            bAdded = true;
+        }
+        Result.Count += bAdded ? 1 : 0;
+        return Result;
+    }
+
+    // New version without Key (shares everything with this one if Key is absent).
+    CustomPersistentMap Remove(const KeyType& Key) const
+    {
+        if (!Root.IsValid())
+        {
+            return *this;
+        }
+
+        FNodeRef NewRoot = RemoveIn(Root, 0, HashKey(Key), Key);
+        if (NewRoot == Root)
+        {
+            return *this;
+        }
+
+        CustomPersistentMap Result;
+        Result.Root = MoveTemp(NewRoot);
+        Result.Count = Count - 1;
+        return Result;
+    }
+
+    // Visit every key/value pair (in hash order).
+    template<typename FunctionType>
+    void ForEach(FunctionType Function) const
+    {
+        if (Root.IsValid())
+        {
+            ForEachIn(*Root, Function);
+        }
+    }
+
+    // True if both versions share the same root (identical contents without comparing entries).
+    bool IsSameVersion(const CustomPersistentMap& Other) const
+    {
+        return Root == Other.Root;
+    }
+
+    /**
+     * Adds the bytes of every node not already in Visited, so the combined footprint of many versions
+     * counts shared nodes once.
+     */
+    void CountUniqueBytes(TSet<const void*>& Visited, int64& InOutBytes) const
+    {
+        if (Root.IsValid())
+        {
+            CountNodeBytes(Root, Visited, InOutBytes);
+        }
+    }
+};
@@ -0,0 +1,348 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * CustomPersistentVector:
+ * An immutable vector stored as a 32-way trie of reference-counted nodes (leaves hold up to 32 elements).
+ * Every "modifying" call returns a new version and leaves the original untouched; the new version copies
+ * only the nodes on the path to the change and shares everything else, so old versions stay valid and cheap.
+ * * Time Complexity:
+ * - Get: O(log32 n) (at most 7 levels for int32 indices)
+ * - Set / Add / RemoveLast: O(log32 n), allocating one node per level
+ * - WithValues: O(n) compare, allocating only the chunks that differ from this version
+ * - Copying a version (snapshot): O(1)
+ * * Space Complexity: O(n) for the first version, O(changes * log32 n) for each version derived from it
+ * * Use Case: Undo/redo history and keyframes, where many versions of a large array differ in a few elements.
+ */
+template<typename ElementType>
+class PROJECT_GOLDFISH_API CustomPersistentVector
+{
+private:
+    static constexpr int32 Bits = 5;
+    static constexpr int32 Width = 1 << Bits;
+    static constexpr int32 Mask = Width - 1;
+
+    // Leaves (level 0) use Values, inner nodes use Children. Nodes are never modified once shared.
+    struct FNode
+    {
+        TArray<TSharedPtr<const FNode>> Children;
+        TArray<ElementType> Values;
+    };
+    using FNodeRef = TSharedPtr<const FNode>;
+
+    FNodeRef Root;
+    int32 Count = 0;
+
+    // Level of the root (0 = the root is a leaf), in bits.
+    int32 Shift = 0;
+
+    static FNodeRef MakeLeaf(const ElementType* Values, int32 Num)
+    {
+        TSharedRef<FNode> Leaf = MakeShared<FNode>();
+        Leaf->Values.Append(Values, Num);
+        return Leaf;
+    }
+
+    // A chain of single-child nodes from Level down to a leaf holding Value.
+    static FNodeRef MakePath(int32 Level, const ElementType& Value)
+    {
+        if (Level == 0)
+        {
+            return MakeLeaf(&Value, 1);
+        }
+        TSharedRef<FNode> Node = MakeShared<FNode>();
+        Node->Children.Add(MakePath(Level - Bits, Value));
+        return Node;
+    }
+
+    static FNodeRef SetIn(const FNode& Node, int32 Level, int32 Index, const ElementType& Value)
+    {
+        TSharedRef<FNode> Copy = MakeShared<FNode>(Node);
+        if (Level == 0)
+        {
+            Copy->Values[Index & Mask] = Value;
+        }
+        else
+        {
+            const int32 Slot = (Index >> Level) & Mask;
+            Copy->Children[Slot] = SetIn(*Node.Children[Slot], Level - Bits, Index, Value);
+        }
+        return Copy;
+    }
+
+    static FNodeRef PushIn(const FNode& Node, int32 Level, int32 Index, const ElementType& Value)
+    {
+        TSharedRef<FNode> Copy = MakeShared<FNode>(Node);
+        if (Level == 0)
+        {
+            Copy->Values.Add(Value);
+            return Copy;
+        }
+
+        const int32 Slot = (Index >> Level) & Mask;
+        if (Slot < Node.Children.Num())
+        {
+            Copy->Children[Slot] = PushIn(*Node.Children[Slot], Level - Bits, Index, Value);
+        }
+        else
+        {
+            Copy->Children.Add(MakePath(Level - Bits, Value));
+        }
+        return Copy;
+    }
+
+    // Drops element Index (the last one); returns null when the node ends up empty.
+    static FNodeRef PopIn(const FNode& Node, int32 Level, int32 Index)
+    {
+        if (Level == 0)
+        {
+            if (Node.Values.Num() == 1)
+            {
+                return nullptr;
+            }
+            TSharedRef<FNode> Copy = MakeShared<FNode>(Node);
+            Copy->Values.Pop();
+            return Copy;
+        }
+
+        const int32 Slot = (Index >> Level) & Mask;
+        FNodeRef NewChild = PopIn(*Node.Children[Slot], Level - Bits, Index);
+        if (!NewChild.IsValid() && Slot == 0)
+        {
+            return nullptr;
+        }
+
+        TSharedRef<FNode> Copy = MakeShared<FNode>(Node);
+        if (NewChild.IsValid())
+        {
+            Copy->Children[Slot] = MoveTemp(NewChild);
+        }
+        else
+        {
+            Copy->Children.Pop();
+        }
+        return Copy;
+    }
+
+    // The node at Level whose subtree holds Index, or null if this version has no such node.
+    const FNodeRef* FindNodeRef(int32 Index, int32 Level) const
+    {
+        if (Index >= Count || Level > Shift)
+        {
+            return nullptr;
+        }
+        const FNodeRef* Ref = &Root;
+        for (int32 L = Shift; L > Level; L -= Bits)
+        {
+            Ref = &(*Ref)->Children[(Index >> L) & Mask];
+        }
+        return Ref;
+    }
+
+    static void CountNodeBytes(const FNodeRef& Node, TSet<const void*>& Visited, int64& InOutBytes)
+    {
+        bool bAlreadyCounted = false;
+        Visited.Add(Node.Get(), &bAlreadyCounted);
+        if (bAlreadyCounted)
+        {
+            return;
+        }
+
+        InOutBytes += sizeof(FNode) + Node->Children.GetAllocatedSize() + Node->Values.GetAllocatedSize();
+        for (const FNodeRef& Child : Node->Children)
+        {
+            CountNodeBytes(Child, Visited, InOutBytes);
+        }
+    }
+
+public:
+    CustomPersistentVector() = default;
+
+    // Build a version holding a copy of Values. O(n).
+    explicit CustomPersistentVector(const TArray<ElementType>& Values)
+    {
+        *this = CustomPersistentVector().WithValues(Values);
+    }
+
+    int32 Num() const
+    {
+        return Count;
+    }
+
+    bool IsEmpty() const
+    {
+        return Count == 0;
+    }
+
+    const ElementType& Get(int32 Index) const
+    {
+        check(Index >= 0 && Index < Count);
+        const FNode* Node = Root.Get();
+        for (int32 Level = Shift; Level > 0; Level -= Bits)
+        {
+            Node = Node->Children[(Index >> Level) & Mask].Get();
+        }
+        return Node->Values[Index & Mask];
+    }
+
+    const ElementType& operator[](int32 Index) const
+    {
+        return Get(Index);
+    }
+
+    // New version with element Index replaced.
+    CustomPersistentVector Set(int32 Index, const ElementType& Value) const
+    {
+        check(Index >= 0 && Index < Count);
+        CustomPersistentVector Result(*this);
+        Result.Root = SetIn(*Root, Shift, Index, Value);
+        return Result;
+    }
+
+    // New version with Value appended.
+    CustomPersistentVector Add(const ElementType& Value) const
+    {
+        CustomPersistentVector Result(*this);
+        if (Count == 0)
+        {
+            Result.Root = MakeLeaf(&Value, 1);
+            Result.Shift = 0;
+        }
+        else if (Count == (1 << (Shift + Bits)))
+        {
+            // Root is full: grow the tree by one level.
+            TSharedRef<FNode> NewRoot = MakeShared<FNode>();
+            NewRoot->Children.Add(Root);
+            NewRoot->Children.Add(MakePath(Shift, Value));
+            Result.Root = NewRoot;
+            Result.Shift = Shift + Bits;
+        }
+        else
+        {
+            Result.Root = PushIn(*Root, Shift, Count, Value);
+        }
+        Result.Count = Count + 1;
+        return Result;
+    }
+
+    // New version without the last element.
+    CustomPersistentVector RemoveLast() const
+    {
+        check(Count > 0);
+        if (Count == 1)
+        {
+            return CustomPersistentVector();
+        }
+
+        CustomPersistentVector Result(*this);
+        Result.Root = PopIn(*Root, Shift, Count - 1);
+        Result.Count = Count - 1;
+
+        // Collapse a root left with a single child.
+        while (Result.Shift > 0 && Result.Root->Children.Num() == 1)
+        {
+            Result.Root = Result.Root->Children[0];
+            Result.Shift -= Bits;
+        }
+        return Result;
+    }
+
+    /**
+     * New version holding Values. Every 32-element chunk (and every subtree of chunks) that matches this
+     * version is shared instead of copied, so diffing a slightly changed array allocates only what changed.
+     */
+    CustomPersistentVector WithValues(const TArray<ElementType>& Values) const
+    {
+        CustomPersistentVector Result;
+        const int32 NewCount = Values.Num();
+        if (NewCount == 0)
+        {
+            return Result;
+        }
+
+        // Leaves.
+        TArray<FNodeRef> Level;
+        Level.Reserve(FMath::DivideAndRoundUp(NewCount, Width));
+        for (int32 Begin = 0; Begin < NewCount; Begin += Width)
+        {
+            const int32 Size = FMath::Min(Width, NewCount - Begin);
+            const FNodeRef* Old = FindNodeRef(Begin, 0);
+
+            bool bSame = Old != nullptr && (*Old)->Values.Num() == Size;
+            for (int32 i = 0; bSame && i < Size; ++i)
+            {
+                bSame = (*Old)->Values[i] == Values[Begin + i];
+            }
+            Level.Add(bSame ? *Old : MakeLeaf(Values.GetData() + Begin, Size));
+        }
+
+        // Inner levels, bottom-up, until one root is left.
+        int32 LevelShift = 0;
+        while (Level.Num() > 1)
+        {
+            LevelShift += Bits;
+            TArray<FNodeRef> Parents;
+            Parents.Reserve(FMath::DivideAndRoundUp(Level.Num(), Width));
+            for (int32 First = 0; First < Level.Num(); First += Width)
+            {
+                const int32 Size = FMath::Min(Width, Level.Num() - First);
+                const FNodeRef* Old = FindNodeRef(First << LevelShift, LevelShift);
+
+                bool bSame = Old != nullptr && (*Old)->Children.Num() == Size;
+                for (int32 i = 0; bSame && i < Size; ++i)
+                {
+                    bSame = (*Old)->Children[i] == Level[First + i];
+                }
+
+                if (bSame)
+                {
+                    Parents.Add(*Old);
+                }
+                else
+                {
+                    TSharedRef<FNode> Node = MakeShared<FNode>();
+                    Node->Children.Append(Level.GetData() + First, Size);
+                    Parents.Add(Node);
+                }
+            }
+            Level = MoveTemp(Parents);
+        }
+
+        Result.Root = Level[0];
+        Result.Count = NewCount;
+        Result.Shift = LevelShift;
+        return Result;
+    }
+
+    // Copy every element out, in order. O(n).
+    void ToArray(TArray<ElementType>& OutValues) const
+    {
+        OutValues.Reset(Count);
+        for (int32 Begin = 0; Begin < Count; Begin += Width)
+        {
+            const FNodeRef* Leaf = FindNodeRef(Begin, 0);
+            OutValues.Append((*Leaf)->Values);
+        }
+    }
+
+    // True if both versions share the same root (identical contents without comparing elements).
+    bool IsSameVersion(const CustomPersistentVector& Other) const
+    {
+        return Root == Other.Root && Count == Other.Count;
+    }
+
+    /**
+     * Adds the bytes of every node not already in Visited. Calling this for a set of versions with one
+     * Visited set gives their real combined footprint, counting shared nodes once.
+     */
+    void CountUniqueBytes(TSet<const void*>& Visited, int64& InOutBytes) const
+    {
+        if (Root.IsValid())
+        {
+            CountNodeBytes(Root, Visited, InOutBytes);
+        }
+    }
+};
@@ -150,9 +150,10 @@ public:
         return Heap.Num();
     }
 
+    // Keeps the heap storage, so a queue rebuilt every frame stops allocating once it has grown.
     void Clear()
     {
-        Heap.Empty();
+        Heap.Reset();
     }
 
     // Change the priority of an existing element and rebalance.
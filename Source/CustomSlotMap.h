@@ -0,0 +1,188 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FSlotMapHandle:
+ * Stable reference into a CustomSlotMap: slot index plus the generation the slot had when the handle was issued.
+ * A handle goes stale as soon as its slot is removed or renewed, even if the slot is later reused.
+ */
+struct FSlotMapHandle
+{
+    int32 Index = INDEX_NONE;
+    uint32 Generation = 0;
+
+    FSlotMapHandle() = default;
+    FSlotMapHandle(int32 InIndex, uint32 InGeneration)
+        : Index(InIndex)
+        , Generation(InGeneration)
+    {
+    }
+
+    // Packed 64-bit form (generation in the high word) for Blueprint IDs and serialization. -1 if unset.
+    int64 ToID() const
+    {
+        return Index < 0 ? -1 : (static_cast<int64>(Generation) << 32) | static_cast<uint32>(Index);
+    }
+
+    static FSlotMapHandle FromID(int64 ID)
+    {
+        return ID < 0 ? FSlotMapHandle() : FSlotMapHandle(static_cast<int32>(ID & 0x7FFFFFFF), static_cast<uint32>(ID >> 32));
+    }
+
+    bool operator==(const FSlotMapHandle& Other) const
+    {
+        return Index == Other.Index && Generation == Other.Generation;
+    }
+
+    bool operator!=(const FSlotMapHandle& Other) const
+    {
+        return !(*this == Other);
+    }
+};
+
+/**
+ * CustomSlotMap:
+ * Generational slot map: values live in a dense slot array and are referenced by FSlotMapHandle.
+ * Every slot carries a generation counter that is bumped whenever its value is removed or renewed,
+ * so a stale handle is detected with one comparison instead of returning whatever reuses the slot.
+ * * Time Complexity:
+ * - Insert / Remove / Renew / Find: O(1)
+ * * Space Complexity: O(capacity) (freed slots are kept on a free list and reused)
+ * * Use Case: Stable IDs for pooled objects (enemies), request tickets, anything referenced across frames.
+ */
+template<typename ValueType>
+class PROJECT_GOLDFISH_API CustomSlotMap
+{
+private:
+    struct FSlot
+    {
+        ValueType Value;
+        uint32 Generation = 1;
+        int32 NextFree = INDEX_NONE;
+        bool bOccupied = false;
+    };
+
+    TArray<FSlot> Slots;
+    int32 FreeHead = INDEX_NONE;
+    int32 Size = 0;
+
+    // Generation 0 is never issued, so a zeroed handle is always stale.
+    static uint32 NextGeneration(uint32 Generation)
+    {
+        return Generation == MAX_uint32 ? 1 : Generation + 1;
+    }
+
+    const FSlot* FindSlot(FSlotMapHandle Handle) const
+    {
+        if (!Slots.IsValidIndex(Handle.Index))
+        {
+            return nullptr;
+        }
+
+        const FSlot& Slot = Slots[Handle.Index];
+        return Slot.bOccupied && Slot.Generation == Handle.Generation ? &Slot : nullptr;
+    }
+
+public:
+    // Store a value and return its handle. Reuses the lowest-numbered free slot first after a Clear.
+    FSlotMapHandle Insert(const ValueType& Value)
+    {
+        int32 Index;
+        if (FreeHead != INDEX_NONE)
+        {
+            Index = FreeHead;
+            FreeHead = Slots[Index].NextFree;
+        }
+        else
+        {
+            Index = Slots.AddDefaulted();
+        }
+
+        FSlot& Slot = Slots[Index];
+        Slot.Value = Value;
+        Slot.NextFree = INDEX_NONE;
+        Slot.bOccupied = true;
+        Size++;
+
+        return FSlotMapHandle(Index, Slot.Generation);
+    }
+
+    // Remove the value. Every copy of Handle becomes stale. Returns false if Handle was already stale.
+    bool Remove(FSlotMapHandle Handle)
+    {
+        if (FindSlot(Handle) == nullptr)
+        {
+            return false;
+        }
+
+        FSlot& Slot = Slots[Handle.Index];
+        Slot.Value = ValueType();
+        Slot.Generation = NextGeneration(Slot.Generation);
+        Slot.bOccupied = false;
+        Slot.NextFree = FreeHead;
+        FreeHead = Handle.Index;
+        Size--;
+        return true;
+    }
+
+    // Keep the value in its slot but invalidate every outstanding handle to it (e.g. a pooled object starts a new life).
+    // Returns the new handle, or an unset handle if Handle was already stale.
+    FSlotMapHandle Renew(FSlotMapHandle Handle)
+    {
+        if (FindSlot(Handle) == nullptr)
+        {
+            return FSlotMapHandle();
+        }
+
+        FSlot& Slot = Slots[Handle.Index];
+        Slot.Generation = NextGeneration(Slot.Generation);
+        return FSlotMapHandle(Handle.Index, Slot.Generation);
+    }
+
+    ValueType* Find(FSlotMapHandle Handle)
+    {
+        return const_cast<ValueType*>(const_cast<const CustomSlotMap*>(this)->Find(Handle));
+    }
+
+    const ValueType* Find(FSlotMapHandle Handle) const
+    {
+        const FSlot* Slot = FindSlot(Handle);
+        return Slot != nullptr ? &Slot->Value : nullptr;
+    }
+
+    bool Contains(FSlotMapHandle Handle) const
+    {
+        return FindSlot(Handle) != nullptr;
+    }
+
+    // Current handle of an occupied slot (unset if the slot is free or out of range).
+    FSlotMapHandle GetHandleAt(int32 Index) const
+    {
+        return Slots.IsValidIndex(Index) && Slots[Index].bOccupied ? FSlotMapHandle(Index, Slots[Index].Generation) : FSlotMapHandle();
+    }
+
+    // Remove everything. Generations are kept and bumped, so handles issued before the Clear stay stale.
+    void Clear()
+    {
+        FreeHead = INDEX_NONE;
+        for (int32 i = Slots.Num() - 1; i >= 0; --i)
+        {
+            FSlot& Slot = Slots[i];
+            if (Slot.bOccupied)
+            {
+                Slot.Value = ValueType();
+                Slot.Generation = NextGeneration(Slot.Generation);
+                Slot.bOccupied = false;
+            }
+            Slot.NextFree = FreeHead;
+            FreeHead = i;
+        }
+        Size = 0;
+    }
+
+    int32 GetSize() const { return Size; }
+    int32 GetCapacity() const { return Slots.Num(); }
+};
@@ -0,0 +1,264 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * CustomSmallVector:
+ * A dynamic array with small-buffer optimization. The first InlineCapacity elements live inside the
+ * object itself (on the stack, or inside the owning node); only a larger vector spills to the heap.
+ * * Time Complexity:
+ * - Add: O(1) amortized (spilling relocates the elements once)
+ * - Access / Pop / RemoveAtSwap: O(1)
+ * - Contains: O(n)
+ * * Space Complexity: O(InlineCapacity) inline + O(n) on the heap after spilling
+ * * Use Case: Tiny hot collections such as quadtree leaves, neighbor lists and short query results,
+ *   which are almost always below a known bound and would otherwise cost a heap allocation each.
+ */
+template<typename ElementType, int32 InlineCapacity>
+class PROJECT_GOLDFISH_API CustomSmallVector
+{
+    static_assert(InlineCapacity > 0, "CustomSmallVector needs at least one inline element");
+
+private:
+    // Inline storage used until the vector outgrows it.
+    alignas(ElementType) uint8 InlineStorage[InlineCapacity * sizeof(ElementType)];
+
+    // Points at InlineStorage or at the heap block.
+    ElementType* Data;
+    int32 Count;
+    int32 Capacity;
+
+    ElementType* GetInlineData()
+    {
+        return reinterpret_cast<ElementType*>(InlineStorage);
+    }
+
+    // Move the elements to a heap block of at least MinCapacity (doubling growth).
+    void Grow(int32 MinCapacity)
+    {
+        const int32 NewCapacity = FMath::Max(MinCapacity, Capacity * 2);
+        ElementType* NewData = static_cast<ElementType*>(FMemory::Malloc(NewCapacity * sizeof(ElementType), alignof(ElementType)));
+        RelocateConstructItems<ElementType>(NewData, Data, Count);
+
+        if (!IsInline())
+        {
+            FMemory::Free(Data);
+        }
+        Data = NewData;
+        Capacity = NewCapacity;
+    }
+
+    // Release the heap block (elements must already be destroyed or relocated).
+    void ReleaseHeap()
+    {
+        if (!IsInline())
+        {
+            FMemory::Free(Data);
+        }
+        Data = GetInlineData();
+        Capacity = InlineCapacity;
+    }
+
+    // Take Other's elements, leaving it empty and inline.
+    void MoveFrom(CustomSmallVector& Other)
+    {
+        if (Other.IsInline())
+        {
+            Reserve(Other.Count);
+            RelocateConstructItems<ElementType>(Data, Other.Data, Other.Count);
+        }
+        else
+        {
+            // Steal the heap block.
+            ReleaseHeap();
+            Data = Other.Data;
+            Capacity = Other.Capacity;
+            Other.Data = Other.GetInlineData();
+            Other.Capacity = InlineCapacity;
+        }
+        Count = Other.Count;
+        Other.Count = 0;
+    }
+
+public:
+    CustomSmallVector()
+        : Data(GetInlineData())
+        , Count(0)
+        , Capacity(InlineCapacity)
+    {
+    }
+
+    CustomSmallVector(std::initializer_list<ElementType> InitList)
+        : CustomSmallVector()
+    {
+        Reserve(static_cast<int32>(InitList.size()));
+        for (const ElementType& Element : InitList)
+        {
+            Add(Element);
+        }
+    }
+
+    CustomSmallVector(const CustomSmallVector& Other)
+        : CustomSmallVector()
+    {
+        Reserve(Other.Count);
+        CopyConstructItems(Data, Other.Data, Other.Count);
+        Count = Other.Count;
+    }
+
+    CustomSmallVector(CustomSmallVector&& Other)
+        : CustomSmallVector()
+    {
+        MoveFrom(Other);
+    }
+
+    ~CustomSmallVector()
+    {
+        DestructItems(Data, Count);
+        ReleaseHeap();
+    }
+
+    CustomSmallVector& operator=(const CustomSmallVector& Other)
+    {
+        if (this != &Other)
+        {
+            Reset();
+            Reserve(Other.Count);
+            CopyConstructItems(Data, Other.Data, Other.Count);
+            Count = Other.Count;
+        }
+        return *this;
+    }
+
+    CustomSmallVector& operator=(CustomSmallVector&& Other)
+    {
+        if (this != &Other)
+        {
+            Reset();
+            MoveFrom(Other);
+        }
+        return *this;
+    }
+
+    // True while the elements still live in the inline buffer.
+    bool IsInline() const
+    {
+        return Data == reinterpret_cast<const ElementType*>(InlineStorage);
+    }
+
+    int32 Num() const { return Count; }
+    int32 Max() const { return Capacity; }
+    bool IsEmpty() const { return Count == 0; }
+
+    ElementType* GetData() { return Data; }
+    const ElementType* GetData() const { return Data; }
+
+    ElementType& operator[](int32 Index)
+    {
+        check(Index >= 0 && Index < Count);
+        return Data[Index];
+    }
+
+    const ElementType& operator[](int32 Index) const
+    {
+        check(Index >= 0 && Index < Count);
+        return Data[Index];
+    }
+
+    ElementType& Last()
+    {
+        check(Count > 0);
+        return Data[Count - 1];
+    }
+
+    // Make room for at least NewCapacity elements.
+    void Reserve(int32 NewCapacity)
+    {
+        if (NewCapacity > Capacity)
+        {
+            Grow(NewCapacity);
+        }
+    }
+
+    template<typename... ArgsType>
+    ElementType& Emplace(ArgsType&&... Args)
+    {
+        if (Count == Capacity)
+        {
+            // Build first: Args may refer to an element that Grow is about to move.
+            ElementType Temp(Forward<ArgsType>(Args)...);
+            Grow(Count + 1);
+            new (Data + Count) ElementType(MoveTemp(Temp));
+        }
+        else
+        {
+            new (Data + Count) ElementType(Forward<ArgsType>(Args)...);
+        }
+        return Data[Count++];
+    }
+
+    int32 Add(const ElementType& Element)
+    {
+        Emplace(Element);
+        return Count - 1;
+    }
+
+    int32 Add(ElementType&& Element)
+    {
+        Emplace(MoveTemp(Element));
+        return Count - 1;
+    }
+
+    // Remove the last element.
+    void Pop()
+    {
+        check(Count > 0);
+        DestructItem(Data + --Count);
+    }
+
+    // Remove an element by moving the last one into its place (order not preserved).
+    void RemoveAtSwap(int32 Index)
+    {
+        check(Index >= 0 && Index < Count);
+        --Count;
+        if (Index != Count)
+        {
+            Data[Index] = MoveTemp(Data[Count]);
+        }
+        DestructItem(Data + Count);
+    }
+
+    bool Contains(const ElementType& Element) const
+    {
+        for (int32 i = 0; i < Count; ++i)
+        {
+            if (Data[i] == Element)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Destroy all elements but keep the current storage (heap block included).
+    void Reset()
+    {
+        DestructItems(Data, Count);
+        Count = 0;
+    }
+
+    // Destroy all elements and return to the inline buffer.
+    void Empty()
+    {
+        Reset();
+        ReleaseHeap();
+    }
+
+    // Range-based for support.
+    ElementType* begin() { return Data; }
+    ElementType* end() { return Data + Count; }
+    const ElementType* begin() const { return Data; }
+    const ElementType* end() const { return Data + Count; }
+};
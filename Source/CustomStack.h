@@ -99,6 +99,12 @@ public:
 		return MaxCapacity > 0 && Data.Num() >= MaxCapacity;
 	}
 
+	// Read-only view of the elements, bottom to top.
+	const TArray<ElementType>& GetElements() const
+	{
+		return Data;
+	}
+
 	// Empty the stack.
 	void Clear()
 	{
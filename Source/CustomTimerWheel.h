@@ -0,0 +1,290 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CustomSlotMap.h"
+
+/**
+ * CustomTimerWheel:
+ * Hierarchical timing wheel for large numbers of short gameplay timers.
+ * Time advances in fixed ticks of TickSeconds. Level 0 has one slot per tick for the next 64 ticks;
+ * each higher level covers 64 times the span of the level below. A timer sits in the lowest level
+ * that can hold its delay. When a lower level wraps around, the matching slot of the level above
+ * is cascaded down. Each slot is a doubly linked list threaded through the timer entries,
+ * so scheduling and cancelling never search.
+ * * Time Complexity:
+ * - Schedule / Cancel: O(1)
+ * - Advance: O(ticks elapsed + timers expired + timers cascaded); each timer cascades at most Levels - 1 times
+ * * Space Complexity: O(timers) + Levels * 64 slot heads
+ * * Precision: timers fire on the first tick at or after their deadline (at most one tick late, never early).
+ * * Use Case: Attack cooldowns, projectile lifetimes, wave intermissions (thousands of timers, few per slot).
+ */
+template<typename PayloadType>
+class PROJECT_GOLDFISH_API CustomTimerWheel
+{
+private:
+    static constexpr int32 SlotBits = 6;
+    static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+    static constexpr int32 Levels = 4;
+
+    // Delays beyond this many ticks are parked in the top level and re-cascaded until they fit.
+    static constexpr uint64 MaxSpanTicks = (uint64(1) << (SlotBits * Levels)) - 1;
+
+    struct FTimerEntry
+    {
+        PayloadType Payload;
+        uint64 ExpireTick = 0;
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+        uint32 Generation = 1;
+        uint8 Level = 0;
+        uint8 Slot = 0;
+        bool bActive = false;
+    };
+
+    struct FSlotList
+    {
+        int32 Head = INDEX_NONE;
+        int32 Tail = INDEX_NONE;
+    };
+
+    TArray<FTimerEntry> Entries;
+    FSlotList Wheel[Levels][SlotsPerLevel];
+    int32 FreeHead = INDEX_NONE;
+    int32 NumActive = 0;
+
+    double TickSeconds;
+    double AccumulatedSeconds = 0.0;
+    uint64 CurrentTick = 0;
+
+    void LinkEntry(int32 Index)
+    {
+        FTimerEntry& Entry = Entries[Index];
+
+        // Lowest level whose span holds the remaining delay; slot chosen from the absolute tick so it stays put.
+        const uint64 PlacementTick = FMath::Min(Entry.ExpireTick, CurrentTick + MaxSpanTicks);
+        const uint64 Delta = PlacementTick - CurrentTick;
+        int32 Level = 0;
+        while (Level < Levels - 1 && Delta >= (uint64(1) << (SlotBits * (Level + 1))))
+        {
+            Level++;
+        }
+        const int32 Slot = static_cast<int32>((PlacementTick >> (SlotBits * Level)) & (SlotsPerLevel - 1));
+
+        FSlotList& List = Wheel[Level][Slot];
+        Entry.Level = static_cast<uint8>(Level);
+        Entry.Slot = static_cast<uint8>(Slot);
+        Entry.Prev = List.Tail;
+        Entry.Next = INDEX_NONE;
+        if (List.Tail != INDEX_NONE)
+        {
+            Entries[List.Tail].Next = Index;
+        }
+        else
+        {
+            List.Head = Index;
+        }
+        List.Tail = Index;
+    }
+
+    void UnlinkEntry(int32 Index)
+    {
+        FTimerEntry& Entry = Entries[Index];
+        FSlotList& List = Wheel[Entry.Level][Entry.Slot];
+
+        if (Entry.Prev != INDEX_NONE)
+        {
+            Entries[Entry.Prev].Next = Entry.Next;
+        }
+        else
+        {
+            List.Head = Entry.Next;
+        }
+
+        if (Entry.Next != INDEX_NONE)
+        {
+            Entries[Entry.Next].Prev = Entry.Prev;
+        }
+        else
+        {
+            List.Tail = Entry.Prev;
+        }
+
+        Entry.Prev = INDEX_NONE;
+        Entry.Next = INDEX_NONE;
+    }
+
+    // Return an unlinked entry to the free list. Its handles go stale.
+    void FreeEntry(int32 Index)
+    {
+        FTimerEntry& Entry = Entries[Index];
+        Entry.Payload = PayloadType();
+        Entry.Generation = Entry.Generation == MAX_uint32 ? 1 : Entry.Generation + 1;
+        Entry.bActive = false;
+        Entry.Next = FreeHead;
+        FreeHead = Index;
+        NumActive--;
+    }
+
+    const FTimerEntry* FindEntry(FSlotMapHandle Handle) const
+    {
+        if (!Entries.IsValidIndex(Handle.Index))
+        {
+            return nullptr;
+        }
+
+        const FTimerEntry& Entry = Entries[Handle.Index];
+        return Entry.bActive && Entry.Generation == Handle.Generation ? &Entry : nullptr;
+    }
+
+    // Move every timer of a higher-level slot down to the level that now fits its remaining delay.
+    void Cascade(int32 Level)
+    {
+        const int32 Slot = static_cast<int32>((CurrentTick >> (SlotBits * Level)) & (SlotsPerLevel - 1));
+        FSlotList& List = Wheel[Level][Slot];
+
+        int32 Index = List.Head;
+        List.Head = INDEX_NONE;
+        List.Tail = INDEX_NONE;
+        while (Index != INDEX_NONE)
+        {
+            const int32 Next = Entries[Index].Next;
+            LinkEntry(Index);
+            Index = Next;
+        }
+    }
+
+public:
+    explicit CustomTimerWheel(float InTickSeconds = 1.0f / 60.0f)
+        : TickSeconds(FMath::Max(static_cast<double>(InTickSeconds), 0.0001))
+    {
+    }
+
+    // Schedule Payload to expire after DelaySeconds (rounded up to whole ticks, at least one).
+    FSlotMapHandle Schedule(float DelaySeconds, const PayloadType& Payload)
+    {
+        int32 Index;
+        if (FreeHead != INDEX_NONE)
+        {
+            Index = FreeHead;
+            FreeHead = Entries[Index].Next;
+        }
+        else
+        {
+            Index = Entries.AddDefaulted();
+        }
+
+        // Time already accumulated towards the next tick counts against the delay.
+        const double TicksFromNow = FMath::Max((DelaySeconds + AccumulatedSeconds) / TickSeconds, 1.0);
+        const uint64 DelayTicks = static_cast<uint64>(FMath::Min(FMath::CeilToDouble(TicksFromNow), static_cast<double>(MAX_uint32)));
+
+        FTimerEntry& Entry = Entries[Index];
+        Entry.Payload = Payload;
+        Entry.ExpireTick = CurrentTick + DelayTicks;
+        Entry.bActive = true;
+        NumActive++;
+        LinkEntry(Index);
+
+        return FSlotMapHandle(Index, Entry.Generation);
+    }
+
+    // Cancel a pending timer. Returns false if it already fired or was cancelled.
+    bool Cancel(FSlotMapHandle Handle)
+    {
+        if (FindEntry(Handle) == nullptr)
+        {
+            return false;
+        }
+
+        UnlinkEntry(Handle.Index);
+        FreeEntry(Handle.Index);
+        return true;
+    }
+
+    bool IsActive(FSlotMapHandle Handle) const
+    {
+        return FindEntry(Handle) != nullptr;
+    }
+
+    // Seconds until the timer fires (0 if it is not active).
+    float GetRemainingSeconds(FSlotMapHandle Handle) const
+    {
+        const FTimerEntry* Entry = FindEntry(Handle);
+        return Entry != nullptr ? static_cast<float>((Entry->ExpireTick - CurrentTick) * TickSeconds - AccumulatedSeconds) : 0.0f;
+    }
+
+    /**
+     * Advance time and call OnExpired(Payload) for every timer that came due, tick by tick, in deadline order
+     * (schedule order within a tick). The callback may Schedule and Cancel freely: a timer it schedules
+     * fires in this same Advance if its deadline falls inside the elapsed time.
+     */
+    template<typename FuncType>
+    void Advance(float DeltaSeconds, FuncType&& OnExpired)
+    {
+        AccumulatedSeconds += FMath::Max(DeltaSeconds, 0.0f);
+        while (AccumulatedSeconds >= TickSeconds)
+        {
+            AccumulatedSeconds -= TickSeconds;
+
+            // Nothing scheduled: skip the remaining ticks without touching the slots.
+            if (NumActive == 0)
+            {
+                const uint64 SkippedTicks = static_cast<uint64>(AccumulatedSeconds / TickSeconds);
+                CurrentTick += SkippedTicks + 1;
+                AccumulatedSeconds -= SkippedTicks * TickSeconds;
+                break;
+            }
+
+            CurrentTick++;
+
+            // Higher levels first, so timers they hand down land in slots that are cascaded next.
+            for (int32 Level = Levels - 1; Level > 0; --Level)
+            {
+                if ((CurrentTick & ((uint64(1) << (SlotBits * Level)) - 1)) == 0)
+                {
+                    Cascade(Level);
+                }
+            }
+
+            // Pop one at a time so the callback can cancel other timers of this slot.
+            FSlotList& Due = Wheel[0][CurrentTick & (SlotsPerLevel - 1)];
+            while (Due.Head != INDEX_NONE)
+            {
+                const int32 Index = Due.Head;
+                UnlinkEntry(Index);
+                PayloadType Payload = MoveTemp(Entries[Index].Payload);
+                FreeEntry(Index);
+                OnExpired(Payload);
+            }
+        }
+    }
+
+    // Cancel every timer (outstanding handles go stale). Entry storage is kept for reuse.
+    void Clear()
+    {
+        for (int32 Level = 0; Level < Levels; ++Level)
+        {
+            for (int32 Slot = 0; Slot < SlotsPerLevel; ++Slot)
+            {
+                FSlotList& List = Wheel[Level][Slot];
+                while (List.Head != INDEX_NONE)
+                {
+                    const int32 Index = List.Head;
+                    UnlinkEntry(Index);
+                    FreeEntry(Index);
+                }
+            }
+        }
+        AccumulatedSeconds = 0.0;
+    }
+
+    void Reserve(int32 NumTimers)
+    {
+        Entries.Reserve(NumTimers);
+    }
+
+    int32 Num() const { return NumActive; }
+    bool IsEmpty() const { return NumActive == 0; }
+    float GetTickSeconds() const { return static_cast<float>(TickSeconds); }
+};
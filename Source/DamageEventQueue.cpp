@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DamageEventQueue.h"
+#include "Enemy.h"
+#include "FpsCharacter.h"
+#include "Kismet/GameplayStatics.h"
+#include "CombatAudioScheduler.h"
+#include "PlayerCache.h"
+
+void UDamageEventQueue::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Runs after every actor and tickable object (hitscan resolver, projectile manager) has ticked,
+	// so all hits of the frame are in the batch.
+	m_hPostActorTick = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UDamageEventQueue::HandlePostActorTick);
+}
+
+void UDamageEventQueue::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(m_hPostActorTick);
+	m_Events.Reset();
+
+	Super::Deinitialize();
+}
+
+void UDamageEventQueue::Enqueue(AEnemy* Target, int Amount)
+{
+	if (Target == nullptr || Amount <= 0)
+		return;
+
+	m_Events.Add({ Target, Amount });
+}
+
+void UDamageEventQueue::GetBatchStats(int32& OutHits, int32& OutEnemiesDamaged, int32& OutSoundsSkipped, float& OutBatchTimeMs) const
+{
+	OutHits = m_iLastHits;
+	OutEnemiesDamaged = m_iLastEnemiesDamaged;
+	OutSoundsSkipped = m_iLastSoundsSkipped;
+	OutBatchTimeMs = m_fLastBatchTime * 1000.0f;
+}
+
+void UDamageEventQueue::HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld() && m_Events.Num() > 0)
+	{
+		Flush();
+	}
+}
+
+void UDamageEventQueue::Flush()
+{
+	double startTime = FPlatformTime::Seconds();
+
+	Swap(m_Events, m_Processing);
+	m_Events.Reset();
+
+	m_Totals.Reset();
+	m_TargetSlots.Clear();
+
+	// 1) Apply health hit by hit, in arrival order, and sum the points earned.
+	float fPoints = 0.0f;
+	int32 iAppliedHits = 0;
+	for (const FDamageEvent& event : m_Processing)
+	{
+		AEnemy* pEnemy = event.Target.Get();
+		if (pEnemy == nullptr)
+			continue;
+
+		float fEarned = 0.0f;
+		bool bDied = false;
+		if (!pEnemy->ApplyQueuedDamage(event.Amount, fEarned, bDied))
+			continue; // Already dead: the hit is dropped, as ReceiveDamage used to.
+
+		fPoints += fEarned;
+		iAppliedHits++;
+
+		int32 iSlot = INDEX_NONE;
+		if (!m_TargetSlots.Find(pEnemy, iSlot))
+		{
+			iSlot = m_Totals.Add({ pEnemy, 0 });
+			m_TargetSlots.Insert(pEnemy, iSlot);
+		}
+		m_Totals[iSlot].TotalDamage += event.Amount;
+	}
+
+	// 2) One sound request and one delegate broadcast per damaged enemy; the audio scheduler applies the voice budget.
+	UCombatAudioScheduler* pAudio = GetWorld()->GetSubsystem<UCombatAudioScheduler>();
+	m_iLastSoundsSkipped = iAppliedHits - m_Totals.Num(); // Deduped: several hits on one enemy.
+	for (const FTargetTotals& totals : m_Totals)
+	{
+		pAudio->RequestSound(totals.Target->GetDamagedSound(), totals.Target->GetActorLocation(), ECombatSoundCategory::EnemyDamaged, 1.0f);
+
+		totals.Target->OnEnemyDamaged.Broadcast((float)totals.TotalDamage);
+	}
+
+	// 3) A single points award for the whole batch.
+	if (fPoints > 0.0f)
+	{
+		if (APlayerStats* pStats = GetWorld()->GetSubsystem<UPlayerCache>()->GetPlayerStats())
+		{
+			pStats->AddPoints((int)fPoints);
+		}
+	}
+
+	m_iLastHits = m_Processing.Num();
+	m_iLastEnemiesDamaged = m_Totals.Num();
+	m_Processing.Reset();
+
+	m_fLastBatchTime = static_cast<float>(FPlatformTime::Seconds() - startTime);
+}
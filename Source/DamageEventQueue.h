@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CustomHashMap.h"
+#include "DamageEventQueue.generated.h"
+
+class AEnemy;
+
+/**
+ * UDamageEventQueue:
+ * Decouples landing a hit from its side effects.
+ * AEnemy::ReceiveDamage only records the hit; once per frame, after all actors and subsystems
+ * have ticked, the queue processes every hit in one batch:
+ * - health is applied per hit in arrival order (hits on an already dead enemy are dropped),
+ * - points for all hits and kills are summed into a single APlayerStats::AddPoints call,
+ * - OnEnemyDamaged fires once per damaged enemy with the frame's total,
+ * - the damaged sound is requested once per enemy (UCombatAudioScheduler enforces the voice budget).
+ * Side-effect cost scales with the number of enemies hit, not the number of hits.
+ */
+UCLASS()
+class PROJECT_GOLDFISH_API UDamageEventQueue : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Record a hit. Side effects happen when the batch is processed at the end of the frame.
+	void Enqueue(AEnemy* Target, int Amount);
+
+	// Process every queued hit now (normally called automatically at the end of the frame).
+	void Flush();
+
+	// Hits and enemies processed in the last batch, and damaged sounds skipped by per-enemy dedupe.
+	UFUNCTION(BlueprintPure, Category="Performance")
+	void GetBatchStats(int32& OutHits, int32& OutEnemiesDamaged, int32& OutSoundsSkipped, float& OutBatchTimeMs) const;
+
+	// USubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FDamageEvent
+	{
+		TWeakObjectPtr<AEnemy> Target;
+		int Amount = 0;
+	};
+
+	// Per-enemy totals for the batch being processed.
+	struct FTargetTotals
+	{
+		AEnemy* Target = nullptr;
+		int TotalDamage = 0;
+	};
+
+	// Double buffered so hits raised while processing (e.g. by delegates) land in the next batch.
+	TArray<FDamageEvent> m_Events;
+	TArray<FDamageEvent> m_Processing;
+	TArray<FTargetTotals> m_Totals;
+
+	// Enemy -> index into m_Totals.
+	CustomHashMap<AEnemy*, int32> m_TargetSlots;
+
+	FDelegateHandle m_hPostActorTick;
+
+	// Stats.
+	int32 m_iLastHits = 0;
+	int32 m_iLastEnemiesDamaged = 0;
+	int32 m_iLastSoundsSkipped = 0;
+	float m_fLastBatchTime = 0.0f;
+
+	void HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+};
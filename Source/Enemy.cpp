@@ -4,6 +4,12 @@
 #include "Enemy.h"
 #include "Kismet/GameplayStatics.h"
 #include "FpsCharacter.h"
+#include "GameplayRandom.h"
+#include "DamageEventQueue.h"
+#include "CombatAudioScheduler.h"
+#include "PlayerCache.h"
+#include "GameplayDataSubsystem.h"
+#include "Animation/AnimMontage.h"
 
 
 // Sets default values
@@ -13,6 +19,15 @@ AEnemy::AEnemy()
 	PrimaryActorTick.bCanEverTick = true;
 }
 
+void AEnemy::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Cooked tuning data overrides the Blueprint defaults. Applied here rather than in BeginPlay so the
+	// director, whose BeginPlay may run first, already reads the cooked attack range.
+	ApplyGameplayData();
+}
+
 // Called when the game starts or when spawned
 void AEnemy::BeginPlay()
 {
@@ -22,11 +37,36 @@ void AEnemy::BeginPlay()
 	FHealth = FInitialHealth;
 	m_vSpawnLocation = GetActorLocation();
 	
+	// Route montage ends by pointer: the death montage hands the body back to the director, attacks do nothing.
+	if (PAttackMontage != nullptr)
+	{
+		m_MontageActions.Add(PAttackMontage, EMontageAction::None);
+	}
+	if (PDeathMontage != nullptr)
+	{
+		m_MontageActions.Add(PDeathMontage, EMontageAction::ReturnToPool);
+	}
+
 	// Bind the animation end event to our handler function.
-	// This allows us to know when the Death animation finishes to remove the body.
 	GetMesh()->GetAnimInstance()->OnMontageEnded.AddDynamic(this, &AEnemy::HandleOnMontageEnded);
 }
 
+void AEnemy::ApplyGameplayData()
+{
+	const FGameplayDataView* pData = UGameplayDataSubsystem::Get(this);
+	const GameplayData::FEnemyStatsRecord* pStats = pData != nullptr ? pData->FindEnemy(m_GameplayDataRow) : nullptr;
+	if (pStats == nullptr)
+		return;
+
+	// Read in place from the mapped table.
+	FInitialHealth = pStats->InitialHealth;
+	FAttackDamage = pStats->AttackDamage;
+	FAttackRange = pStats->AttackRange;
+	FBaseSpeed = pStats->BaseSpeed;
+	IPointsPerHitTaken = pStats->PointsPerHit;
+	IPointsFromDeath = pStats->PointsFromDeath;
+}
+
 // Called every frame
 void AEnemy::Tick(float DeltaTime)
 {
@@ -44,29 +84,37 @@ void AEnemy::ReceiveDamage(int iAmount)
 	if (FHealth <= 0)
 		return; // Prevent logic from running if the enemy is already dead/dying.
 
-	// Apply damage.
-	FHealth -= iAmount;
-	
-	// Broadcast event for UI or other listeners (e.g. health bars).
-	OnEnemyDamaged.Broadcast((float)iAmount);
+	// Hits are batched: health, sounds, points and OnEnemyDamaged are handled once per frame by the queue.
+	GetWorld()->GetSubsystem<UDamageEventQueue>()->Enqueue(this, iAmount);
+}
 
-	// Play reaction to damage sfx at the enemy's location.
-	UWorld* pWorld = GetWorld();
-	UGameplayStatics::PlaySoundAtLocation(pWorld, PDamagedSound, GetActorLocation());
+bool AEnemy::ApplyQueuedDamage(int iAmount, float& OutPointsEarned, bool& bOutDied)
+{
+	OutPointsEarned = 0.0f;
+	bOutDied = false;
 
-	// Reward points to the player for damaging an enemy.
-	// Casts to the specific AFpsCharacter to access the Stats component.
-	AFpsCharacter* pPlayerCharacter = Cast<AFpsCharacter>(pWorld->GetFirstPlayerController()->GetCharacter());
-	if (pPlayerCharacter)
-	{
-		pPlayerCharacter->Stats->AddPoints(IPointsPerHitTaken);
-	}
+	// An earlier hit in the same batch may already have killed the enemy.
+	if (FHealth <= 0)
+		return false;
+
+	// Apply damage and reward points for the hit.
+	FHealth -= iAmount;
+	OutPointsEarned = IPointsPerHitTaken;
 
 	// Check if health has depleted to trigger death.
 	if (FHealth <= 0)
 	{
 		Die();
+		OutPointsEarned += IPointsFromDeath;
+		bOutDied = true;
 	}
+
+	return true;
+}
+
+USoundBase* AEnemy::GetDamagedSound() const
+{
+	return PDamagedSound;
 }
 
 void AEnemy::RecoverHealth(int iAmount)
@@ -79,6 +127,11 @@ UAnimMontage* AEnemy::GetAttackMontage()
     return PAttackMontage;
 }
 
+float AEnemy::GetAttackDuration() const
+{
+	return PAttackMontage != nullptr ? PAttackMontage->GetPlayLength() / FMath::Max(PAttackMontage->RateScale, UE_KINDA_SMALL_NUMBER) : 0.0f;
+}
+
 float AEnemy::GetAttackRange()
 {
     return FAttackRange;
@@ -89,7 +142,28 @@ float AEnemy::GetBaseSpeed()
 	return FBaseSpeed;
 }
 
-void AEnemy::Attack()
+float AEnemy::GetHealth() const
+{
+	return FHealth;
+}
+
+void AEnemy::SetCombatSlot(AEnemyDirectorEnhanced* pDirector, int iIndex)
+{
+	m_pCombatDirector = pDirector;
+	m_iCombatIndex = iIndex;
+}
+
+AEnemyDirectorEnhanced* AEnemy::GetCombatDirector() const
+{
+	return m_pCombatDirector;
+}
+
+int AEnemy::GetCombatIndex() const
+{
+	return m_iCombatIndex;
+}
+
+bool AEnemy::Attack()
 {
 	UWorld* pWorld = GetWorld();
 
@@ -99,7 +173,7 @@ void AEnemy::Attack()
 	{
 		// Prevent attacking if the enemy is currently playing the death animation.
 		if (pAnimInstance->Montage_IsPlaying(PDeathMontage))
-			return; 
+			return false;
 
 		pAnimInstance->Montage_Play(PAttackMontage);
 	}
@@ -107,17 +181,19 @@ void AEnemy::Attack()
 	// Play a random attack sfx from the array.
 	if (PAttackSounds.Num() > 0)
 	{
-		USoundBase* pAttackSound = PAttackSounds[FMath::RandRange(0, PAttackSounds.Num() - 1)];
-		UGameplayStatics::PlaySoundAtLocation(pWorld, pAttackSound, GetActorLocation());
+		USoundBase* pAttackSound = PAttackSounds[GameplayRandom::RandRange(0, PAttackSounds.Num() - 1)];
+		pWorld->GetSubsystem<UCombatAudioScheduler>()->RequestSound(pAttackSound, GetActorLocation(), ECombatSoundCategory::EnemyAttack, 1.5f);
 	}
 
 	// Deal damage to the player.
-	// Finds the player character and calls their ReceiveDamage interface/method.
-	AFpsCharacter* pPlayer = Cast<AFpsCharacter>(UGameplayStatics::GetPlayerCharacter(pWorld, 0));
+	// Reads the cached player character and calls their ReceiveDamage interface/method.
+	AFpsCharacter* pPlayer = pWorld->GetSubsystem<UPlayerCache>()->GetPlayerCharacter();
 	if (pPlayer)
 	{
 		pPlayer->ReceiveDamage(FAttackDamage);
 	}
+
+	return true;
 }
 
 void AEnemy::Die()
@@ -137,22 +213,15 @@ void AEnemy::Die()
 	UWorld* pWorld = GetWorld();
 	if (PDeathSounds.Num() > 0)
 	{
-		USoundBase* pDeathSound = PDeathSounds[FMath::RandRange(0, PDeathSounds.Num() - 1)];
-		UGameplayStatics::PlaySoundAtLocation(pWorld, pDeathSound, GetActorLocation());
+		USoundBase* pDeathSound = PDeathSounds[GameplayRandom::RandRange(0, PDeathSounds.Num() - 1)];
+		pWorld->GetSubsystem<UCombatAudioScheduler>()->RequestSound(pDeathSound, GetActorLocation(), ECombatSoundCategory::EnemyDeath, 2.0f);
 	}
 
-	// Reward points for killing an enemy (Bonus points for the kill).
-	AFpsCharacter* pPlayerCharacter = Cast<AFpsCharacter>(GetWorld()->GetFirstPlayerController()->GetCharacter());
-	if (pPlayerCharacter)
-	{
-		pPlayerCharacter->Stats->AddPoints(IPointsFromDeath);
-	}
+	// Kill bonus points are awarded by UDamageEventQueue together with the rest of the batch.
 }
 
 void AEnemy::ReturnToPool()
 {
-	// Execute the OnEnemyKilled delegate to notify the spawner this enemy is free.
-	OnEnemyKilled.ExecuteIfBound();
 	OnEnemyKilled.Clear(); // Clear binding to prevent stale references.
 
 	// Return enemy back to the original spawn pool location.
@@ -166,11 +235,19 @@ void AEnemy::ReturnToPool()
 
 void AEnemy::HandleOnMontageEnded(UAnimMontage* pMontage, bool bWasInterrupted)
 {
-	// Check if the montage that just finished was a Death animation.
-	// We rely on the animation asset name containing "Death".
-	if (pMontage && pMontage->GetName().Contains("Death"))
+	const EMontageAction* pAction = m_MontageActions.Find(pMontage);
+	if (pAction == nullptr)
+		return;
+
+	switch (*pAction)
 	{
-		// Once the death animation finishes, we recycle the enemy.
-		ReturnToPool();
+	case EMontageAction::ReturnToPool:
+		// Once the death animation finishes, queue the enemy with the director; it recycles the batch on its tick.
+		OnEnemyKilled.ExecuteIfBound(this);
+		break;
+
+	case EMontageAction::None:
+	default:
+		break;
 	}
 }
\ No newline at end of file
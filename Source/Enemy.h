@@ -5,10 +5,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "HealthInterface.h"
+#include "CustomIntrusiveList.h"
 #include "Enemy.generated.h"
 
-// Delegate for notifying when this specific enemy is killed (single binding).
-DECLARE_DYNAMIC_DELEGATE(FOnEnemyKilled);
+class AEnemy;
+class AEnemyDirectorEnhanced;
+
+// Delegate for notifying when this specific enemy is killed and ready to be pooled (single binding).
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnEnemyKilled, AEnemy*, pEnemy);
 
 // Multicast delegate for notifying UI or other systems when damage is taken (multiple bindings).
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyDamaged, float, fDamageTaken);
@@ -46,23 +50,52 @@ public:
 	// Restore health.
 	virtual void RecoverHealth(int amount) override;
 
+	// Apply a hit queued by UDamageEventQueue (health and death only; the queue batches sounds, points and delegates).
+	// Returns false if the enemy was already dead. OutPointsEarned includes the kill bonus when bOutDied is set.
+	bool ApplyQueuedDamage(int iAmount, float& OutPointsEarned, bool& bOutDied);
+
+	// Return the sound played when this enemy is damaged.
+	USoundBase* GetDamagedSound() const;
+
 	// Perform an attack logic (Animation, Sound, Damage dealing).
-	void Attack();
+	// Returns false if the enemy is dying and did not attack.
+	bool Attack();
+
+	// Assign the director entity whose components track this enemy's attack/cooldown state.
+	void SetCombatSlot(AEnemyDirectorEnhanced* pDirector, int iIndex);
+	// Return the director owning this enemy's combat state (null if no director tracks it).
+	AEnemyDirectorEnhanced* GetCombatDirector() const;
+	// Return this enemy's entity in the director's component store.
+	int GetCombatIndex() const;
 
 	/*
 	Getter functions.
 	*/
 	// Return the enemy's attack montage asset.
 	UAnimMontage* GetAttackMontage();
+	// Return the length of the attack montage in seconds (0 if none is assigned).
+	float GetAttackDuration() const;
 	// Return the enemy's attack range.
 	float GetAttackRange();
 	// Return the enemy's base speed stat.
 	float GetBaseSpeed();
+	// Return the enemy's current health.
+	float GetHealth() const;
 
 	// True if the enemy is active in the arena (spawned and fighting).
 	bool BInArena = false;
 
+	// Link in the director's pooled-enemy list (see AEnemyDirectorEnhanced::PooledEnemies).
+	CustomIntrusiveListNode<AEnemy> PoolLink;
+
+	// Reset the enemy state and teleport back to spawn (Object Pooling).
+	// Called by the director when it processes its queued pool returns.
+	void ReturnToPool();
+
 protected:
+	// Called once components are initialized; every actor in the level gets this before any BeginPlay.
+	virtual void PostInitializeComponents() override;
+
 	// Called when the game starts or when spawned.
 	virtual void BeginPlay() override;
 
@@ -110,6 +143,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	float IPointsFromDeath = 150;
 
+	// Row in the cooked gameplay data tables (UGameplayDataSubsystem) overriding the stats above. None keeps them.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Data")
+	FName m_GameplayDataRow;
+
 	// Current health at runtime.
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	float FHealth = 1.0f;
@@ -122,11 +159,25 @@ private:
 	// Location to return to when pooled.
 	FVector m_vSpawnLocation;
 
+	// Director combat slot (see AEnemyDirectorEnhanced::TryBeginAttack).
+	AEnemyDirectorEnhanced* m_pCombatDirector = nullptr;
+	int m_iCombatIndex = INDEX_NONE;
+
+	// What to do when a montage owned by this enemy finishes.
+	enum class EMontageAction : uint8
+	{
+		None,
+		ReturnToPool
+	};
+
+	// Montage pointer -> action, built once at BeginPlay so montage ends never touch asset names.
+	TMap<const UAnimMontage*, EMontageAction> m_MontageActions;
+
 	// Trigger the death sequence (Anim, Sound, Scoring).
 	void Die();
-	
-	// Reset the enemy state and teleport back to spawn (Object Pooling).
-	void ReturnToPool();
+
+	// Copy the stats of m_GameplayDataRow from the cooked gameplay data, if present.
+	void ApplyGameplayData();
 
 	// Callback bound to the AnimInstance to detect when animations finish.
 	UFUNCTION()
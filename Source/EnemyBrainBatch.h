@@ -0,0 +1,93 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JobSystem.h"
+
+/**
+ * Command issued by the batched brain for one enemy this frame.
+ */
+enum class EEnemyBrainCommand : uint8
+{
+    None,
+    Move,
+    Attack
+};
+
+/**
+ * FEnemyBrainBatch:
+ * Data-oriented replacement for the enemy behavior tree (FindPlayerLocation -> ChasePlayer ->
+ * IsPlayerInRange -> Attack). Inputs are gathered into flat arrays on the game thread, the decision
+ * for every enemy is evaluated in a FJobSystem::ParallelFor, and the resulting commands are applied back on the
+ * game thread by the director.
+ * * Decision per enemy (same as the tree):
+ * - In attack range and combat Ready -> Attack.
+ * - Out of range -> Move to the player, re-issued only once the player has moved RepathDistance
+ *   away from the last target (the tree re-issued MoveToLocation every pass).
+ * * Time Complexity: O(n / workers) for Evaluate, O(n) gather/apply.
+ */
+struct FEnemyBrainBatch
+{
+    // --- Inputs (gathered each frame) ---
+    TArray<FVector> Locations;
+    TArray<float> AttackRangesSquared;
+    TArray<uint8> Active;
+    TArray<uint8> CombatReady;
+
+    // --- Persistent per-enemy state ---
+    TArray<FVector> LastMoveTargets;
+    TArray<uint8> HasMoveTarget;
+
+    // --- Output ---
+    TArray<EEnemyBrainCommand> Commands;
+
+    void Reset(int32 Count)
+    {
+        Locations.Init(FVector::ZeroVector, Count);
+        AttackRangesSquared.Init(0.0f, Count);
+        Active.Init(0, Count);
+        CombatReady.Init(0, Count);
+        LastMoveTargets.Init(FVector::ZeroVector, Count);
+        HasMoveTarget.Init(0, Count);
+        Commands.Init(EEnemyBrainCommand::None, Count);
+    }
+
+    int32 Num() const
+    {
+        return Commands.Num();
+    }
+
+    // Forget the last move target (enemy returned to the pool or re-entered the arena).
+    void ClearMoveTarget(int32 Index)
+    {
+        HasMoveTarget[Index] = 0;
+    }
+
+    // Decide a command for every enemy. Each iteration only writes its own index, so the loop is data-race free.
+    void Evaluate(FJobSystem& Jobs, const FVector& PlayerLocation, float RepathDistanceSquared, int32 MinBatchSize)
+    {
+        Jobs.ParallelFor(TEXT("EnemyBrainBatch"), Num(), MinBatchSize, [this, PlayerLocation, RepathDistanceSquared](int32 i)
+        {
+            Commands[i] = EEnemyBrainCommand::None;
+            if (!Active[i])
+                return;
+
+            if (FVector::DistSquared(Locations[i], PlayerLocation) <= AttackRangesSquared[i])
+            {
+                if (CombatReady[i])
+                {
+                    Commands[i] = EEnemyBrainCommand::Attack;
+                }
+                return;
+            }
+
+            if (!HasMoveTarget[i] || FVector::DistSquared(LastMoveTargets[i], PlayerLocation) > RepathDistanceSquared)
+            {
+                Commands[i] = EEnemyBrainCommand::Move;
+                LastMoveTargets[i] = PlayerLocation;
+                HasMoveTarget[i] = 1;
+            }
+        });
+    }
+};
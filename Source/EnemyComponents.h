@@ -0,0 +1,297 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CustomSlotMap.h"
+#include <tuple>
+
+/**
+ * Enemy entity: the enemy's index in the director's enemy list (also its registry ID and combat index).
+ * Entities never change while the level runs; components come and go as the enemy is pooled or fights.
+ */
+using FEnemyEntity = int32;
+
+/**
+ * Combat state of a single enemy.
+ * Ready -> Attacking (attack montage length) -> Cooldown (director cooldown) -> Ready.
+ */
+enum class EEnemyCombatState : uint8
+{
+    Ready,
+    Attacking,
+    Cooldown
+};
+
+/**
+ * Pool state of a single enemy (mirrors AEnemy::BInArena at the frame boundary).
+ */
+enum class EEnemyPoolState : uint8
+{
+    Pooled,
+    InArena
+};
+
+// --- Components ---
+
+// World location (arena enemies only).
+struct FEnemyPosition
+{
+    FVector Location = FVector::ZeroVector;
+};
+
+// Movement velocity (arena enemies only).
+struct FEnemyVelocity
+{
+    FVector Velocity = FVector::ZeroVector;
+};
+
+// Current health (every enemy).
+struct FEnemyHealth
+{
+    float Health = 0.0f;
+};
+
+// Attack/cooldown state. Only present while the enemy is not Ready.
+// Timer is the pending director timer that ends the current state (see AEnemyDirectorEnhanced::DirectorTimers).
+struct FEnemyAttackState
+{
+    EEnemyCombatState State = EEnemyCombatState::Attacking;
+    FSlotMapHandle Timer;
+};
+
+// Distance to the player and threat score (arena enemies only, written by the director jobs).
+struct FEnemyThreat
+{
+    float Distance = 0.0f;
+    float Score = 0.0f;
+};
+
+// Pool state (every enemy).
+struct FEnemyPoolState
+{
+    EEnemyPoolState State = EEnemyPoolState::Pooled;
+};
+
+/**
+ * TComponentSet:
+ * Sparse set storage for one component type.
+ * * Structure:
+ * - Sparse: entity -> index into the dense arrays (INDEX_NONE if the entity has no component).
+ * - Dense: packed components plus the owning entity of each, so systems iterate contiguous memory.
+ * * Time Complexity:
+ * - Add / Remove (swap with last) / Contains / Find: O(1)
+ * - Iteration: O(k) where k = entities that have the component
+ * * Removing invalidates dense indices and references (the last component moves into the hole).
+ */
+template<typename T>
+class TComponentSet
+{
+public:
+    // Size the sparse index for NumEntities and drop every component.
+    void Reset(int32 NumEntities)
+    {
+        Sparse.Init(INDEX_NONE, NumEntities);
+        Entities.Reset();
+        Dense.Reset();
+    }
+
+    bool Contains(FEnemyEntity Entity) const
+    {
+        return Sparse.IsValidIndex(Entity) && Sparse[Entity] != INDEX_NONE;
+    }
+
+    // Add the component (or overwrite the existing one) and return it.
+    T& Add(FEnemyEntity Entity, const T& Value = T())
+    {
+        check(Sparse.IsValidIndex(Entity));
+        if (Sparse[Entity] != INDEX_NONE)
+        {
+            T& Existing = Dense[Sparse[Entity]];
+            Existing = Value;
+            return Existing;
+        }
+
+        Sparse[Entity] = Dense.Num();
+        Entities.Add(Entity);
+        return Dense.Add_GetRef(Value);
+    }
+
+    // Remove the component if present. The last component moves into the freed dense slot.
+    void Remove(FEnemyEntity Entity)
+    {
+        if (!Contains(Entity))
+            return;
+
+        const int32 Index = Sparse[Entity];
+        const int32 Last = Dense.Num() - 1;
+        if (Index != Last)
+        {
+            Dense[Index] = MoveTemp(Dense[Last]);
+            Entities[Index] = Entities[Last];
+            Sparse[Entities[Index]] = Index;
+        }
+
+        Dense.Pop(EAllowShrinking::No);
+        Entities.Pop(EAllowShrinking::No);
+        Sparse[Entity] = INDEX_NONE;
+    }
+
+    T* Find(FEnemyEntity Entity)
+    {
+        return Contains(Entity) ? &Dense[Sparse[Entity]] : nullptr;
+    }
+
+    const T* Find(FEnemyEntity Entity) const
+    {
+        return Contains(Entity) ? &Dense[Sparse[Entity]] : nullptr;
+    }
+
+    T& Get(FEnemyEntity Entity)
+    {
+        check(Contains(Entity));
+        return Dense[Sparse[Entity]];
+    }
+
+    const T& Get(FEnemyEntity Entity) const
+    {
+        check(Contains(Entity));
+        return Dense[Sparse[Entity]];
+    }
+
+    // Number of components (not entities).
+    int32 Num() const
+    {
+        return Dense.Num();
+    }
+
+    // Dense access, for systems that walk the packed array directly (e.g. a ParallelFor over Num()).
+    FEnemyEntity GetEntity(int32 DenseIndex) const
+    {
+        return Entities[DenseIndex];
+    }
+
+    T& GetAt(int32 DenseIndex)
+    {
+        return Dense[DenseIndex];
+    }
+
+    const T& GetAt(int32 DenseIndex) const
+    {
+        return Dense[DenseIndex];
+    }
+
+private:
+    TArray<int32> Sparse;
+    TArray<FEnemyEntity> Entities;
+    TArray<T> Dense;
+};
+
+/**
+ * FEnemyComponentStore:
+ * ECS-style component storage for every enemy managed by a director.
+ * Each component type lives in its own TComponentSet, and systems run over typed views instead of
+ * reaching through actor pointers. Actors remain the presentation proxies: the director copies their
+ * state in at the start of each frame (SyncComponentsFromActors).
+ * * Time Complexity:
+ * - Get/Add/Remove a component: O(1)
+ * - Each<A, B...>: O(k) where k = components of the driving type A
+ */
+struct FEnemyComponentStore
+{
+    // Size every set for NumEntities and drop all components.
+    void Reset(int32 NumEntities)
+    {
+        NumEnemyEntities = NumEntities;
+        std::apply([NumEntities](auto&... Set) { (Set.Reset(NumEntities), ...); }, Sets);
+    }
+
+    int32 NumEntities() const
+    {
+        return NumEnemyEntities;
+    }
+
+    bool IsValidEntity(FEnemyEntity Entity) const
+    {
+        return Entity >= 0 && Entity < NumEnemyEntities;
+    }
+
+    template<typename T>
+    TComponentSet<T>& Set()
+    {
+        return std::get<TComponentSet<T>>(Sets);
+    }
+
+    template<typename T>
+    const TComponentSet<T>& Set() const
+    {
+        return std::get<TComponentSet<T>>(Sets);
+    }
+
+    /**
+     * Typed view: calls Func(Entity, A&, B&...) for every entity that has all the listed components.
+     * The first type drives the iteration (walked densely), so list the smallest set first.
+     * Func must not add or remove components of the driving type.
+     */
+    template<typename TDriver, typename... TOthers, typename FuncType>
+    void Each(FuncType&& Func)
+    {
+        TComponentSet<TDriver>& Driver = Set<TDriver>();
+        for (int32 i = 0; i < Driver.Num(); ++i)
+        {
+            const FEnemyEntity Entity = Driver.GetEntity(i);
+            if ((Set<TOthers>().Contains(Entity) && ...))
+            {
+                Func(Entity, Driver.GetAt(i), Set<TOthers>().Get(Entity)...);
+            }
+        }
+    }
+
+    // --- Combat System ---
+
+    // Ready means "no attack state component".
+    bool IsCombatReady(FEnemyEntity Entity) const
+    {
+        return IsValidEntity(Entity) && !Set<FEnemyAttackState>().Contains(Entity);
+    }
+
+    // Enter Attacking. Timer fires when the attack montage has finished.
+    void BeginAttack(FEnemyEntity Entity, FSlotMapHandle Timer)
+    {
+        Set<FEnemyAttackState>().Add(Entity, { EEnemyCombatState::Attacking, Timer });
+    }
+
+    // Attack finished: enter Cooldown until Timer fires.
+    void BeginCooldown(FEnemyEntity Entity, FSlotMapHandle Timer)
+    {
+        if (FEnemyAttackState* Attack = Set<FEnemyAttackState>().Find(Entity))
+        {
+            Attack->State = EEnemyCombatState::Cooldown;
+            Attack->Timer = Timer;
+        }
+    }
+
+    // Drop straight back to Ready (cooldown over, or enemy returned to the pool).
+    // Returns the timer that was pending, so the caller can cancel it.
+    FSlotMapHandle ForceReady(FEnemyEntity Entity)
+    {
+        FSlotMapHandle PendingTimer;
+        if (const FEnemyAttackState* Attack = Set<FEnemyAttackState>().Find(Entity))
+        {
+            PendingTimer = Attack->Timer;
+            Set<FEnemyAttackState>().Remove(Entity);
+        }
+        return PendingTimer;
+    }
+
+private:
+    int32 NumEnemyEntities = 0;
+
+    std::tuple<
+        TComponentSet<FEnemyPosition>,
+        TComponentSet<FEnemyVelocity>,
+        TComponentSet<FEnemyHealth>,
+        TComponentSet<FEnemyAttackState>,
+        TComponentSet<FEnemyThreat>,
+        TComponentSet<FEnemyPoolState>> Sets;
+};
@@ -5,6 +5,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "FpsCharacter.h"
+#include "GameplayRandom.h"
 
 // Sets default values
 AEnemyDirector::AEnemyDirector()
@@ -16,8 +17,8 @@ AEnemyDirector::AEnemyDirector()
 void AEnemyDirector::AttemptSpawnEnemies()
 {
 	// Get lists of active and inactive enemies.
-	TArray<AActor*> pPooledEnemies = GetAllEnemiesInPool();
-	TArray<AActor*> pArenaEnemies = GetAllEnemiesInArena();
+	TFrameArray<AActor*> pPooledEnemies = GetAllEnemiesInPool();
+	TFrameArray<AActor*> pArenaEnemies = GetAllEnemiesInArena();
 	int iPooledEnemiesCount = pPooledEnemies.Num();
 	int iArenaEnemiesCount = pArenaEnemies.Num();
 
@@ -52,7 +53,7 @@ void AEnemyDirector::AttemptSpawnEnemies()
 		pEnemy->SetActorEnableCollision(false);
 		
 		// Pick a random spawn point.
-		auto spawnLocation = PSpawnLocations[FMath::RandRange(0, PSpawnLocations.Num() - 1)];
+		auto spawnLocation = PSpawnLocations[GameplayRandom::RandRange(0, PSpawnLocations.Num() - 1)];
 		auto enemyRotation = pEnemy->GetActorRotation();
 		
 		// Move enemy to arena and activate.
@@ -62,27 +63,26 @@ void AEnemyDirector::AttemptSpawnEnemies()
 	}
 }
 
+void AEnemyDirector::BuildWaveTables()
+{
+	// Growth is keyed to the wave number only, so the tables are built once from the wave 1 values.
+	m_cWaveSizeTable = WaveCurves::Bake(WaveSizeCurve, IInitialWaveSpawnCount, IMaxEnemiesInWave, IFinalGrowthWave);
+	m_cArenaCapacityTable = WaveCurves::Bake(ArenaCapacityCurve, IMaxEnemiesInArena, IMaxEnemyArenaCapacity, IWaveMaxEnemyArenaCapacityReached);
+	m_cMaxWalkSpeedTable = WaveCurves::MakeStepped(m_fGlobalMaxWalkSpeed, 50.0f, m_fGlobalFinalMaxWalkSpeed);
+	m_cMinWalkSpeedTable = WaveCurves::MakeStepped(m_fGlobalMinWalkSpeed, 15.0f, m_fGlobalFinalMinWalkSpeed);
+}
+
 int AEnemyDirector::UpdateWaveSize()
 {
-	// Calculate total enemies for the current wave using linear growth.
-	int iTotalEnemyGrowth = IMaxEnemiesInWave - IInitialWaveSpawnCount;
-	float fRateOfGrowth = (float)iTotalEnemyGrowth / IFinalGrowthWave;
-	int iNewEnemyCount = (ICurrentWave - 1) * fRateOfGrowth;
-	
-	// Ensure we don't exceed the hard cap.
-	ICurrentWaveSize = UKismetMathLibrary::Min(IMaxEnemiesInWave, (IInitialWaveSpawnCount + iNewEnemyCount)); 
-    return ICurrentWaveSize;
+	// Total enemies for the current wave (table lookup, capped at IMaxEnemiesInWave when baked).
+	ICurrentWaveSize = m_cWaveSizeTable.Get(ICurrentWave);
+	return ICurrentWaveSize;
 }
 
 int AEnemyDirector::UpdateEnemyArenaCapacity()
 {
-	// Calculate the max concurrent enemies allowed in the arena for this wave.
-    int iTotalCapacityGrowth = IMaxEnemyArenaCapacity - IMaxEnemiesInArena;
-	float fRateOfGrowth = (float)iTotalCapacityGrowth / IWaveMaxEnemyArenaCapacityReached;
-	int iNewCapacity = (ICurrentWave - 1) * fRateOfGrowth;
-	
-	// Ensure we don't exceed the hard cap.
-	IMaxEnemiesInArena = UKismetMathLibrary::Min(IMaxEnemyArenaCapacity, (IMaxEnemiesInArena + iNewCapacity));
+	// Max concurrent enemies allowed in the arena for this wave. Depends on the wave only, not on previous waves.
+	IMaxEnemiesInArena = m_cArenaCapacityTable.Get(ICurrentWave);
 	return IMaxEnemiesInArena;
 }
 
@@ -97,8 +97,8 @@ void AEnemyDirector::UpdateWaveParameters()
 	UpdateEnemyArenaCapacity();
 
 	// Increase enemy speed difficulty, clamped to maximums.
-	m_fGlobalMaxWalkSpeed = FMath::Clamp(m_fGlobalMaxWalkSpeed + 50.0f, 0, m_fGlobalFinalMaxWalkSpeed);
-	m_fGlobalMinWalkSpeed = FMath::Clamp(m_fGlobalMinWalkSpeed + 15.0f, 0, m_fGlobalFinalMinWalkSpeed);
+	m_fGlobalMaxWalkSpeed = m_cMaxWalkSpeedTable.Get(ICurrentWave);
+	m_fGlobalMinWalkSpeed = m_cMinWalkSpeedTable.Get(ICurrentWave);
 }
 
 void AEnemyDirector::NextWave()
@@ -106,7 +106,7 @@ void AEnemyDirector::NextWave()
 	UpdateWaveParameters();
 
 	// Notify listeners (UI) that the wave has changed.
-	OnWaveChanged.Broadcast(ICurrentWave);
+	NotifyWaveChanged();
 	
 	// Delay spawning of enemies to give the player a breather.
 	UWorld* pWorld = GetWorld();
@@ -139,9 +139,9 @@ void AEnemyDirector::SpawnMoreEnemies()
 	}
 }
 
-TArray<AActor*> AEnemyDirector::GetAllEnemiesInArena()
+TFrameArray<AActor*> AEnemyDirector::GetAllEnemiesInArena()
 {
-	TArray<AActor*> pEnemiesInArena = TArray<AActor*>();
+	TFrameArray<AActor*> pEnemiesInArena;
 	for (AActor* actor : PEnemies)
 	{
 		AEnemy* pEnemy = Cast<AEnemy>(actor);
@@ -154,9 +154,9 @@ TArray<AActor*> AEnemyDirector::GetAllEnemiesInArena()
     return pEnemiesInArena;
 }
 
-TArray<AActor*> AEnemyDirector::GetAllEnemiesInPool()
+TFrameArray<AActor*> AEnemyDirector::GetAllEnemiesInPool()
 {
-    TArray<AActor*> pEnemiesInPool = TArray<AActor*>();
+    TFrameArray<AActor*> pEnemiesInPool;
 	for (AActor* actor : PEnemies)
 	{
 		AEnemy* pEnemy = Cast<AEnemy>(actor);
@@ -175,7 +175,7 @@ void AEnemyDirector::ModifyWaveSpeeds()
 	for (int i = 0; i < PEnemies.Num(); ++i)
 	{
 		AEnemy* pEnemy = Cast<AEnemy>(PEnemies[i]);
-		float maxWalkSpeed = FMath::RandRange(m_fGlobalMinWalkSpeed, m_fGlobalMaxWalkSpeed);
+		float maxWalkSpeed = GameplayRandom::FRandRange(m_fGlobalMinWalkSpeed, m_fGlobalMaxWalkSpeed);
 		
 		// Add the specific enemy's base speed to the global modifier.
 		float finalSpeed = maxWalkSpeed + pEnemy->GetBaseSpeed();
@@ -183,9 +183,22 @@ void AEnemyDirector::ModifyWaveSpeeds()
 	}
 }
 
-void AEnemyDirector::ConfirmEnemyKilled()
+void AEnemyDirector::ConfirmEnemyKilled(AEnemy* pEnemy)
 {
-	IWaveKills++;
+	m_PendingPoolReturns.AddUnique(pEnemy);
+}
+
+void AEnemyDirector::ProcessPoolReturns()
+{
+	if (m_PendingPoolReturns.Num() == 0)
+		return;
+
+	for (AEnemy* pEnemy : m_PendingPoolReturns)
+	{
+		pEnemy->ReturnToPool();
+	}
+	IWaveKills += m_PendingPoolReturns.Num();
+	m_PendingPoolReturns.Reset();
 
 	// Check if the wave is complete.
 	if (IWaveKills >= ICurrentWaveSize)
@@ -199,16 +212,45 @@ void AEnemyDirector::RefreshUI()
 	OnWaveChanged.Broadcast(ICurrentWave);
 }
 
+void AEnemyDirector::NotifyWaveChanged()
+{
+	UUIEventBus* pBus = GetWorld() ? GetWorld()->GetSubsystem<UUIEventBus>() : nullptr;
+	if (pBus == nullptr)
+	{
+		OnWaveChanged.Broadcast(ICurrentWave);
+		return;
+	}
+
+	pBus->Publish(EUIChannel::Wave, ICurrentWave);
+}
+
+void AEnemyDirector::HandleUIChannelChanged(EUIChannel Channel, int32 Value, int32 SecondaryValue)
+{
+	if (Channel == EUIChannel::Wave)
+	{
+		OnWaveChanged.Broadcast(Value);
+	}
+}
+
 // Called when the game starts or when spawned
 void AEnemyDirector::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Forward coalesced wave updates from the UI event bus.
+	if (UUIEventBus* pBus = GetWorld()->GetSubsystem<UUIEventBus>())
+	{
+		pBus->OnChannelChanged.AddDynamic(this, &AEnemyDirector::HandleUIChannelChanged);
+	}
 	
 	// Get all pre-placed instances of enemy actors and store in the master list.
 	// This assumes enemies are placed in the level or pooled beforehand.
 	auto world = GetWorld();
 	UGameplayStatics::GetAllActorsOfClass(world, AEnemy::StaticClass(), PEnemies);
 
+	// Bake the difficulty curves before the first wave modifies the properties.
+	BuildWaveTables();
+
 	// Start the first wave.
 	NextWave();
 }
@@ -238,6 +280,9 @@ void AEnemyDirector::ClearCurrentTimer()
 void AEnemyDirector::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	// Recycle enemies whose death montage finished since the last tick.
+	ProcessPoolReturns();
 	
 	// Continuously attempt to spawn enemies during active wave play.
 	if (!m_bWaveIntermission)
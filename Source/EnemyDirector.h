@@ -4,8 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "WaveCurveTable.h"
+#include "FrameAllocator.h"
+#include "UIEventBus.h"
 #include "EnemyDirector.generated.h"
 
+class AEnemy;
+
 // Multicast delegate to broadcast when the wave number changes (e.g., for UI updates).
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWaveChanged, int, iWave);
 
@@ -25,6 +30,7 @@ public:
 	// Event delegate functions
 
 	// Event triggered when the wave index updates.
+	// Routed through UUIEventBus, so it fires at most once per flush with the latest wave.
 	UPROPERTY(BlueprintAssignable)
 	FOnWaveChanged OnWaveChanged;
 
@@ -62,9 +68,18 @@ public:
 	int IWaveMaxEnemyArenaCapacityReached = 22;
 
 	// The current limit on concurrent enemies in the arena (scales up as waves progress).
+	// The value set in the editor is the wave 1 capacity.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
 	int IMaxEnemiesInArena = 5;
 
+	// Shape of the wave size growth from IInitialWaveSpawnCount to IMaxEnemiesInWave.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
+	FWaveCurveSettings WaveSizeCurve;
+
+	// Shape of the arena capacity growth from the initial IMaxEnemiesInArena to IMaxEnemyArenaCapacity.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
+	FWaveCurveSettings ArenaCapacityCurve;
+
 	// Delay time between waves.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
 	float FSecondsBeforeWaveStarts = 4.0f;
@@ -73,9 +88,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
 	float FSecondsBeforeWaveEnds = 4.0f;
 
-	// Callback function bound to enemy death events.
+	// Callback function bound to enemy death events. Queues the enemy for the next pool return batch.
 	UFUNCTION()
-	void ConfirmEnemyKilled();
+	void ConfirmEnemyKilled(AEnemy* pEnemy);
 
 	// Force an update on the UI elements.
 	UFUNCTION(BlueprintCallable, Category="HUD")
@@ -83,9 +98,9 @@ public:
 
 	// Main logic to check if enemies should be moved from the pool to the arena.
 	void AttemptSpawnEnemies();
-	// Calculates and updates the total number of enemies for the current wave.
+	// Looks up and updates the total number of enemies for the current wave.
 	int UpdateWaveSize();
-	// Calculates and updates the concurrent enemy limit for the current wave.
+	// Looks up and updates the concurrent enemy limit for the current wave.
 	int UpdateEnemyArenaCapacity();
 	// Updates difficulty parameters (speeds, counts) for the new wave.
 	void UpdateWaveParameters();
@@ -96,10 +111,10 @@ public:
 	// Helper to trigger spawn attempts.
 	void SpawnMoreEnemies();
 	
-	// Helper: Get all active enemies currently fighting.
-	TArray<AActor*> GetAllEnemiesInArena();
-	// Helper: Get all inactive enemies waiting in the object pool.
-	TArray<AActor*> GetAllEnemiesInPool();
+	// Helper: Get all active enemies currently fighting (frame-arena result, valid until the end of the next frame).
+	TFrameArray<AActor*> GetAllEnemiesInArena();
+	// Helper: Get all inactive enemies waiting in the object pool (frame-arena result).
+	TFrameArray<AActor*> GetAllEnemiesInPool();
 	
 	// Updates enemy movement speeds based on current difficulty scaling.
 	void ModifyWaveSpeeds();
@@ -143,6 +158,28 @@ private:
 	// Flag indicating if we are in the break between waves.
 	bool m_bWaveIntermission;
 
+	// Per-wave difficulty tables, baked once at BeginPlay from the designer settings.
+	WaveCurves::TWaveCurve<int32> m_cWaveSizeTable;
+	WaveCurves::TWaveCurve<int32> m_cArenaCapacityTable;
+	WaveCurves::TWaveCurve<float> m_cMaxWalkSpeedTable;
+	WaveCurves::TWaveCurve<float> m_cMinWalkSpeedTable;
+
+	// Bakes the wave tables from the current (wave 1) property values.
+	void BuildWaveTables();
+
+	// Enemies whose death montage finished, returned to the pool together on the next tick.
+	TArray<AEnemy*> m_PendingPoolReturns;
+
 	// Clears the active timer safely.
 	void ClearCurrentTimer();
+
+	// Publishes the wave to the UI event bus (or broadcasts directly if there is none).
+	void NotifyWaveChanged();
+
+	// Forwards flushed Wave channel updates to OnWaveChanged.
+	UFUNCTION()
+	void HandleUIChannelChanged(EUIChannel Channel, int32 Value, int32 SecondaryValue);
+
+	// Returns the queued enemies to the pool and counts their kills in one pass.
+	void ProcessPoolReturns();
 };
\ No newline at end of file
@@ -6,32 +6,46 @@
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "FpsCharacter.h"
+#include "GameplayRandom.h"
+#include "PlayerCache.h"
+#include "EnemyKeys.h"
+#include "BrainComponent.h"
+#include "AIController.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+#include "GameplayDataSubsystem.h"
 
 AEnemyDirectorEnhanced::AEnemyDirectorEnhanced()
 {
     PrimaryActorTick.bCanEverTick = true;
     
     m_bWaveIntermission = false;
-    NextEnemyID = 0;
     QuadtreeQueryTime = 0.0f;
     SortTime = 0.0f;
     SearchTime = 0.0f;
     TotalQueries = 0;
-
-    // Initialize HashMap with capacity for expected enemies to minimize collisions/resizing.
-    EnemyRegistry = CustomHashMap<int32, AActor*>(128);
 }
 
 void AEnemyDirectorEnhanced::BeginPlay()
 {
     Super::BeginPlay();
+
+    // Forward coalesced wave updates from the UI event bus.
+    if (UUIEventBus* pBus = GetWorld()->GetSubsystem<UUIEventBus>())
+    {
+        pBus->OnChannelChanged.AddDynamic(this, &AEnemyDirectorEnhanced::HandleUIChannelChanged);
+    }
     
     // Get all instances of enemy actors in the level.
     auto world = GetWorld();
     UGameplayStatics::GetAllActorsOfClass(world, AEnemy::StaticClass(), PEnemies);
 
-    // Build enemy registry with unique IDs - O(n) operation.
+    // Build enemy handles and the pool list - O(n) operation.
     RebuildEnemyRegistry();
+    RebuildComponents();
+
+    // Bake the difficulty curves before the first wave modifies the properties.
+    BuildWaveTables();
 
     // Initialize spatial partition (Quadtree).
     // Assuming a 10000x10000 unit arena centered at origin.
@@ -40,83 +54,753 @@ void AEnemyDirectorEnhanced::BeginPlay()
     FVector2D ArenaHalfSize(5000.0f, 5000.0f);
     SpatialPartition = MakeShared<FQuadtree>(FQuadtreeBounds(ArenaCenter, ArenaHalfSize));
 
+    // Hook the frame arena's end-of-frame reset from the game thread before any job can touch it.
+    FFrameArena::Get();
+
+    // Worker pool and the per-frame job graph for the director passes.
+    JobSystem = MakeUnique<FJobSystem>(IJobWorkerThreads);
+    BuildFrameJobs();
+
     NextWave();
 }
 
+void AEnemyDirectorEnhanced::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Jobs capture this director; join the workers before it goes away.
+    FrameJobs.Reset();
+    JobSystem.Reset();
+
+    // Unlink the enemies while they are still alive.
+    PooledEnemies.Clear();
+    DirectorTimers.Clear();
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void AEnemyDirectorEnhanced::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
+
+#if !UE_BUILD_SHIPPING
+    const uint64 HeapCallsBefore = FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls;
+#endif
+
+    // Recycle enemies whose death montage finished since the last tick.
+    ProcessPoolReturns();
+
+    // Frame boundary: every system below reads the components, not the actors.
+    SyncComponentsFromActors();
+
+    // Wave delays and attack/cooldown timers (the latter keep running through intermissions).
+    AdvanceTimers(DeltaTime);
+
+    // Switch between behavior trees and the batched brain (also picks up changes made at runtime).
+    if (BUseBatchedBrain != BrainTreesStopped)
+    {
+        ApplyBrainMode();
+    }
+    UpdateBatchedBrain();
     
     if (!m_bWaveIntermission)
     {
-        // Update spatial partition every frame for efficient queries.
+        // Update spatial partition and threat queue every frame for efficient queries.
         // Enemies move, so the tree structure must be refreshed.
-        UpdateSpatialPartition();
+        RunFrameJobs();
         
         // Handle spawning logic.
         AttemptSpawnEnemies();
     }
+
+#if !UE_BUILD_SHIPPING
+    TickHeapAllocations = static_cast<int32>(FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls - HeapCallsBefore);
+#endif
 }
 
 void AEnemyDirectorEnhanced::RebuildEnemyRegistry()
 {
     /*
-     * Algorithm: HashMap Construction
+     * Algorithm: Generational Slot Map + Intrusive Free List
      * Time Complexity: O(n) where n = number of enemies
-     * Space Complexity: O(n)
-     * * Purpose: Build fast O(1) lookup table for enemies by ID
+     * Space Complexity: O(n) slots, O(1) for the list (links live in the enemies)
+     * * Purpose: Stable O(1) enemy handles whose staleness is one generation compare,
+     *   and O(1) spawn/return without rescanning PEnemies.
      */
     
-    EnemyRegistry.Clear();
-    NextEnemyID = 0;
+    // Clear keeps the generations, so handles from a previous registry stay stale.
+    EnemySlots.Clear();
+    PooledEnemies.Clear();
 
+    for (int32 i = 0; i < PEnemies.Num(); ++i)
+    {
+        // Slots are reused in ascending order after Clear, so the slot index matches the entity.
+        const FSlotMapHandle Handle = EnemySlots.Insert(PEnemies[i]);
+        check(Handle.Index == i);
+
+        AEnemy* pEnemy = Cast<AEnemy>(PEnemies[i]);
+        if (!pEnemy->BInArena)
+        {
+            PooledEnemies.PushBack(pEnemy);
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[Slot Map] Enemy handles built: %d enemies, %d pooled"),
+        EnemySlots.GetSize(), PooledEnemies.Num());
+}
+
+void AEnemyDirectorEnhanced::RebuildComponents()
+{
+    Components.Reset(PEnemies.Num());
+    BrainBatch.Reset(PEnemies.Num());
+
+    for (FEnemyEntity Entity = 0; Entity < PEnemies.Num(); ++Entity)
+    {
+        AEnemy* pEnemy = Cast<AEnemy>(PEnemies[Entity]);
+        pEnemy->SetCombatSlot(this, Entity);
+
+        // Every enemy starts pooled; SyncComponentsFromActors adds the arena components on entry.
+        Components.Set<FEnemyPoolState>().Add(Entity);
+        Components.Set<FEnemyHealth>().Add(Entity, { pEnemy->GetHealth() });
+
+        // Attack range never changes at runtime (cooked stats land in AEnemy::PostInitializeComponents,
+        // before any BeginPlay), so the brain reads it once here.
+        BrainBatch.AttackRangesSquared[Entity] = FMath::Square(pEnemy->GetAttackRange());
+    }
+
+    SyncComponentsFromActors();
+
+    UE_LOG(LogTemp, Log, TEXT("[Components] Component store built: %d entities, %d in arena"),
+        Components.NumEntities(), Components.Set<FEnemyPosition>().Num());
+}
+
+void AEnemyDirectorEnhanced::SyncComponentsFromActors()
+{
+    /*
+     * Algorithm: Frame Boundary Sync
+     * Time Complexity: O(n) where n = number of enemies
+     * * Purpose: Actors are presentation proxies; gameplay systems iterate the packed component arrays.
+     *   Movement and damage still run on the actors, so their results are copied in once per frame.
+     */
+
+    TComponentSet<FEnemyPoolState>& PoolStates = Components.Set<FEnemyPoolState>();
+    TComponentSet<FEnemyPosition>& Positions = Components.Set<FEnemyPosition>();
+    TComponentSet<FEnemyVelocity>& Velocities = Components.Set<FEnemyVelocity>();
+    TComponentSet<FEnemyThreat>& Threats = Components.Set<FEnemyThreat>();
+
+    for (int32 i = 0; i < PoolStates.Num(); ++i)
+    {
+        const FEnemyEntity Entity = PoolStates.GetEntity(i);
+        FEnemyPoolState& Pool = PoolStates.GetAt(i);
+        AEnemy* pEnemy = Cast<AEnemy>(PEnemies[Entity]);
+
+        const EEnemyPoolState NewState = pEnemy->BInArena ? EEnemyPoolState::InArena : EEnemyPoolState::Pooled;
+        if (NewState != Pool.State)
+        {
+            Pool.State = NewState;
+            if (NewState == EEnemyPoolState::InArena)
+            {
+                Positions.Add(Entity);
+                Velocities.Add(Entity);
+                Threats.Add(Entity);
+            }
+            else
+            {
+                Positions.Remove(Entity);
+                Velocities.Remove(Entity);
+                Threats.Remove(Entity);
+            }
+        }
+
+        Components.Set<FEnemyHealth>().Get(Entity).Health = pEnemy->GetHealth();
+        if (NewState == EEnemyPoolState::InArena)
+        {
+            Positions.Get(Entity).Location = pEnemy->GetActorLocation();
+            Velocities.Get(Entity).Velocity = pEnemy->GetVelocity();
+        }
+    }
+
+    FramePlayerLocation = FVector::ZeroVector;
+    GetWorld()->GetSubsystem<UPlayerCache>()->GetPlayerLocation(FramePlayerLocation);
+}
+
+void AEnemyDirectorEnhanced::AdvanceTimers(float DeltaTime)
+{
+    /*
+     * Algorithm: Hierarchical Timer Wheel
+     * Time Complexity: O(ticks + e) where e = timers that expired (enemies still waiting are never visited)
+     * * Purpose: Replace per-enemy montage polling in the behavior tree and per-frame countdowns with
+     *   scheduled expiries. Only enemies that actually became Ready are woken.
+     */
+
+    CombatReadyScratch.Reset();
+    DirectorTimers.Advance(DeltaTime, [this](const FDirectorTimer& Timer)
+    {
+        HandleTimer(Timer);
+    });
+
+    for (FEnemyEntity Entity : CombatReadyScratch)
+    {
+        // Finishes the enemy's waiting BTT_Attack (no-op if the tree is elsewhere).
+        FAIMessage::Send(Cast<APawn>(PEnemies[Entity]), FAIMessage(EnemyKeys::CombatReady, this, true));
+    }
+}
+
+void AEnemyDirectorEnhanced::HandleTimer(const FDirectorTimer& Timer)
+{
+    switch (Timer.Type)
+    {
+    case EDirectorTimer::WaveStart:
+        WaveTimer = FSlotMapHandle();
+        NextWaveDelayedCallback();
+        break;
+
+    case EDirectorTimer::WaveEnd:
+        WaveTimer = FSlotMapHandle();
+        EndWaveDelayedCallback();
+        break;
+
+    case EDirectorTimer::AttackFinished:
+        // Scheduled from the tick the attack ended, so frame rate doesn't stretch the cooldown.
+        if (FAttackCooldownSeconds > 0.0f)
+        {
+            Components.BeginCooldown(Timer.Entity,
+                DirectorTimers.Schedule(FAttackCooldownSeconds, { EDirectorTimer::CooldownFinished, Timer.Entity }));
+            break;
+        }
+        // A zero cooldown skips straight to Ready.
+        Components.ForceReady(Timer.Entity);
+        CombatReadyScratch.Add(Timer.Entity);
+        break;
+
+    case EDirectorTimer::CooldownFinished:
+        Components.ForceReady(Timer.Entity);
+        CombatReadyScratch.Add(Timer.Entity);
+        break;
+    }
+}
+
+void AEnemyDirectorEnhanced::ApplyBrainMode()
+{
     for (AActor* Actor : PEnemies)
     {
-        // Insert enemy into custom hash map.
-        EnemyRegistry.Insert(NextEnemyID, Actor);
-        NextEnemyID++;
+        AAIController* pController = Cast<AAIController>(Cast<APawn>(Actor)->GetController());
+        UBrainComponent* pBrain = pController ? pController->GetBrainComponent() : nullptr;
+        if (pBrain == nullptr)
+            continue;
+
+        // Never let both paths drive the same enemy.
+        if (BUseBatchedBrain)
+        {
+            pBrain->StopLogic(TEXT("Batched brain enabled"));
+        }
+        else
+        {
+            pBrain->RestartLogic();
+        }
+    }
+
+    // Re-issue move orders from scratch on the next batched pass.
+    for (int32 i = 0; i < BrainBatch.Num(); ++i)
+    {
+        BrainBatch.ClearMoveTarget(i);
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[Data Structure] Enemy Registry built: %d enemies, Load Factor: %.2f"),
-        EnemyRegistry.GetSize(), EnemyRegistry.GetLoadFactor());
+    BrainTreesStopped = BUseBatchedBrain;
+    UE_LOG(LogTemp, Log, TEXT("[Batched Brain] %s for %d enemies"),
+        BUseBatchedBrain ? TEXT("Enabled") : TEXT("Disabled"), PEnemies.Num());
 }
 
-void AEnemyDirectorEnhanced::UpdateSpatialPartition()
+void AEnemyDirectorEnhanced::GatherBrainInputs()
+{
+    FMemory::Memzero(BrainBatch.Active.GetData(), BrainBatch.Active.Num());
+
+    Components.Each<FEnemyPosition>([this](FEnemyEntity Entity, const FEnemyPosition& Position)
+    {
+        BrainBatch.Active[Entity] = 1;
+        BrainBatch.Locations[Entity] = Position.Location;
+        BrainBatch.CombatReady[Entity] = Components.IsCombatReady(Entity) ? 1 : 0;
+    });
+
+    BrainActiveEnemies = Components.Set<FEnemyPosition>().Num();
+}
+
+void AEnemyDirectorEnhanced::UpdateBatchedBrain()
 {
     /*
-     * Algorithm: Quadtree Reconstruction
-     * Time Complexity: O(n log n) where n = number of enemies
-     * Space Complexity: O(n)
-     * * Purpose: Rebuild spatial partition for efficient range queries
+     * Algorithm: Data-Oriented Batch Evaluation
+     * Time Complexity: O(n) gather/apply, O(n / workers) evaluate
+     * * Purpose: One decision pass for every enemy instead of n behavior tree ticks.
      */
-    
+
+    BrainMoveCommands = 0;
+    BrainAttackCommands = 0;
+    if (!BUseBatchedBrain)
+        return;
+
+    FVector PlayerLocation;
+    if (!GetWorld()->GetSubsystem<UPlayerCache>()->GetPlayerLocation(PlayerLocation))
+        return;
+
     double StartTime = FPlatformTime::Seconds();
 
-    // Clear previous frame's data.
-    SpatialPartition->Clear();
+    GatherBrainInputs();
+    BrainBatch.Evaluate(*JobSystem, PlayerLocation, FMath::Square(FBrainRepathDistance), 32);
 
-    // Re-insert all active arena enemies into the Quadtree.
+    // Commands touch actors and navigation, so they are issued back on the game thread.
+    for (int32 i = 0; i < BrainBatch.Num(); ++i)
+    {
+        switch (BrainBatch.Commands[i])
+        {
+        case EEnemyBrainCommand::Move:
+            if (AAIController* pController = Cast<AAIController>(Cast<APawn>(PEnemies[i])->GetController()))
+            {
+                pController->MoveToLocation(BrainBatch.LastMoveTargets[i]);
+                BrainMoveCommands++;
+            }
+            break;
+
+        case EEnemyBrainCommand::Attack:
+            if (TryBeginAttack(i))
+            {
+                BrainAttackCommands++;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    BrainTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void AEnemyDirectorEnhanced::GetBrainStats(float& OutBrainTimeMs, float& OutMicrosecondsPerEnemy,
+                                           int32& OutMoveCommands, int32& OutAttackCommands) const
+{
+    OutBrainTimeMs = BrainTimeMs;
+    OutMicrosecondsPerEnemy = BrainActiveEnemies > 0 ? BrainTimeMs * 1000.0f / BrainActiveEnemies : 0.0f;
+    OutMoveCommands = BrainMoveCommands;
+    OutAttackCommands = BrainAttackCommands;
+}
+
+void AEnemyDirectorEnhanced::BenchmarkBrainCost(int32 Frames, float& OutTreeMicrosecondsPerEnemy,
+                                                float& OutBatchedMicrosecondsPerEnemy)
+{
+    Frames = FMath::Max(1, Frames);
+    OutTreeMicrosecondsPerEnemy = 0.0f;
+    OutBatchedMicrosecondsPerEnemy = 0.0f;
+
+    FVector PlayerLocation;
+    if (!GetWorld()->GetSubsystem<UPlayerCache>()->GetPlayerLocation(PlayerLocation))
+        return;
+
+    const float FrameDelta = 1.0f / 60.0f;
+
+    // --- Behavior tree path: tick the running trees of the enemies in the arena. ---
+    TArray<UBrainComponent*> Trees;
     for (AActor* Actor : PEnemies)
     {
-        AEnemy* Enemy = Cast<AEnemy>(Actor);
-        if (Enemy && Enemy->BInArena)
+        AEnemy* pEnemy = Cast<AEnemy>(Actor);
+        AAIController* pController = Cast<AAIController>(pEnemy->GetController());
+        UBrainComponent* pBrain = pController ? pController->GetBrainComponent() : nullptr;
+        if (pEnemy->BInArena && pBrain != nullptr && pBrain->IsRunning())
         {
-            FVector Location = Enemy->GetActorLocation();
-            FVector2D Location2D(Location.X, Location.Y);
-            FQuadtreePoint Point(Location2D, Actor);
-            SpatialPartition->Insert(Point);
+            Trees.Add(pBrain);
         }
     }
 
-    double EndTime = FPlatformTime::Seconds();
-    QuadtreeQueryTime = static_cast<float>(EndTime - StartTime);
+    if (Trees.Num() > 0)
+    {
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Frame = 0; Frame < Frames; ++Frame)
+        {
+            for (UBrainComponent* pBrain : Trees)
+            {
+                pBrain->TickComponent(FrameDelta, LEVELTICK_All, nullptr);
+            }
+        }
+        double Elapsed = FPlatformTime::Seconds() - StartTime;
+        OutTreeMicrosecondsPerEnemy = static_cast<float>(Elapsed * 1000000.0 / (Frames * Trees.Num()));
+    }
+
+    // --- Batched path: gather + evaluate (commands are only issued on repath, so they are left out). ---
+    // Move targets are persistent state, so keep the live ones intact.
+    TArray<FVector> SavedTargets = BrainBatch.LastMoveTargets;
+    TArray<uint8> SavedHasTarget = BrainBatch.HasMoveTarget;
+
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Frame = 0; Frame < Frames; ++Frame)
+    {
+        GatherBrainInputs();
+        BrainBatch.Evaluate(*JobSystem, PlayerLocation, FMath::Square(FBrainRepathDistance), 32);
+    }
+    double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+    BrainBatch.LastMoveTargets = MoveTemp(SavedTargets);
+    BrainBatch.HasMoveTarget = MoveTemp(SavedHasTarget);
+
+    if (BrainActiveEnemies > 0)
+    {
+        OutBatchedMicrosecondsPerEnemy = static_cast<float>(Elapsed * 1000000.0 / (Frames * BrainActiveEnemies));
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[Batched Brain] %d frames: behavior tree %.3f us/enemy (%d trees), batched %.3f us/enemy (%d enemies)"),
+        Frames, OutTreeMicrosecondsPerEnemy, Trees.Num(), OutBatchedMicrosecondsPerEnemy, BrainActiveEnemies);
+}
+
+bool AEnemyDirectorEnhanced::IsCombatReady(int32 CombatIndex) const
+{
+    return Components.IsCombatReady(CombatIndex);
+}
+
+bool AEnemyDirectorEnhanced::TryBeginAttack(int32 CombatIndex)
+{
+    if (!IsCombatReady(CombatIndex))
+        return false;
+
+    AEnemy* pEnemy = Cast<AEnemy>(PEnemies[CombatIndex]);
+    if (!pEnemy->Attack())
+        return false;
+
+    Components.BeginAttack(CombatIndex,
+        DirectorTimers.Schedule(pEnemy->GetAttackDuration(), { EDirectorTimer::AttackFinished, CombatIndex }));
+    return true;
+}
+
+void AEnemyDirectorEnhanced::BuildFrameJobs()
+{
+    /*
+     * Job Graph (per frame):
+     *   SpatialRebuild ----------------------------\
+     *   DistancePass (ParallelFor) -> ThreatScoring -> done
+     * * The Quadtree and priority queue are not thread-safe, so each is owned by exactly one job;
+     *   the two chains only share read-only frame inputs and run concurrently.
+     */
+    FrameJobs.Reset();
+
+    FrameJobs.Add(TEXT("SpatialRebuild"), [this]()
+    {
+        UpdateSpatialPartition();
+    });
+
+    const FJobList::FHandle DistancePass = FrameJobs.Add(TEXT("DistancePass"), [this]()
+    {
+        // Threat is looked up by entity: the two sets are not guaranteed to share a dense order.
+        TComponentSet<FEnemyPosition>& Positions = Components.Set<FEnemyPosition>();
+        TComponentSet<FEnemyThreat>& Threats = Components.Set<FEnemyThreat>();
+        JobSystem->ParallelFor(TEXT("DistancePass"), Positions.Num(), 64, [&Positions, &Threats, this](int32 i)
+        {
+            Threats.Get(Positions.GetEntity(i)).Distance = FVector::Dist(Positions.GetAt(i).Location, FramePlayerLocation);
+        });
+    });
+
+    FrameJobs.Add(TEXT("ThreatScoring"), [this]()
+    {
+        UpdateEnemyPriorities(FramePlayerLocation);
+    }, { DistancePass });
+}
+
+void AEnemyDirectorEnhanced::RunFrameJobs()
+{
+    FrameJobs.Run(*JobSystem);
 
     // Debug log every 60 frames (~1 sec) to monitor overhead.
     if (GetWorld()->GetTimeSeconds() > 1.0f && FMath::Fmod(GetWorld()->GetTimeSeconds(), 1.0f) < 0.016f)
     {
         UE_LOG(LogTemp, Log, TEXT("[Quadtree] Updated spatial partition: %d enemies, Time: %.4f ms"),
             SpatialPartition->GetSize(), QuadtreeQueryTime * 1000.0f);
+
+        const FFrameArena::FStats ArenaStats = FFrameArena::Get().GetLastFrameStats();
+        UE_LOG(LogTemp, Log, TEXT("[Frame Arena] %d allocations, %.1f / %.1f KB, %d heap fallbacks, %d heap allocations in director Tick"),
+            ArenaStats.Allocations, ArenaStats.Bytes / 1024.0f, ArenaStats.Capacity / 1024.0f,
+            ArenaStats.HeapFallbacks, TickHeapAllocations);
+    }
+
+    if (TraceFramesLeft > 0 && --TraceFramesLeft == 0)
+    {
+        TArray<FJobTraceEvent> Events;
+        TArray<float> Utilization;
+        JobSystem->EndTrace(Events, Utilization);
+
+        const FString Path = FPaths::ProfilingDir() / FString::Printf(TEXT("JobTrace_%s.json"), *FDateTime::Now().ToString());
+        const bool bSaved = FJobSystem::SaveChromeTrace(Path, Events, TraceOriginSeconds);
+        UE_LOG(LogTemp, Log, TEXT("[Job System] Trace: %d tasks, %s %s"),
+            Events.Num(), bSaved ? TEXT("written to") : TEXT("FAILED to write"), *Path);
+
+        for (int32 Slot = 0; Slot < Utilization.Num(); ++Slot)
+        {
+            const bool bExternal = Slot == Utilization.Num() - 1;
+            UE_LOG(LogTemp, Log, TEXT("[Job System] %s %d: %.1f%% busy"),
+                bExternal ? TEXT("Game thread slot") : TEXT("Worker"), Slot, Utilization[Slot] * 100.0f);
+        }
+    }
+}
+
+void AEnemyDirectorEnhanced::CaptureJobTrace(int32 Frames)
+{
+    if (!JobSystem.IsValid())
+        return;
+
+    TraceFramesLeft = FMath::Max(1, Frames);
+    TraceOriginSeconds = FPlatformTime::Seconds();
+    JobSystem->BeginTrace();
+}
+
+void AEnemyDirectorEnhanced::BenchmarkJobScaling(int32 Frames, int32 SyntheticEnemies)
+{
+    /*
+     * Core Scaling: the same job list is run with 0 workers (game thread only) and then
+     * 1, 2, 4 ... workers up to one per core minus the game thread.
+     */
+    Frames = FMath::Max(1, Frames);
+
+    SyncComponentsFromActors();
+
+    // Synthetic entities get a throwaway store; the live components are restored afterwards.
+    FEnemyComponentStore LiveComponents;
+    if (SyntheticEnemies > 0)
+    {
+        LiveComponents = MoveTemp(Components);
+        Components.Reset(SyntheticEnemies);
+
+        // Fixed seed, and not GameplayRandom, so benchmarking never perturbs the gameplay stream.
+        FRandomStream Stream(1234);
+        for (FEnemyEntity Entity = 0; Entity < SyntheticEnemies; ++Entity)
+        {
+            Components.Set<FEnemyPoolState>().Add(Entity, { EEnemyPoolState::InArena });
+            Components.Set<FEnemyPosition>().Add(Entity, { FVector(Stream.FRandRange(-4900.0f, 4900.0f), Stream.FRandRange(-4900.0f, 4900.0f), 0.0f) });
+            Components.Set<FEnemyThreat>().Add(Entity);
+        }
+    }
+
+    TArray<int32> WorkerCounts = { 0 };
+    const int32 MaxWorkers = FMath::Clamp(FPlatformMisc::NumberOfCores() - 1, 0, 8);
+    for (int32 Workers = 1; Workers < MaxWorkers; Workers *= 2)
+    {
+        WorkerCounts.Add(Workers);
+    }
+    if (MaxWorkers > 0)
+    {
+        WorkerCounts.Add(MaxWorkers);
+    }
+
+    TUniquePtr<FJobSystem> LiveJobSystem = MoveTemp(JobSystem);
+    double BaselineMs = 0.0;
+
+    for (int32 Workers : WorkerCounts)
+    {
+        JobSystem = MakeUnique<FJobSystem>(Workers);
+        FrameJobs.Run(*JobSystem); // Warm-up.
+
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Frame = 0; Frame < Frames; ++Frame)
+        {
+            FrameJobs.Run(*JobSystem);
+        }
+        double FrameMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / Frames;
+
+        if (Workers == 0)
+        {
+            BaselineMs = FrameMs;
+        }
+        UE_LOG(LogTemp, Log, TEXT("[Job System] %d points, %d workers: %.4f ms/frame (%.2fx)"),
+            Components.Set<FEnemyPosition>().Num(), Workers, FrameMs, FrameMs > 0.0 ? BaselineMs / FrameMs : 0.0);
+    }
+
+    // Restore the live pool and components, then rebuild the real spatial partition and threat queue.
+    JobSystem = MoveTemp(LiveJobSystem);
+    if (SyntheticEnemies > 0)
+    {
+        Components = MoveTemp(LiveComponents);
+    }
+    FrameJobs.Run(*JobSystem);
+}
+
+namespace
+{
+    // Heap allocations made so far by this process (-1 when malloc stats are compiled out).
+    int64 GetHeapAllocationCount()
+    {
+#if !UE_BUILD_SHIPPING
+        return static_cast<int64>(FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls);
+#else
+        return -1;
+#endif
     }
+
+    // Runs Body Iterations times and returns ns per iteration and heap allocations per iteration.
+    template<typename BodyType>
+    void MeasureContainer(int32 Iterations, BodyType&& Body, double& OutNanoseconds, double& OutAllocations)
+    {
+        const int64 AllocationsBefore = GetHeapAllocationCount();
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            Body(i);
+        }
+        OutNanoseconds = (FPlatformTime::Seconds() - StartTime) * 1000000000.0 / Iterations;
+        OutAllocations = AllocationsBefore < 0 ? -1.0 : static_cast<double>(GetHeapAllocationCount() - AllocationsBefore) / Iterations;
+    }
+}
+
+void AEnemyDirectorEnhanced::BenchmarkSmallVectors(int32 Iterations)
+{
+    /*
+     * Workloads (shaped like the real hot paths):
+     * - Leaf lists: 1..4 points per list, as in a Quadtree leaf.
+     * - Neighbor lists: 8 pointers per list, as in A* GetNeighbors.
+     * Counts include other threads' allocations made while a loop runs, so run it on an idle frame.
+     */
+    Iterations = FMath::Max(1, Iterations);
+    const FQuadtreePoint Point(FVector2D(1.0f, 2.0f), this);
+    int64 Checksum = 0; // Keeps the loops observable so they are not optimized away.
+
+    double LeafArrayNs, LeafArrayAllocs, LeafSmallNs, LeafSmallAllocs;
+    MeasureContainer(Iterations, [&](int32 i)
+    {
+        TArray<FQuadtreePoint> Leaf;
+        for (int32 n = 0; n <= (i & 3); ++n)
+        {
+            Leaf.Add(Point);
+        }
+        Checksum += Leaf.Num();
+    }, LeafArrayNs, LeafArrayAllocs);
+    MeasureContainer(Iterations, [&](int32 i)
+    {
+        CustomSmallVector<FQuadtreePoint, 4> Leaf;
+        for (int32 n = 0; n <= (i & 3); ++n)
+        {
+            Leaf.Add(Point);
+        }
+        Checksum += Leaf.Num();
+    }, LeafSmallNs, LeafSmallAllocs);
+
+    double NeighborArrayNs, NeighborArrayAllocs, NeighborSmallNs, NeighborSmallAllocs;
+    MeasureContainer(Iterations, [&](int32)
+    {
+        TArray<AActor*> Neighbors;
+        for (int32 n = 0; n < 8; ++n)
+        {
+            Neighbors.Add(this);
+        }
+        Checksum += Neighbors.Num();
+    }, NeighborArrayNs, NeighborArrayAllocs);
+    MeasureContainer(Iterations, [&](int32)
+    {
+        CustomSmallVector<AActor*, 8> Neighbors;
+        for (int32 n = 0; n < 8; ++n)
+        {
+            Neighbors.Add(this);
+        }
+        Checksum += Neighbors.Num();
+    }, NeighborSmallNs, NeighborSmallAllocs);
+
+    UE_LOG(LogTemp, Log, TEXT("[Small Vector] %d iterations (checksum %lld)"), Iterations, Checksum);
+    UE_LOG(LogTemp, Log, TEXT("[Small Vector] Leaf lists: TArray %.1f ns, %.2f allocs | CustomSmallVector %.1f ns, %.2f allocs"),
+        LeafArrayNs, LeafArrayAllocs, LeafSmallNs, LeafSmallAllocs);
+    UE_LOG(LogTemp, Log, TEXT("[Small Vector] Neighbor lists: TArray %.1f ns, %.2f allocs | CustomSmallVector %.1f ns, %.2f allocs"),
+        NeighborArrayNs, NeighborArrayAllocs, NeighborSmallNs, NeighborSmallAllocs);
+}
+
+void AEnemyDirectorEnhanced::BenchmarkTimers(int32 NumTimers)
+{
+    /*
+     * Workload (shaped like cooldowns and projectile lifetimes): NumTimers one-shot timers with random
+     * delays in [0.05, 5] s, one 0.5 s advance (about a tenth of them fire), then every remaining timer is cancelled.
+     * FTimerManager only ticks once per engine frame, so both sides get a single advance.
+     */
+    NumTimers = FMath::Max(1, NumTimers);
+
+    TArray<float> Delays;
+    Delays.SetNumUninitialized(NumTimers);
+    FRandomStream Stream(1234);
+    for (float& Delay : Delays)
+    {
+        Delay = Stream.FRandRange(0.05f, 5.0f);
+    }
+    const float AdvanceSeconds = 0.5f;
+
+    // --- CustomTimerWheel ---
+    CustomTimerWheel<int32> Wheel;
+    TArray<FSlotMapHandle> WheelHandles;
+    WheelHandles.Reserve(NumTimers);
+    int32 WheelFired = 0;
+
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumTimers; ++i)
+    {
+        WheelHandles.Add(Wheel.Schedule(Delays[i], i));
+    }
+    const double WheelScheduleSeconds = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    Wheel.Advance(AdvanceSeconds, [&WheelFired](int32) { WheelFired++; });
+    const double WheelAdvanceSeconds = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    for (const FSlotMapHandle& Handle : WheelHandles)
+    {
+        Wheel.Cancel(Handle);
+    }
+    const double WheelCancelSeconds = FPlatformTime::Seconds() - StartTime;
+
+    // --- FTimerManager (standalone, so the world's timers are unaffected) ---
+    FTimerManager Manager;
+    TArray<FTimerHandle> ManagerHandles;
+    ManagerHandles.SetNum(NumTimers);
+    int32 ManagerFired = 0;
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumTimers; ++i)
+    {
+        Manager.SetTimer(ManagerHandles[i], FTimerDelegate::CreateLambda([&ManagerFired]() { ManagerFired++; }), Delays[i], false);
+    }
+    const double ManagerScheduleSeconds = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    Manager.Tick(AdvanceSeconds);
+    const double ManagerAdvanceSeconds = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    for (FTimerHandle& Handle : ManagerHandles)
+    {
+        Manager.ClearTimer(Handle);
+    }
+    const double ManagerCancelSeconds = FPlatformTime::Seconds() - StartTime;
+
+    UE_LOG(LogTemp, Log, TEXT("[Timer Wheel] %d timers, %.1f s advance: wheel fired %d, FTimerManager fired %d"),
+        NumTimers, AdvanceSeconds, WheelFired, ManagerFired);
+    UE_LOG(LogTemp, Log, TEXT("[Timer Wheel] Schedule: wheel %.1f ns, FTimerManager %.1f ns per timer"),
+        WheelScheduleSeconds * 1000000000.0 / NumTimers, ManagerScheduleSeconds * 1000000000.0 / NumTimers);
+    UE_LOG(LogTemp, Log, TEXT("[Timer Wheel] Advance: wheel %.3f ms, FTimerManager %.3f ms"),
+        WheelAdvanceSeconds * 1000.0, ManagerAdvanceSeconds * 1000.0);
+    UE_LOG(LogTemp, Log, TEXT("[Timer Wheel] Cancel: wheel %.1f ns, FTimerManager %.1f ns per timer"),
+        WheelCancelSeconds * 1000000000.0 / NumTimers, ManagerCancelSeconds * 1000000000.0 / NumTimers);
+}
+
+void AEnemyDirectorEnhanced::UpdateSpatialPartition()
+{
+    /*
+     * Algorithm: Quadtree Reconstruction
+     * Time Complexity: O(n log n) where n = number of enemies
+     * Space Complexity: O(n)
+     * * Purpose: Rebuild spatial partition for efficient range queries
+     */
+    
+    double StartTime = FPlatformTime::Seconds();
+
+    // Clear previous frame's data.
+    SpatialPartition->Clear();
+
+    // Re-insert all active arena enemies into the Quadtree (one Position component per arena enemy).
+    Components.Each<FEnemyPosition>([this](FEnemyEntity Entity, const FEnemyPosition& Position)
+    {
+        FVector2D Location2D(Position.Location.X, Position.Location.Y);
+        FQuadtreePoint Point(Location2D, PEnemies.IsValidIndex(Entity) ? PEnemies[Entity] : nullptr);
+        SpatialPartition->Insert(Point);
+    });
+
+    double EndTime = FPlatformTime::Seconds();
+    QuadtreeQueryTime = static_cast<float>(EndTime - StartTime);
 }
 
 void AEnemyDirectorEnhanced::UpdateEnemyPriorities(const FVector& PlayerLocation)
@@ -130,39 +814,18 @@ void AEnemyDirectorEnhanced::UpdateEnemyPriorities(const FVector& PlayerLocation
     
     ThreatQueue.Clear();
 
-    for (AActor* Actor : PEnemies)
+    // Distances come from the DistancePass job. Entities are slot indices, assigned in PEnemies order.
+    Components.Each<FEnemyThreat>([this](FEnemyEntity Entity, FEnemyThreat& Threat)
     {
-        AEnemy* Enemy = Cast<AEnemy>(Actor);
-        if (Enemy && Enemy->BInArena)
-        {
-            float Distance = FVector::Dist(Enemy->GetActorLocation(), PlayerLocation);
-            
-            // Calculate threat priority (closer = higher threat = lower priority value for min-heap)
-            float Threat = Distance / 100.0f; // Normalize
-            
-            // Reverse lookup ID from Map (Ideally, the Enemy actor would store its own ID to avoid this loop).
-            int32 EnemyID = -1;
-            TArray<int32> Keys = EnemyRegistry.GetKeys();
-            for (int32 Key : Keys)
-            {
-                AActor* RegisteredActor;
-                if (EnemyRegistry.Find(Key, RegisteredActor) && RegisteredActor == Actor)
-                {
-                    EnemyID = Key;
-                    break;
-                }
-            }
+        // Calculate threat priority (closer = higher threat = lower priority value for min-heap)
+        Threat.Score = Threat.Distance / 100.0f; // Normalize
 
-            // Enqueue into Custom Priority Queue.
-            if (EnemyID >= 0)
-            {
-                FEnemyPriority Priority(EnemyID, Threat, Distance);
-                ThreatQueue.Enqueue(Priority, Threat);
-            }
-        }
-    }
+        // Enqueue into Custom Priority Queue.
+        FEnemyPriority Priority(EnemySlots.GetHandleAt(Entity).ToID(), Threat.Score, Threat.Distance);
+        ThreatQueue.Enqueue(Priority, Threat.Score);
+    });
 
-    UE_LOG(LogTemp, Log, TEXT("[Priority Queue] Updated threat queue: %d enemies prioritized"),
+    UE_LOG(LogTemp, Verbose, TEXT("[Priority Queue] Updated threat queue: %d enemies prioritized"),
         ThreatQueue.Size());
 }
 
@@ -209,7 +872,7 @@ TArray<AActor*> AEnemyDirectorEnhanced::FindEnemiesInRadius(const FVector& Cente
     double StartTime = FPlatformTime::Seconds();
 
     TArray<AActor*> Result;
-    TArray<FQuadtreePoint> Points;
+    TFrameArray<FQuadtreePoint> Points;
     
     // Query the custom Quadtree structure.
     FVector2D Center2D(Center.X, Center.Y);
@@ -234,7 +897,41 @@ TArray<AActor*> AEnemyDirectorEnhanced::FindEnemiesInRadius(const FVector& Cente
     return Result;
 }
 
+void AEnemyDirectorEnhanced::QueryEnemiesInBox(const FVector2D& Min, const FVector2D& Max, TArray<AActor*>& OutEnemies) const
+{
+    /*
+     * Algorithm: Quadtree Range Query
+     * Time Complexity: O(log n + k) where k = number of results
+     * Space Complexity: O(k)
+     * * Purpose: Broad phase for batched hitscan (one query per frame instead of one trace per ray)
+     */
+
+    if (!SpatialPartition.IsValid())
+    {
+        return;
+    }
+
+    TFrameArray<FQuadtreePoint> Points;
+    SpatialPartition->Query(FQuadtreeBounds((Min + Max) * 0.5f, (Max - Min) * 0.5f), Points);
+
+    for (const FQuadtreePoint& Point : Points)
+    {
+        if (Point.Data)
+        {
+            OutEnemies.Add(Point.Data);
+        }
+    }
+}
+
 TArray<FEnemyPriority> AEnemyDirectorEnhanced::GetSortedEnemiesByThreat()
+{
+    // Blueprint result: the only copy that leaves the frame arena.
+    TFrameArray<FEnemyPriority> Priorities;
+    SortEnemiesByThreat(Priorities);
+    return TArray<FEnemyPriority>(Priorities);
+}
+
+void AEnemyDirectorEnhanced::SortEnemiesByThreat(TFrameArray<FEnemyPriority>& OutPriorities)
 {
     /*
      * Algorithm: QuickSort
@@ -246,45 +943,22 @@ TArray<FEnemyPriority> AEnemyDirectorEnhanced::GetSortedEnemiesByThreat()
     double StartTime = FPlatformTime::Seconds();
 
     // Build array of enemy priorities.
-    TArray<FEnemyPriority> Priorities;
+    OutPriorities.Reset();
     
-    // Get player location for distance calculation.
-    AFpsCharacter* Player = Cast<AFpsCharacter>(
-        GetWorld()->GetFirstPlayerController()->GetCharacter()
-    );
-    FVector PlayerLocation = Player ? Player->GetActorLocation() : FVector::ZeroVector;
+    // Get player location for distance calculation (cached reference, no global lookup).
+    FVector PlayerLocation = FVector::ZeroVector;
+    GetWorld()->GetSubsystem<UPlayerCache>()->GetPlayerLocation(PlayerLocation);
 
-    // Populate unordered list.
-    for (AActor* Actor : PEnemies)
+    // Populate unordered list. Entities are slot indices, so the handle is a direct lookup.
+    Components.Each<FEnemyPosition>([this, &OutPriorities, &PlayerLocation](FEnemyEntity Entity, const FEnemyPosition& Position)
     {
-        AEnemy* Enemy = Cast<AEnemy>(Actor);
-        if (Enemy && Enemy->BInArena)
-        {
-            float Distance = FVector::Dist(Enemy->GetActorLocation(), PlayerLocation);
-            
-            // Find enemy ID (Reverse lookup).
-            int32 EnemyID = -1;
-            TArray<int32> Keys = EnemyRegistry.GetKeys();
-            for (int32 Key : Keys)
-            {
-                AActor* RegisteredActor;
-                if (EnemyRegistry.Find(Key, RegisteredActor) && RegisteredActor == Actor)
-                {
-                    EnemyID = Key;
-                    break;
-                }
-            }
-
-            if (EnemyID >= 0)
-            {
-                float Threat = 10000.0f / (Distance + 1.0f); // Higher threat for closer enemies.
-                Priorities.Add(FEnemyPriority(EnemyID, Threat, Distance));
-            }
-        }
-    }
+        float Distance = FVector::Dist(Position.Location, PlayerLocation);
+        float Threat = 10000.0f / (Distance + 1.0f); // Higher threat for closer enemies.
+        OutPriorities.Add(FEnemyPriority(EnemySlots.GetHandleAt(Entity).ToID(), Threat, Distance));
+    });
 
     // Sort using custom QuickSort implementation - O(n log n).
-    SortingAlgorithms::QuickSort(Priorities, 
+    SortingAlgorithms::QuickSort(OutPriorities, 
         [](const FEnemyPriority& A, const FEnemyPriority& B)
         {
             return A.Priority > B.Priority; // Descending order (highest threat first).
@@ -295,39 +969,48 @@ TArray<FEnemyPriority> AEnemyDirectorEnhanced::GetSortedEnemiesByThreat()
     SortTime = static_cast<float>(EndTime - StartTime);
 
     UE_LOG(LogTemp, Log, TEXT("[QuickSort] Sorted %d enemies by threat in %.4f ms"),
-        Priorities.Num(), SortTime * 1000.0f);
-
-    return Priorities;
+        OutPriorities.Num(), SortTime * 1000.0f);
 }
 
-AActor* AEnemyDirectorEnhanced::FindEnemyByID(int32 EnemyID)
+AActor* AEnemyDirectorEnhanced::FindEnemyByID(int64 EnemyID)
 {
     /*
-     * Algorithm: HashMap Lookup
-     * Time Complexity: O(1) average, O(n) worst case
+     * Algorithm: Generational Slot Map Lookup
+     * Time Complexity: O(1) worst case (array index + generation compare)
      * Space Complexity: O(1)
-     * * Purpose: Fast enemy lookup by unique ID
+     * * Purpose: Fast enemy lookup by handle that never returns a pooled-and-reused enemy for an old ID
      */
     
     double StartTime = FPlatformTime::Seconds();
 
-    AActor* FoundEnemy;
-    // Perform O(1) lookup.
-    bool bFound = EnemyRegistry.Find(EnemyID, FoundEnemy);
+    const FSlotMapHandle Handle = FSlotMapHandle::FromID(EnemyID);
+    AActor* const* FoundEnemy = EnemySlots.Find(Handle);
 
     double EndTime = FPlatformTime::Seconds();
     SearchTime = static_cast<float>(EndTime - StartTime);
 
-    if (bFound)
+    if (FoundEnemy != nullptr)
     {
-        UE_LOG(LogTemp, Verbose, TEXT("[HashMap] Found enemy ID %d in %.4f µs"),
+        UE_LOG(LogTemp, Verbose, TEXT("[Slot Map] Found enemy ID %lld in %.4f µs"),
             EnemyID, SearchTime * 1000000.0f);
-        return FoundEnemy;
+        return *FoundEnemy;
     }
 
+    UE_LOG(LogTemp, Verbose, TEXT("[Slot Map] Stale or unknown enemy ID %lld (slot %d, generation %u)"),
+        EnemyID, Handle.Index, Handle.Generation);
     return nullptr;
 }
 
+void AEnemyDirectorEnhanced::GetFrameAllocationStats(int32& OutArenaAllocations, int32& OutArenaKilobytes,
+                                                     int32& OutArenaHeapFallbacks, int32& OutTickHeapAllocations) const
+{
+    const FFrameArena::FStats ArenaStats = FFrameArena::Get().GetLastFrameStats();
+    OutArenaAllocations = ArenaStats.Allocations;
+    OutArenaKilobytes = static_cast<int32>(ArenaStats.Bytes / 1024);
+    OutArenaHeapFallbacks = ArenaStats.HeapFallbacks;
+    OutTickHeapAllocations = TickHeapAllocations;
+}
+
 void AEnemyDirectorEnhanced::GetPerformanceMetrics(float& OutQuadtreeQueryTime, float& OutSortTime,
                                                    float& OutSearchTime, int32& OutTotalQueries) const
 {
@@ -342,11 +1025,9 @@ void AEnemyDirectorEnhanced::GetPerformanceMetrics(float& OutQuadtreeQueryTime,
 
 void AEnemyDirectorEnhanced::AttemptSpawnEnemies()
 {
-    // Object Pooling: Retrieve lists.
-    TArray<AActor*> pPooledEnemies = GetAllEnemiesInPool();
-    TArray<AActor*> pArenaEnemies = GetAllEnemiesInArena();
-    int iPooledEnemiesCount = pPooledEnemies.Num();
-    int iArenaEnemiesCount = pArenaEnemies.Num();
+    // Object Pooling: the pool list is maintained on spawn/return, so counts are O(1).
+    int iPooledEnemiesCount = PooledEnemies.Num();
+    int iArenaEnemiesCount = PEnemies.Num() - iPooledEnemiesCount;
     
     if (iPooledEnemiesCount == 0)
         return; // No enemies available in pool.
@@ -370,7 +1051,7 @@ void AEnemyDirectorEnhanced::AttemptSpawnEnemies()
     // Activate enemies.
     for (int i = 0; i < iAmountSpawnable; ++i)
     {
-        AEnemy* pEnemy = Cast<AEnemy>(pPooledEnemies[i]);
+        AEnemy* pEnemy = PooledEnemies.PopFront();
 
         // Re-bind death delegate.
         pEnemy->OnEnemyKilled.Clear();
@@ -378,7 +1059,7 @@ void AEnemyDirectorEnhanced::AttemptSpawnEnemies()
 
         // Teleport to random spawn point and enable.
         pEnemy->SetActorEnableCollision(false);
-        auto spawnLocation = PSpawnLocations[FMath::RandRange(0, PSpawnLocations.Num() - 1)];
+        auto spawnLocation = PSpawnLocations[GameplayRandom::RandRange(0, PSpawnLocations.Num() - 1)];
         auto enemyRotation = pEnemy->GetActorRotation();
         pEnemy->TeleportTo(spawnLocation, enemyRotation);
         pEnemy->BInArena = true;
@@ -386,23 +1067,48 @@ void AEnemyDirectorEnhanced::AttemptSpawnEnemies()
     }
 }
 
+void AEnemyDirectorEnhanced::BuildWaveTables()
+{
+    /*
+     * Algorithm: Precomputed Lookup Table
+     * Time Complexity: O(W) once (W = WaveCurves::TableSize; O(W log R) with R cooked wave rows), O(1) per wave afterwards
+     * * Purpose: Values depend only on the wave number, never on previously applied waves.
+     */
+    WaveSizeTable = WaveCurves::Bake(WaveSizeCurve, IInitialWaveSpawnCount, IMaxEnemiesInWave, IFinalGrowthWave);
+    ArenaCapacityTable = WaveCurves::Bake(ArenaCapacityCurve, IMaxEnemiesInArena, IMaxEnemyArenaCapacity, IWaveMaxEnemyArenaCapacityReached);
+    MaxWalkSpeedTable = WaveCurves::MakeStepped(m_fGlobalMaxWalkSpeed, 50.0f, m_fGlobalFinalMaxWalkSpeed);
+    MinWalkSpeedTable = WaveCurves::MakeStepped(m_fGlobalMinWalkSpeed, 15.0f, m_fGlobalFinalMinWalkSpeed);
+
+    // Cooked wave rows (UGameplayDataSubsystem) replace the baked values from their first wave on;
+    // waves past the last row reuse it.
+    const FGameplayDataView* Data = UGameplayDataSubsystem::Get(this);
+    if (Data == nullptr)
+    {
+        return;
+    }
+    for (int32 i = 0; i < WaveCurves::TableSize; ++i)
+    {
+        if (const GameplayData::FWaveRecord* Wave = Data->FindWave(i + 1))
+        {
+            WaveSizeTable.Values[i] = Wave->WaveSize;
+            ArenaCapacityTable.Values[i] = Wave->ArenaCapacity;
+            MinWalkSpeedTable.Values[i] = Wave->MinWalkSpeed;
+            MaxWalkSpeedTable.Values[i] = Wave->MaxWalkSpeed;
+        }
+    }
+}
+
 int AEnemyDirectorEnhanced::UpdateWaveSize()
 {
-    // Linear growth calculation for total wave size.
-    int iTotalEnemyGrowth = IMaxEnemiesInWave - IInitialWaveSpawnCount;
-    float fRateOfGrowth = (float)iTotalEnemyGrowth / IFinalGrowthWave;
-    int iNewEnemyCount = (ICurrentWave - 1) * fRateOfGrowth;
-    ICurrentWaveSize = UKismetMathLibrary::Min(IMaxEnemiesInWave, (IInitialWaveSpawnCount + iNewEnemyCount));
+    // Table lookup for total wave size.
+    ICurrentWaveSize = WaveSizeTable.Get(ICurrentWave);
     return ICurrentWaveSize;
 }
 
 int AEnemyDirectorEnhanced::UpdateEnemyArenaCapacity()
 {
-    // Linear growth calculation for concurrent enemy limit.
-    int iTotalCapacityGrowth = IMaxEnemyArenaCapacity - IMaxEnemiesInArena;
-    float fRateOfGrowth = (float)iTotalCapacityGrowth / IWaveMaxEnemyArenaCapacityReached;
-    int iNewCapacity = (ICurrentWave - 1) * fRateOfGrowth;
-    IMaxEnemiesInArena = UKismetMathLibrary::Min(IMaxEnemyArenaCapacity, (IMaxEnemiesInArena + iNewCapacity));
+    // Table lookup for concurrent enemy limit.
+    IMaxEnemiesInArena = ArenaCapacityTable.Get(ICurrentWave);
     return IMaxEnemiesInArena;
 }
 
@@ -415,59 +1121,27 @@ void AEnemyDirectorEnhanced::UpdateWaveParameters()
     UpdateEnemyArenaCapacity();
 
     // Increase difficulty (Speed).
-    m_fGlobalMaxWalkSpeed = FMath::Clamp(m_fGlobalMaxWalkSpeed + 50.0f, 0, m_fGlobalFinalMaxWalkSpeed);
-    m_fGlobalMinWalkSpeed = FMath::Clamp(m_fGlobalMinWalkSpeed + 15.0f, 0, m_fGlobalFinalMinWalkSpeed);
+    m_fGlobalMaxWalkSpeed = MaxWalkSpeedTable.Get(ICurrentWave);
+    m_fGlobalMinWalkSpeed = MinWalkSpeedTable.Get(ICurrentWave);
 }
 
 void AEnemyDirectorEnhanced::NextWave()
 {
     // Setup parameters for the new wave.
     UpdateWaveParameters();
-    OnWaveChanged.Broadcast(ICurrentWave);
+    NotifyWaveChanged();
     
     // Delay start.
-    UWorld* pWorld = GetWorld();
     ClearCurrentTimer();
-    pWorld->GetTimerManager().SetTimer(pTimerHandleCurrent, this, 
-        &AEnemyDirectorEnhanced::NextWaveDelayedCallback, FSecondsBeforeWaveStarts, false);
+    WaveTimer = DirectorTimers.Schedule(FSecondsBeforeWaveStarts, { EDirectorTimer::WaveStart, INDEX_NONE });
 }
 
 void AEnemyDirectorEnhanced::EndWave()
 {
     // Start intermission.
     m_bWaveIntermission = true;
-    UWorld* pWorld = GetWorld();
     ClearCurrentTimer();
-    pWorld->GetTimerManager().SetTimer(pTimerHandleCurrent, this,
-        &AEnemyDirectorEnhanced::EndWaveDelayedCallback, FSecondsBeforeWaveEnds, false);
-}
-
-TArray<AActor*> AEnemyDirectorEnhanced::GetAllEnemiesInArena()
-{
-    TArray<AActor*> pEnemiesInArena = TArray<AActor*>();
-    for (AActor* actor : PEnemies)
-    {
-        AEnemy* pEnemy = Cast<AEnemy>(actor);
-        if (pEnemy->BInArena)
-        {
-            pEnemiesInArena.Add(actor);
-        }
-    }
-    return pEnemiesInArena;
-}
-
-TArray<AActor*> AEnemyDirectorEnhanced::GetAllEnemiesInPool()
-{
-    TArray<AActor*> pEnemiesInPool = TArray<AActor*>();
-    for (AActor* actor : PEnemies)
-    {
-        AEnemy* pEnemy = Cast<AEnemy>(actor);
-        if (!pEnemy->BInArena)
-        {
-            pEnemiesInPool.Add(actor);
-        }
-    }
-    return pEnemiesInPool;
+    WaveTimer = DirectorTimers.Schedule(FSecondsBeforeWaveEnds, { EDirectorTimer::WaveEnd, INDEX_NONE });
 }
 
 void AEnemyDirectorEnhanced::ModifyWaveSpeeds()
@@ -476,15 +1150,42 @@ void AEnemyDirectorEnhanced::ModifyWaveSpeeds()
     for (int i = 0; i < PEnemies.Num(); ++i)
     {
         AEnemy* pEnemy = Cast<AEnemy>(PEnemies[i]);
-        float maxWalkSpeed = FMath::RandRange(m_fGlobalMinWalkSpeed, m_fGlobalMaxWalkSpeed);
+        float maxWalkSpeed = GameplayRandom::FRandRange(m_fGlobalMinWalkSpeed, m_fGlobalMaxWalkSpeed);
         float finalSpeed = maxWalkSpeed + pEnemy->GetBaseSpeed();
         pEnemy->GetCharacterMovement()->MaxWalkSpeed = finalSpeed;
     }
 }
 
-void AEnemyDirectorEnhanced::ConfirmEnemyKilled()
+void AEnemyDirectorEnhanced::ConfirmEnemyKilled(AEnemy* pEnemy)
+{
+    PendingPoolReturns.AddUnique(pEnemy);
+}
+
+void AEnemyDirectorEnhanced::ProcessPoolReturns()
 {
-    IWaveKills++;
+    if (PendingPoolReturns.Num() == 0)
+        return;
+
+    for (AEnemy* pEnemy : PendingPoolReturns)
+    {
+        pEnemy->ReturnToPool();
+        if (Components.IsValidEntity(pEnemy->GetCombatIndex()))
+        {
+            // Died mid-swing or cooling down: the cancelled timer was the only thing that would have woken
+            // the enemy's waiting BTT_Attack, so wake it now or the respawned tree stays parked there.
+            if (DirectorTimers.Cancel(Components.ForceReady(pEnemy->GetCombatIndex())))
+            {
+                FAIMessage::Send(pEnemy, FAIMessage(EnemyKeys::CombatReady, this, true));
+            }
+            BrainBatch.ClearMoveTarget(pEnemy->GetCombatIndex());
+
+            // New life, new handle: IDs issued while it was in the arena no longer resolve.
+            EnemySlots.Renew(EnemySlots.GetHandleAt(pEnemy->GetCombatIndex()));
+        }
+        PooledEnemies.PushBack(pEnemy);
+    }
+    IWaveKills += PendingPoolReturns.Num();
+    PendingPoolReturns.Reset();
 
     // Check if wave is cleared.
     if (IWaveKills >= ICurrentWaveSize)
@@ -498,6 +1199,26 @@ void AEnemyDirectorEnhanced::RefreshUI()
     OnWaveChanged.Broadcast(ICurrentWave);
 }
 
+void AEnemyDirectorEnhanced::NotifyWaveChanged()
+{
+    UUIEventBus* pBus = GetWorld() ? GetWorld()->GetSubsystem<UUIEventBus>() : nullptr;
+    if (pBus == nullptr)
+    {
+        OnWaveChanged.Broadcast(ICurrentWave);
+        return;
+    }
+
+    pBus->Publish(EUIChannel::Wave, ICurrentWave);
+}
+
+void AEnemyDirectorEnhanced::HandleUIChannelChanged(EUIChannel Channel, int32 Value, int32 SecondaryValue)
+{
+    if (Channel == EUIChannel::Wave)
+    {
+        OnWaveChanged.Broadcast(Value);
+    }
+}
+
 void AEnemyDirectorEnhanced::EndWaveDelayedCallback()
 {
     NextWave();
@@ -512,9 +1233,6 @@ void AEnemyDirectorEnhanced::NextWaveDelayedCallback()
 
 void AEnemyDirectorEnhanced::ClearCurrentTimer()
 {
-    UWorld* pWorld = GetWorld();
-    if (pWorld == nullptr)
-        return;
-    
-    pWorld->GetTimerManager().ClearTimer(pTimerHandleCurrent);
+    DirectorTimers.Cancel(WaveTimer);
+    WaveTimer = FSlotMapHandle();
 }
\ No newline at end of file
@@ -4,19 +4,30 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
-#include "CustomHashMap.h"
+#include "CustomSlotMap.h"
+#include "CustomIntrusiveList.h"
+#include "CustomTimerWheel.h"
 #include "CustomPriorityQueue.h"
 #include "Quadtree.h"
 #include "SortingAlgorithms.h"
 #include "SearchAlgorithms.h"
+#include "EnemyComponents.h"
+#include "EnemyBrainBatch.h"
+#include "WaveCurveTable.h"
+#include "JobSystem.h"
+#include "FrameAllocator.h"
+#include "Enemy.h"
+#include "UIEventBus.h"
 #include "EnemyDirectorEnhanced.generated.h"
 
+
 // Multicast delegate to broadcast wave changes to UI or other listeners.
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWaveChanged, int, iWave);
 
 /**
  * Enhanced Enemy Priority structure.
  * Used for sorting enemies based on threat levels (distance, ID).
+ * EnemyID is a packed generational handle (FSlotMapHandle::ToID); resolve it with FindEnemyByID.
  * Compatible with CustomPriorityQueue and SortingAlgorithms.
  */
 USTRUCT(BlueprintType)
@@ -25,7 +36,7 @@ struct FEnemyPriority
     GENERATED_BODY()
 
     UPROPERTY()
-    int32 EnemyID;
+    int64 EnemyID;
 
     UPROPERTY()
     float Priority;
@@ -42,7 +53,7 @@ struct FEnemyPriority
     }
 
     // Parameterized Constructor
-    FEnemyPriority(int32 InID, float InPriority, float InDistance)
+    FEnemyPriority(int64 InID, float InPriority, float InDistance)
         : EnemyID(InID)
         , Priority(InPriority)
         , DistanceToPlayer(InDistance)
@@ -62,14 +73,34 @@ struct FEnemyPriority
     }
 };
 
+/**
+ * Timers owned by the enhanced director, all driven by a single CustomTimerWheel.
+ */
+enum class EDirectorTimer : uint8
+{
+    WaveStart,          // Pre-wave intermission is over: spawning resumes.
+    WaveEnd,            // Post-wave delay is over: the next wave is set up.
+    AttackFinished,     // Entity's attack montage has finished: cooldown begins.
+    CooldownFinished    // Entity can attack again.
+};
+
+struct FDirectorTimer
+{
+    EDirectorTimer Type = EDirectorTimer::WaveStart;
+    FEnemyEntity Entity = INDEX_NONE;
+};
+
 /**
  * AEnemyDirectorEnhanced:
  * Enhanced enemy director utilizing custom C++ data structures and algorithms
  * to optimize enemy management, spatial queries, and prioritization.
  * * Optimization Overview:
- * - CustomHashMap: Provides O(1) access to enemy instances via ID.
+ * - CustomSlotMap: Generational enemy handles with O(1) lookup; stale IDs of pooled enemies are rejected.
+ * - CustomIntrusiveList: O(1) pooled-enemy free list threaded through the enemies themselves.
  * - CustomPriorityQueue: Manages enemy threat levels with O(log n) efficiency.
  * - Quadtree: Spatial partitioning allows for O(log n) area searches instead of O(n) iteration.
+ * - FEnemyComponentStore: Sparse-set enemy components, synced from the actors once per frame and iterated densely.
+ * - CustomTimerWheel: Wave delays and attack/cooldown timers with O(1) schedule/cancel and one expiry batch per tick.
  * * Algorithms:
  * - QuickSort: Used for ranking enemies by threat.
  * - Binary Search: (Available via SearchAlgorithms header).
@@ -83,6 +114,7 @@ public:
     AEnemyDirectorEnhanced();
 
     // Event delegates
+    // Routed through UUIEventBus, so OnWaveChanged fires at most once per flush with the latest wave.
     UPROPERTY(BlueprintAssignable)
     FOnWaveChanged OnWaveChanged;
 
@@ -115,10 +147,18 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
     int IWaveMaxEnemyArenaCapacityReached = 22;
 
-    // Current max active enemies allowed (scales with wave).
+    // Current max active enemies allowed (scales with wave). The editor value is the wave 1 capacity.
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
     int IMaxEnemiesInArena = 5;
 
+    // Shape of the wave size growth (IInitialWaveSpawnCount -> IMaxEnemiesInWave).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
+    FWaveCurveSettings WaveSizeCurve;
+
+    // Shape of the arena capacity growth (initial IMaxEnemiesInArena -> IMaxEnemyArenaCapacity).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
+    FWaveCurveSettings ArenaCapacityCurve;
+
     // Time delay before wave begins.
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
     float FSecondsBeforeWaveStarts = 4.0f;
@@ -131,6 +171,23 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Management")
     TArray<FVector> PSpawnLocations;
 
+    // Pause after an attack montage finishes before the enemy may attack again.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat")
+    float FAttackCooldownSeconds = 0.0f;
+
+    // Drive every enemy from one parallel decision pass instead of per-enemy behavior trees.
+    // The trees are stopped while this is on and restarted when it is turned off.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AI")
+    bool BUseBatchedBrain = false;
+
+    // How far the player must move before the batched brain re-issues an enemy's move order.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AI")
+    float FBrainRepathDistance = 50.0f;
+
+    // Worker threads for the director's job system (-1 = one per core minus the game thread, 0 = game thread only).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Performance")
+    int IJobWorkerThreads = -1;
+
     // Internal counters
     int ICurrentWaveSize = 0;
     int IWaveKills = 0;
@@ -152,22 +209,74 @@ public:
     UFUNCTION(BlueprintCallable, Category="Enemy Management")
     TArray<AActor*> FindEnemiesInRadius(const FVector& Center, float Radius);
 
+    // Collects enemies inside an axis-aligned XY box (O(log n + k)). Used by UHitscanResolver for whole shot batches.
+    void QueryEnemiesInBox(const FVector2D& Min, const FVector2D& Max, TArray<AActor*>& OutEnemies) const;
+
     // Returns a list of enemies sorted by threat level using QuickSort.
     UFUNCTION(BlueprintCallable, Category="Enemy Management")
     TArray<FEnemyPriority> GetSortedEnemiesByThreat();
 
-    // Retrieves an enemy by their unique ID using HashMap (O(1)).
+    // Same as GetSortedEnemiesByThreat, into a frame-arena array (no heap allocation).
+    void SortEnemiesByThreat(TFrameArray<FEnemyPriority>& OutPriorities);
+
+    // Retrieves an enemy by its generational handle ID (O(1)).
+    // Returns null once the enemy has been pooled since the ID was issued, rather than the enemy's next life.
     UFUNCTION(BlueprintCallable, Category="Enemy Management")
-    AActor* FindEnemyByID(int32 EnemyID);
+    AActor* FindEnemyByID(int64 EnemyID);
+
+    // --- Combat State Machine (attack state components, advanced once per frame) ---
+
+    // True if the enemy in this combat slot can start a new attack.
+    bool IsCombatReady(int32 CombatIndex) const;
+
+    // Starts an attack if the slot is Ready and the enemy is able to attack. Returns true if the attack began.
+    // The enemy's behavior tree is sent EnemyKeys::CombatReady once attack and cooldown have elapsed.
+    bool TryBeginAttack(int32 CombatIndex);
 
-    // Callback when an enemy dies.
+    // Returns the last batched brain frame: total time, cost per active enemy and commands issued.
+    UFUNCTION(BlueprintPure, Category="Performance")
+    void GetBrainStats(float& OutBrainTimeMs, float& OutMicrosecondsPerEnemy,
+                       int32& OutMoveCommands, int32& OutAttackCommands) const;
+
+    // Measures per-enemy decision cost of the behavior trees (ticked manually, so the trees must be running)
+    // against the batched brain (gather + parallel evaluate) over the same number of frames.
+    UFUNCTION(BlueprintCallable, Category="Performance")
+    void BenchmarkBrainCost(int32 Frames, float& OutTreeMicrosecondsPerEnemy, float& OutBatchedMicrosecondsPerEnemy);
+
+    // Runs the per-frame director jobs Frames times with 0, 1, 2, 4 ... workers and logs ms/frame and speedup.
+    // SyntheticEnemies > 0 replaces the arena with that many random points so the passes are big enough to scale.
+    UFUNCTION(BlueprintCallable, Category="Performance")
+    void BenchmarkJobScaling(int32 Frames, int32 SyntheticEnemies);
+
+    // Builds and destroys leaf-sized point lists and 8-entry neighbor lists Iterations times with TArray and with
+    // CustomSmallVector, and logs ns per list and heap allocations per list (allocations need a non-shipping build).
+    UFUNCTION(BlueprintCallable, Category="Performance")
+    void BenchmarkSmallVectors(int32 Iterations);
+
+    // Schedules NumTimers timers (0.05-5 s) on a CustomTimerWheel and on a standalone FTimerManager, advances both
+    // by half a second, cancels the rest, and logs the cost of each step.
+    UFUNCTION(BlueprintCallable, Category="Performance")
+    void BenchmarkTimers(int32 NumTimers = 10000);
+
+    // Records the next Frames director job lists and writes a Chrome trace (Saved/Profiling) plus per-worker utilization.
+    UFUNCTION(BlueprintCallable, Category="Performance")
+    void CaptureJobTrace(int32 Frames);
+
+    // Callback when an enemy's death montage finishes. Queues it for the next pool return batch.
     UFUNCTION()
-    void ConfirmEnemyKilled();
+    void ConfirmEnemyKilled(AEnemy* pEnemy);
 
     // Updates HUD elements.
     UFUNCTION(BlueprintCallable, Category="HUD")
     void RefreshUI();
 
+    // Frame arena usage of the last completed frame, and general-heap allocations made during the last director Tick.
+    // TickHeapAllocations counts every thread's mallocs while Tick ran (non-shipping builds only, -1 otherwise),
+    // so it is an upper bound for the director itself; ArenaHeapFallbacks is exact for frame-arena arrays.
+    UFUNCTION(BlueprintPure, Category="Performance")
+    void GetFrameAllocationStats(int32& OutArenaAllocations, int32& OutArenaKilobytes,
+                                 int32& OutArenaHeapFallbacks, int32& OutTickHeapAllocations) const;
+
     // Returns performance stats for the custom data structures.
     UFUNCTION(BlueprintPure, Category="Performance")
     void GetPerformanceMetrics(float& OutQuadtreeQueryTime, float& OutSortTime, 
@@ -175,6 +284,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // Timer callbacks for wave flow.
     void EndWaveDelayedCallback();
@@ -193,13 +303,15 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Speed")
     float m_fGlobalMinWalkSpeed = 70.0f;
 
-    FTimerHandle pTimerHandleCurrent;
-
 private:
     // --- Custom Data Structures ---
     
-    // Fast O(1) lookup map for enemy references.
-    CustomHashMap<int32, AActor*> EnemyRegistry; 
+    // Generational handles for enemy references (slot index == component entity == PEnemies index).
+    // A slot is renewed whenever its enemy returns to the pool, so IDs handed out earlier go stale.
+    CustomSlotMap<AActor*> EnemySlots;
+
+    // Enemies waiting in the pool, in return order (spawning pops from the front).
+    CustomIntrusiveList<AEnemy, &AEnemy::PoolLink> PooledEnemies;
     
     // Min-heap or Max-heap for priority management O(log n).
     CustomPriorityQueue<FEnemyPriority> ThreatQueue; 
@@ -215,18 +327,108 @@ private:
 
     // Wave state flags.
     bool m_bWaveIntermission;
-    int32 NextEnemyID;
+
+    // General-heap allocations counted across the last Tick (-1 when malloc stats are unavailable).
+    int32 TickHeapAllocations = -1;
+
+    // Enemies waiting to be returned to the pool (processed together at the start of Tick).
+    TArray<AEnemy*> PendingPoolReturns;
+
+    // --- Job System ---
+
+    // Worker pool for the director passes (created at BeginPlay).
+    TUniquePtr<FJobSystem> JobSystem;
+
+    // Per-frame job list: spatial rebuild || (distance pass -> threat scoring). Built once, run every active frame.
+    // The jobs read Position and write Threat components; FramePlayerLocation is captured with the frame sync.
+    FJobList FrameJobs;
+    FVector FramePlayerLocation;
+
+    // Remaining frames of an active job trace, and when it started.
+    int32 TraceFramesLeft = 0;
+    double TraceOriginSeconds = 0.0;
+
+    // Per-wave difficulty tables baked at BeginPlay (O(1) lookup by wave number).
+    WaveCurves::TWaveCurve<int32> WaveSizeTable;
+    WaveCurves::TWaveCurve<int32> ArenaCapacityTable;
+    WaveCurves::TWaveCurve<float> MaxWalkSpeedTable;
+    WaveCurves::TWaveCurve<float> MinWalkSpeedTable;
+
+    // Enemy components, one entity per PEnemies slot (entity == registry ID == combat index).
+    FEnemyComponentStore Components;
+
+    // Entities that reached Ready this frame (kept to avoid a per-frame allocation).
+    TArray<FEnemyEntity> CombatReadyScratch;
+
+    // Wave delays and attack/cooldown timers. Advanced once per Tick; due timers expire as one batch.
+    CustomTimerWheel<FDirectorTimer> DirectorTimers;
+
+    // The pending wave delay (WaveStart or WaveEnd), if any.
+    FSlotMapHandle WaveTimer;
+
+    // Batched brain SoA, indexed by entity.
+    FEnemyBrainBatch BrainBatch;
+
+    // True while the enemies' behavior trees are stopped in favour of the batched brain.
+    bool BrainTreesStopped = false;
+
+    // Last batched brain frame.
+    float BrainTimeMs = 0.0f;
+    int32 BrainActiveEnemies = 0;
+    int32 BrainMoveCommands = 0;
+    int32 BrainAttackCommands = 0;
 
     // --- Helper Functions ---
     void ClearCurrentTimer();
+
+    // Returns queued enemies to the pool and counts their kills in one pass.
+    void ProcessPoolReturns();
+
+    // Publishes the wave to the UI event bus (or broadcasts directly if there is none).
+    void NotifyWaveChanged();
+
+    // Forwards flushed Wave channel updates to OnWaveChanged.
+    UFUNCTION()
+    void HandleUIChannelChanged(EUIChannel Channel, int32 Value, int32 SecondaryValue);
     
-    // Rebuilds the Quadtree based on current enemy positions.
+    // Rebuilds the Quadtree from the Position components (runs as a job).
     void UpdateSpatialPartition();
+
+    // Builds FrameJobs.
+    void BuildFrameJobs();
+
+    // Frame boundary: copies actor state into the components (actors are only read on the game thread).
+    // Entering or leaving the arena adds or removes the Position, Velocity and Threat components.
+    void SyncComponentsFromActors();
+
+    // Runs FrameJobs and handles tracing/logging.
+    void RunFrameJobs();
     
-    // Populates the HashMap.
+    // Issues a handle per enemy and fills the pooled-enemy list.
     void RebuildEnemyRegistry();
+
+    // Bakes the wave tables from the wave 1 property values.
+    void BuildWaveTables();
+
+    // Creates one entity per PEnemies slot, sizes the brain SoA and hands each enemy its entity.
+    void RebuildComponents();
+
+    // Stops or restarts the enemies' behavior trees to match BUseBatchedBrain.
+    void ApplyBrainMode();
+
+    // Copies positions and combat readiness from the components into the brain SoA.
+    void GatherBrainInputs();
+
+    // Gather, evaluate in parallel, then issue move/attack commands on the game thread.
+    void UpdateBatchedBrain();
+
+    // Advances DirectorTimers and wakes the behavior trees of enemies that became Ready.
+    void AdvanceTimers(float DeltaTime);
+
+    // Applies one expired timer (wave flow or attack state transition).
+    void HandleTimer(const FDirectorTimer& Timer);
     
-    // Recalculates threat levels and updates the Priority Queue.
+    // Scores the Threat components and updates the Priority Queue (runs as a job).
     void UpdateEnemyPriorities(const FVector& PlayerLocation);
     
     void ModifyWaveSpeeds();
@@ -235,8 +437,5 @@ private:
     void UpdateWaveParameters();
     void NextWave();
     void EndWave();
-    
-    // Object pooling helpers.
-    TArray<AActor*> GetAllEnemiesInArena();
-    TArray<AActor*> GetAllEnemiesInPool();
+
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Runtime/Core/Public/UObject/NameTypes.h"
 #include "Runtime/Core/Public/Containers/UnrealString.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 
 /**
  * Namespace: EnemyKeys
@@ -24,4 +25,24 @@ namespace EnemyKeys
      * Typically updated by perception or distance-check services.
      */
     TCHAR const* const IsPlayerInRange = TEXT("IsPlayerInRange");
+
+    /**
+     * AI message (not a blackboard key) sent by the director when an
+     * enemy's attack and cooldown have elapsed, or when it returns to the
+     * pool mid-attack. BTT_Attack sleeps on it.
+     */
+    TCHAR const* const CombatReady = TEXT("CombatReady");
 }
+
+/**
+ * FEnemyBlackboardKeyIDs:
+ *
+ * Key IDs for the EnemyKeys names, resolved by each AEnemy_Controller
+ * whenever it initializes its blackboard in OnPossess. The ID-based GetValue/SetValue accessors skip the
+ * name -> key ID search that GetValueAsX/SetValueAsX(FName) do on every call.
+ */
+struct FEnemyBlackboardKeyIDs
+{
+    FBlackboard::FKey TargetLocation = FBlackboard::InvalidKey;
+    FBlackboard::FKey IsPlayerInRange = FBlackboard::InvalidKey;
+};
@@ -3,6 +3,9 @@
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "UObject/ConstructorHelpers.h"
 
 AEnemy_Controller::AEnemy_Controller(FObjectInitializer const& pObjectInit)
@@ -39,10 +42,69 @@ void AEnemy_Controller::OnPossess(APawn* a_pPawn)
     if (m_pBlackboard && PBehaviorTree)
     {
         m_pBlackboard->InitializeBlackboard(*PBehaviorTree->BlackboardAsset);
+        ResolveBlackboardKeys();
     }
 }
 
 UBlackboardComponent* AEnemy_Controller::GetBlackboard() const
 {
     return m_pBlackboard;
-}
\ No newline at end of file
+}
+
+const FEnemyBlackboardKeyIDs& AEnemy_Controller::GetBlackboardKeys() const
+{
+    return m_BlackboardKeys;
+}
+
+void AEnemy_Controller::ResolveBlackboardKeys()
+{
+    const UBlackboardData* pAsset = m_pBlackboard->GetBlackboardAsset();
+    if (pAsset == nullptr)
+        return;
+
+    // Resolved against the asset as it is now, once per possession: an asset edited between PIE sessions
+    // gets fresh IDs, and the tree's per-tick accesses still skip the name search.
+    m_BlackboardKeys.TargetLocation = pAsset->GetKeyID(EnemyKeys::TargetLocation);
+    m_BlackboardKeys.IsPlayerInRange = pAsset->GetKeyID(EnemyKeys::IsPlayerInRange);
+}
+
+void AEnemy_Controller::BenchmarkBlackboardAccess(int32 Iterations, float& OutNameAccessNs, float& OutKeyIDAccessNs)
+{
+    OutNameAccessNs = 0.0f;
+    OutKeyIDAccessNs = 0.0f;
+    if (m_pBlackboard == nullptr || m_pBlackboard->GetBlackboardAsset() == nullptr)
+        return;
+
+    Iterations = FMath::Max(1, Iterations);
+
+    // One pass mirrors a tree pass: FindPlayerLocation writes the target, ChasePlayer reads it,
+    // IsPlayerInRange writes the range flag and Attack reads it.
+    // Writing back the current values leaves the blackboard (and its observers) untouched.
+    const FVector vTarget = m_pBlackboard->GetValueAsVector(EnemyKeys::TargetLocation);
+    const bool bInRange = m_pBlackboard->GetValueAsBool(EnemyKeys::IsPlayerInRange);
+    int64 iChecksum = 0;
+
+    double startTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Iterations; i++)
+    {
+        m_pBlackboard->SetValueAsVector(EnemyKeys::TargetLocation, vTarget);
+        iChecksum += m_pBlackboard->GetValueAsVector(EnemyKeys::TargetLocation).X > 0.0;
+        m_pBlackboard->SetValueAsBool(EnemyKeys::IsPlayerInRange, bInRange);
+        iChecksum += m_pBlackboard->GetValueAsBool(EnemyKeys::IsPlayerInRange);
+    }
+    OutNameAccessNs = (float)((FPlatformTime::Seconds() - startTime) * 1000000000.0 / Iterations);
+
+    startTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Iterations; i++)
+    {
+        m_pBlackboard->SetValue<UBlackboardKeyType_Vector>(m_BlackboardKeys.TargetLocation, vTarget);
+        iChecksum += m_pBlackboard->GetValue<UBlackboardKeyType_Vector>(m_BlackboardKeys.TargetLocation).X > 0.0;
+        m_pBlackboard->SetValue<UBlackboardKeyType_Bool>(m_BlackboardKeys.IsPlayerInRange, bInRange);
+        iChecksum += m_pBlackboard->GetValue<UBlackboardKeyType_Bool>(m_BlackboardKeys.IsPlayerInRange);
+    }
+    OutKeyIDAccessNs = (float)((FPlatformTime::Seconds() - startTime) * 1000000000.0 / Iterations);
+
+    UE_LOG(LogTemp, Log, TEXT("[Blackboard] %d passes: by name %.1f ns/enemy/tick, by key ID %.1f ns/enemy/tick (%.1fx) [%lld]"),
+        Iterations, OutNameAccessNs, OutKeyIDAccessNs,
+        OutKeyIDAccessNs > 0.0f ? OutNameAccessNs / OutKeyIDAccessNs : 0.0f, iChecksum);
+}
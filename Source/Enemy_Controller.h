@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "EnemyKeys.h"
 #include "Enemy_Controller.generated.h"
  
 /**
@@ -27,6 +28,13 @@ public:
 	// Accessor for the Blackboard component.
 	class UBlackboardComponent* GetBlackboard() const;
 
+	// Accessor for the blackboard key IDs (resolved when the blackboard is initialized).
+	const FEnemyBlackboardKeyIDs& GetBlackboardKeys() const;
+
+	// Time the blackboard reads/writes one enemy performs per behavior tree pass, by key name vs by cached key ID.
+	UFUNCTION(BlueprintCallable, Category="Performance")
+	void BenchmarkBlackboardAccess(int32 Iterations, float& OutNameAccessNs, float& OutKeyIDAccessNs);
+
 	// Component responsible for running the Behavior Tree logic.
 	UPROPERTY(EditInstanceOnly, BlueprintReadWrite, Category = "AI")
 	class UBehaviorTreeComponent* PBehaviorTreeComponent;
@@ -38,4 +46,10 @@ public:
 private:
 	// Component used to store data shared between Behavior Tree nodes.
 	class UBlackboardComponent* m_pBlackboard;
+
+	// Key IDs for m_pBlackboard's asset.
+	FEnemyBlackboardKeyIDs m_BlackboardKeys;
+
+	// Look up the key IDs in the current blackboard asset (called whenever the blackboard is initialized).
+	void ResolveBlackboardKeys();
 };
\ No newline at end of file
@@ -0,0 +1,118 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FrameAllocator.h"
+#include "Misc/CoreDelegates.h"
+
+FFrameArena& FFrameArena::Get()
+{
+    static FFrameArena Arena;
+    return Arena;
+}
+
+FFrameArena::FFrameArena()
+{
+    for (FBuffer& Buffer : Buffers)
+    {
+        Buffer.Capacity = InitialCapacity;
+        Buffer.Base = (uint8*)FMemory::Malloc(Buffer.Capacity, PLATFORM_CACHE_LINE_SIZE);
+    }
+
+    FCoreDelegates::OnEndFrame.AddRaw(this, &FFrameArena::EndFrame);
+}
+
+FFrameArena::~FFrameArena()
+{
+    // Static destruction: the engine loop has stopped, so OnEndFrame can no longer fire.
+    for (FBuffer& Buffer : Buffers)
+    {
+        for (void* Memory : Buffer.Fallbacks)
+        {
+            FMemory::Free(Memory);
+        }
+        FMemory::Free(Buffer.Base);
+        Buffer.Base = nullptr;
+    }
+}
+
+void* FFrameArena::Allocate(SIZE_T Size, uint32 Alignment)
+{
+    FBuffer& Buffer = Buffers[CurrentBuffer.load(std::memory_order_acquire)];
+
+    SIZE_T Offset = Buffer.Offset.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        const SIZE_T Aligned = Align(Buffer.Base + Offset, Alignment) - Buffer.Base;
+        const SIZE_T End = Aligned + Size;
+        if (End > Buffer.Capacity)
+            break;
+
+        if (Buffer.Offset.compare_exchange_weak(Offset, End, std::memory_order_relaxed))
+        {
+            Buffer.Allocations.fetch_add(1, std::memory_order_relaxed);
+            return Buffer.Base + Aligned;
+        }
+    }
+
+    // Out of room this frame: borrow from the heap and remember to grow the buffer on reset.
+    void* Memory = FMemory::Malloc(Size, Alignment);
+    FScopeLock Lock(&Buffer.FallbackLock);
+    Buffer.Fallbacks.Add(Memory);
+    Buffer.FallbackBytes += Size + Alignment;
+    return Memory;
+}
+
+bool FFrameArena::TryResize(void* Ptr, SIZE_T OldSize, SIZE_T NewSize)
+{
+    FBuffer& Buffer = Buffers[CurrentBuffer.load(std::memory_order_acquire)];
+    uint8* Bytes = (uint8*)Ptr;
+    if (Bytes < Buffer.Base || Bytes >= Buffer.Base + Buffer.Capacity)
+        return false;
+
+    const SIZE_T Start = Bytes - Buffer.Base;
+    if (Start + NewSize > Buffer.Capacity)
+        return false;
+
+    // Only succeeds if nothing was allocated after Ptr.
+    SIZE_T Expected = Start + OldSize;
+    return Buffer.Offset.compare_exchange_strong(Expected, Start + NewSize, std::memory_order_relaxed);
+}
+
+void FFrameArena::ResetBuffer(FBuffer& Buffer)
+{
+    for (void* Memory : Buffer.Fallbacks)
+    {
+        FMemory::Free(Memory);
+    }
+    Buffer.Fallbacks.Reset();
+
+    // Enlarge once so the same workload fits next time.
+    if (Buffer.FallbackBytes > 0 && Buffer.Base != nullptr)
+    {
+        Buffer.Capacity = FMath::RoundUpToPowerOfTwo64(Buffer.Capacity + Buffer.FallbackBytes);
+        FMemory::Free(Buffer.Base);
+        Buffer.Base = (uint8*)FMemory::Malloc(Buffer.Capacity, PLATFORM_CACHE_LINE_SIZE);
+    }
+    Buffer.FallbackBytes = 0;
+
+    Buffer.Offset.store(0, std::memory_order_relaxed);
+    Buffer.Allocations.store(0, std::memory_order_relaxed);
+}
+
+void FFrameArena::EndFrame()
+{
+    const int32 Current = CurrentBuffer.load(std::memory_order_relaxed);
+    FBuffer& Finished = Buffers[Current];
+
+    LastFrameStats.Allocations = Finished.Allocations.load(std::memory_order_relaxed);
+    LastFrameStats.Bytes = (int64)Finished.Offset.load(std::memory_order_relaxed);
+    LastFrameStats.Capacity = (int64)Finished.Capacity;
+    {
+        FScopeLock Lock(&Finished.FallbackLock);
+        LastFrameStats.HeapFallbacks = Finished.Fallbacks.Num();
+    }
+
+    // The finished frame's memory stays valid for one more frame; the frame before it is recycled now.
+    const int32 Next = 1 - Current;
+    ResetBuffer(Buffers[Next]);
+    CurrentBuffer.store(Next, std::memory_order_release);
+}
@@ -0,0 +1,229 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * FFrameArena:
+ * Per-frame linear (bump) allocator for temporaries (query results, scratch lists, search state).
+ * * Design:
+ * - Two buffers, double-buffered: memory handed out in frame N stays valid through frame N + 1, so a job
+ *   started late in a frame may still read its inputs. The older buffer is reset at the end of every frame.
+ * - Allocation is a lock-free bump of an atomic offset, so worker threads can allocate too.
+ * - There is no per-allocation free; growing the most recent allocation extends it in place.
+ * - If a buffer runs out, the request falls back to the heap (counted) and the buffer is enlarged the next
+ *   time it is reset, so the arena sizes itself and steady-state frames never touch the general heap.
+ * * Time Complexity: Allocate O(1), EndFrame O(f) where f = heap fallbacks in the recycled buffer.
+ * * The first call to Get must come from the game thread (it hooks the end of the engine frame).
+ */
+class PROJECT_GOLDFISH_API FFrameArena
+{
+public:
+    struct FStats
+    {
+        // Arena allocations and bytes handed out (including alignment padding).
+        int32 Allocations = 0;
+        int64 Bytes = 0;
+
+        // Requests that did not fit and went to the general heap.
+        int32 HeapFallbacks = 0;
+
+        // Size of the buffer that served the frame.
+        int64 Capacity = 0;
+    };
+
+    static FFrameArena& Get();
+
+    ~FFrameArena();
+
+    FFrameArena(const FFrameArena&) = delete;
+    FFrameArena& operator=(const FFrameArena&) = delete;
+
+    // Allocate Size bytes valid until the end of the next frame.
+    void* Allocate(SIZE_T Size, uint32 Alignment);
+
+    // Resize the most recent allocation of the current frame in place. Returns false if Ptr is not at the top.
+    bool TryResize(void* Ptr, SIZE_T OldSize, SIZE_T NewSize);
+
+    // Frame boundary (game thread): the current buffer becomes the previous one and the oldest is reset.
+    void EndFrame();
+
+    // Stats of the last completed frame.
+    FStats GetLastFrameStats() const { return LastFrameStats; }
+
+private:
+    static constexpr SIZE_T InitialCapacity = 256 * 1024;
+
+    struct FBuffer
+    {
+        uint8* Base = nullptr;
+        SIZE_T Capacity = 0;
+        std::atomic<SIZE_T> Offset{ 0 };
+        std::atomic<int32> Allocations{ 0 };
+
+        // Heap fallbacks made while this buffer was current (freed when it is reset).
+        FCriticalSection FallbackLock;
+        TArray<void*> Fallbacks;
+        SIZE_T FallbackBytes = 0;
+    };
+
+    FBuffer Buffers[2];
+    std::atomic<int32> CurrentBuffer{ 0 };
+    FStats LastFrameStats;
+
+    FFrameArena();
+
+    void ResetBuffer(FBuffer& Buffer);
+};
+
+/**
+ * FFrameArrayAllocator:
+ * TArray allocator policy backed by FFrameArena.
+ * Use it for arrays that never outlive the next frame (see TFrameArray). Destroying the array frees nothing;
+ * the memory is recycled when the arena buffer is reset.
+ */
+class FFrameArrayAllocator
+{
+public:
+    using SizeType = int32;
+
+    enum { NeedsElementType = false };
+    enum { RequireRangeCheck = true };
+
+    class ForAnyElementType
+    {
+    public:
+        ForAnyElementType() = default;
+
+        ForAnyElementType(const ForAnyElementType&) = delete;
+        ForAnyElementType& operator=(const ForAnyElementType&) = delete;
+
+        void MoveToEmpty(ForAnyElementType& Other)
+        {
+            check(this != &Other);
+            Data = Other.Data;
+            AllocatedBytes = Other.AllocatedBytes;
+            Other.Data = nullptr;
+            Other.AllocatedBytes = 0;
+        }
+
+        FScriptContainerElement* GetAllocation() const
+        {
+            return Data;
+        }
+
+        void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement)
+        {
+            ResizeAllocation(CurrentNum, NewMax, NumBytesPerElement, DEFAULT_ALIGNMENT);
+        }
+
+        void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement)
+        {
+            const SIZE_T NewBytes = (SIZE_T)NewMax * NumBytesPerElement;
+            FFrameArena& Arena = FFrameArena::Get();
+
+            if (NewMax == 0)
+            {
+                // Give the block back if it is still at the top of the arena.
+                if (Data != nullptr)
+                {
+                    Arena.TryResize(Data, AllocatedBytes, 0);
+                }
+                Data = nullptr;
+                AllocatedBytes = 0;
+                return;
+            }
+
+            // Top of the arena: grow or shrink in place, no copy.
+            if (Data != nullptr && Arena.TryResize(Data, AllocatedBytes, NewBytes))
+            {
+                AllocatedBytes = NewBytes;
+                return;
+            }
+
+            // Shrinking elsewhere keeps the existing block (nothing to give back to a bump allocator).
+            if (NewBytes <= AllocatedBytes)
+                return;
+
+            FScriptContainerElement* NewData = (FScriptContainerElement*)Arena.Allocate(NewBytes, FMath::Max<uint32>(AlignmentOfElement, alignof(void*)));
+            if (Data != nullptr && CurrentNum > 0)
+            {
+                FMemory::Memcpy(NewData, Data, (SIZE_T)CurrentNum * NumBytesPerElement);
+            }
+            Data = NewData;
+            AllocatedBytes = NewBytes;
+        }
+
+        SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement) const
+        {
+            return DefaultCalculateSlackReserve(NewMax, NumBytesPerElement, false);
+        }
+
+        SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement) const
+        {
+            return DefaultCalculateSlackReserve(NewMax, NumBytesPerElement, false, AlignmentOfElement);
+        }
+
+        SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+        {
+            return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false);
+        }
+
+        SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement) const
+        {
+            return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false, AlignmentOfElement);
+        }
+
+        SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+        {
+            return DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false);
+        }
+
+        SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement) const
+        {
+            return DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false, AlignmentOfElement);
+        }
+
+        SIZE_T GetAllocatedSize(SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+        {
+            return (SIZE_T)CurrentMax * NumBytesPerElement;
+        }
+
+        bool HasAllocation() const
+        {
+            return Data != nullptr;
+        }
+
+        SizeType GetInitialCapacity() const
+        {
+            return 0;
+        }
+
+    private:
+        FScriptContainerElement* Data = nullptr;
+        SIZE_T AllocatedBytes = 0;
+    };
+
+    template<typename ElementType>
+    class ForElementType : public ForAnyElementType
+    {
+    public:
+        ElementType* GetAllocation() const
+        {
+            return (ElementType*)ForAnyElementType::GetAllocation();
+        }
+    };
+};
+
+template <>
+struct TAllocatorTraits<FFrameArrayAllocator> : TAllocatorTraitsBase<FFrameArrayAllocator>
+{
+    enum { IsZeroConstruct = true };
+    enum { SupportsElementAlignment = true };
+};
+
+// Array whose storage lives in the frame arena. Valid until the end of the next frame; never store one in a member.
+template<typename T>
+using TFrameArray = TArray<T, FFrameArrayAllocator>;
@@ -0,0 +1,537 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Compression.h"
+#include "GameStateSnapshot.h"
+#include "GameStateBinaryFormat.generated.h"
+
+/**
+ * EGameStateCodec:
+ * Compression codec applied to the sections of a binary slot. Stored per slot in the header.
+ * LZ4 favours encode/decode speed, Oodle (Kraken) and Zlib favour ratio.
+ */
+UENUM(BlueprintType)
+enum class EGameStateCodec : uint8
+{
+    None  = 0,
+    LZ4   = 1,
+    Oodle = 2,
+    Zlib  = 3
+};
+
+/**
+ * FGameStateCodecStats:
+ * Result row of UGameStateManager::BenchmarkCodecs.
+ */
+USTRUCT(BlueprintType)
+struct FGameStateCodecStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    EGameStateCodec Codec = EGameStateCodec::None;
+
+    // Raw bytes / stored bytes (higher is better).
+    UPROPERTY(BlueprintReadOnly)
+    float Ratio = 1.0f;
+
+    // Throughput in MB/s measured on the raw (uncompressed) size.
+    UPROPERTY(BlueprintReadOnly)
+    float EncodeMBps = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly)
+    float DecodeMBps = 0.0f;
+};
+
+/**
+ * GameStateBinary:
+ * Compact, versioned binary format for FGameStateSnapshot.
+ *
+ * File Layout (little-endian, every section 4-byte aligned):
+ * - FHeader           : fixed size, holds player scalars, counts and section offsets.
+ * - Positions Section : SoA arrays int16 X[n], int16 Y[n], int16 Z[n] (quantized).
+ * - Health Section    : uint16 Health[n] (clamped).
+ *
+ * Optional Compression Stage (per slot, tagged in the header):
+ * - Delta: each quantized axis array is stored as differences between neighbours,
+ *   which turns clustered positions into long runs of small values.
+ * - Codec: everything after the header is compressed with the chosen EGameStateCodec.
+ * The header itself is never compressed, so the codec can be read before decoding.
+ * Compressed or delta-encoded slots are decoded once into memory before viewing.
+ *
+ * Positions are quantized relative to the snapshot's bounding box centre, so the
+ * error is at most half of the stored step (~0.15 units for a 10000 unit arena).
+ *
+ * Because the layout is fixed, a reader can map the file and read every section
+ * in place through FGameStateBinaryView without per-field deserialization.
+ *
+ * Time Complexity:
+ * - Encode: O(n) where n is the number of enemies
+ * - View Initialize: O(1) (header validation only)
+ * - Per-enemy access: O(1)
+ */
+namespace GameStateBinary
+{
+    // 'GSB1' read as a little-endian uint32.
+    static constexpr uint32 Magic = 0x31425347;
+
+    // Bump whenever the header or a section layout changes.
+    // Version 2 split the old Flags field into Codec + Flags; version 1 files read as uncompressed.
+    static constexpr uint16 CurrentVersion = 2;
+    static constexpr uint16 MinSupportedVersion = 1;
+
+    // FHeader::Flags bits.
+    static constexpr uint8 FlagDeltaPositions = 1 << 0;
+
+    // File extension used next to the USaveGame ".sav" slots.
+    static const TCHAR* const FileExtension = TEXT(".gsb");
+
+    // Section alignment so in-place reads of int16/uint16 arrays are always aligned.
+    static constexpr uint32 SectionAlignment = 4;
+
+    struct FHeader
+    {
+        uint32 Magic;
+        uint16 Version;
+        uint8 Codec;
+        uint8 Flags;
+        uint32 HeaderSize;
+        uint32 TotalSize;
+
+        int32 PlayerHealth;
+        int32 PlayerPoints;
+        int32 CurrentWave;
+        int32 WaveKills;
+        int32 CurrentAmmo;
+        int32 HolsteredAmmo;
+        float Timestamp;
+
+        uint32 EnemyCount;
+
+        // Dequantization: Position = Origin + Quantized * Step.
+        float QuantOrigin[3];
+        float QuantStep;
+
+        uint32 PositionsOffset;
+        uint32 HealthOffset;
+    };
+
+    static_assert(sizeof(FHeader) == 72, "GameStateBinary::FHeader layout changed; bump CurrentVersion.");
+
+    inline uint32 AlignSection(uint32 Offset)
+    {
+        return (Offset + SectionAlignment - 1) & ~(SectionAlignment - 1);
+    }
+
+    // Returns the on-disk path for a binary slot (stored beside the USaveGame slots).
+    inline FString GetSlotPath(const FString& SlotName)
+    {
+        return FPaths::ProjectSavedDir() / TEXT("SaveGames") / (SlotName + FileExtension);
+    }
+
+    /**
+     * Encodes a snapshot into the compact binary layout.
+     * Time Complexity: O(n)
+     */
+    inline void Encode(const FGameStateSnapshot& Snapshot, TArray<uint8>& OutData)
+    {
+        const int32 EnemyCount = Snapshot.EnemyPositions.Num();
+
+        // Compute the bounding box used for quantization.
+        FVector Min(0.0f);
+        FVector Max(0.0f);
+        if (EnemyCount > 0)
+        {
+            Min = Max = Snapshot.EnemyPositions[0];
+            for (const FVector& Position : Snapshot.EnemyPositions)
+            {
+                Min = Min.ComponentMin(Position);
+                Max = Max.ComponentMax(Position);
+            }
+        }
+
+        const FVector Origin = (Min + Max) * 0.5f;
+        const float MaxHalfExtent = static_cast<float>(((Max - Min) * 0.5f).GetMax());
+        const float Step = MaxHalfExtent > KINDA_SMALL_NUMBER ? MaxHalfExtent / MAX_int16 : 1.0f;
+
+        // Lay out sections.
+        const uint32 PositionsOffset = AlignSection(sizeof(FHeader));
+        const uint32 HealthOffset = AlignSection(PositionsOffset + EnemyCount * 3 * sizeof(int16));
+        const uint32 TotalSize = AlignSection(HealthOffset + EnemyCount * sizeof(uint16));
+
+        OutData.Reset();
+        OutData.SetNumZeroed(TotalSize);
+
+        FHeader& Header = *reinterpret_cast<FHeader*>(OutData.GetData());
+        Header.Magic = Magic;
+        Header.Version = CurrentVersion;
+        Header.Codec = (uint8)EGameStateCodec::None;
+        Header.Flags = 0;
+        Header.HeaderSize = sizeof(FHeader);
+        Header.TotalSize = TotalSize;
+        Header.PlayerHealth = Snapshot.PlayerHealth;
+        Header.PlayerPoints = Snapshot.PlayerPoints;
+        Header.CurrentWave = Snapshot.CurrentWave;
+        Header.WaveKills = Snapshot.WaveKills;
+        Header.CurrentAmmo = Snapshot.CurrentAmmo;
+        Header.HolsteredAmmo = Snapshot.HolsteredAmmo;
+        Header.Timestamp = Snapshot.Timestamp;
+        Header.EnemyCount = EnemyCount;
+        Header.QuantOrigin[0] = static_cast<float>(Origin.X);
+        Header.QuantOrigin[1] = static_cast<float>(Origin.Y);
+        Header.QuantOrigin[2] = static_cast<float>(Origin.Z);
+        Header.QuantStep = Step;
+        Header.PositionsOffset = PositionsOffset;
+        Header.HealthOffset = HealthOffset;
+
+        // Structure of Arrays: all X values, then all Y values, then all Z values.
+        int16* PosX = reinterpret_cast<int16*>(OutData.GetData() + PositionsOffset);
+        int16* PosY = PosX + EnemyCount;
+        int16* PosZ = PosY + EnemyCount;
+        const float InvStep = 1.0f / Step;
+
+        for (int32 i = 0; i < EnemyCount; ++i)
+        {
+            const FVector Local = (Snapshot.EnemyPositions[i] - Origin) * InvStep;
+            PosX[i] = static_cast<int16>(FMath::Clamp<int32>(FMath::RoundToInt(Local.X), MIN_int16, MAX_int16));
+            PosY[i] = static_cast<int16>(FMath::Clamp<int32>(FMath::RoundToInt(Local.Y), MIN_int16, MAX_int16));
+            PosZ[i] = static_cast<int16>(FMath::Clamp<int32>(FMath::RoundToInt(Local.Z), MIN_int16, MAX_int16));
+        }
+
+        uint16* Health = reinterpret_cast<uint16*>(OutData.GetData() + HealthOffset);
+        for (int32 i = 0; i < EnemyCount; ++i)
+        {
+            const int32 Value = Snapshot.EnemyHealthValues.IsValidIndex(i) ? Snapshot.EnemyHealthValues[i] : 0;
+            Health[i] = static_cast<uint16>(FMath::Clamp<int32>(Value, 0, MAX_uint16));
+        }
+    }
+
+    // Maps a codec tag to the engine compression format. NAME_None means "store raw".
+    inline FName GetCodecFormatName(EGameStateCodec Codec)
+    {
+        switch (Codec)
+        {
+        case EGameStateCodec::LZ4:   return NAME_LZ4;
+        case EGameStateCodec::Oodle: return NAME_Oodle;
+        case EGameStateCodec::Zlib:  return NAME_Zlib;
+        default:                     return NAME_None;
+        }
+    }
+
+    // True if the codec can be used on this platform/build.
+    inline bool IsCodecAvailable(EGameStateCodec Codec)
+    {
+        const FName FormatName = GetCodecFormatName(Codec);
+        return FormatName == NAME_None || FCompression::IsFormatValid(FormatName);
+    }
+
+    // Applies (or reverts) delta coding to each quantized axis array. Wrapping int16 arithmetic keeps it lossless.
+    inline void DeltaEncodePositions(int16* Positions, int32 Count)
+    {
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            int16* Values = Positions + Axis * Count;
+            for (int32 i = Count - 1; i > 0; --i)
+            {
+                Values[i] = static_cast<int16>(static_cast<uint16>(Values[i]) - static_cast<uint16>(Values[i - 1]));
+            }
+        }
+    }
+
+    inline void DeltaDecodePositions(int16* Positions, int32 Count)
+    {
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            int16* Values = Positions + Axis * Count;
+            for (int32 i = 1; i < Count; ++i)
+            {
+                Values[i] = static_cast<int16>(static_cast<uint16>(Values[i]) + static_cast<uint16>(Values[i - 1]));
+            }
+        }
+    }
+
+    /**
+     * Compression stage: turns raw Encode() output into the bytes written to disk.
+     * Falls back to storing raw sections if the codec is unavailable or does not shrink the payload.
+     * Time Complexity: O(n) + codec cost
+     */
+    inline void Compress(const TArray<uint8>& RawData, EGameStateCodec Codec, bool bDeltaPositions, TArray<uint8>& OutFileData)
+    {
+        TArray<uint8> Working = RawData;
+        FHeader& Header = *reinterpret_cast<FHeader*>(Working.GetData());
+
+        if (bDeltaPositions && Header.EnemyCount > 1)
+        {
+            DeltaEncodePositions(reinterpret_cast<int16*>(Working.GetData() + Header.PositionsOffset), Header.EnemyCount);
+            Header.Flags |= FlagDeltaPositions;
+        }
+
+        const int32 PayloadSize = Working.Num() - (int32)Header.HeaderSize;
+        const FName FormatName = GetCodecFormatName(Codec);
+
+        if (FormatName != NAME_None && PayloadSize > 0)
+        {
+            if (!FCompression::IsFormatValid(FormatName))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[Binary Snapshot] Codec %s unavailable, storing slot uncompressed"),
+                    *FormatName.ToString());
+            }
+            else
+            {
+                int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, PayloadSize);
+                OutFileData.SetNumUninitialized(Header.HeaderSize + CompressedSize);
+
+                const ECompressionFlags CompressionFlags = (Codec == EGameStateCodec::LZ4) ? COMPRESS_BiasSpeed : COMPRESS_NoFlags;
+                if (FCompression::CompressMemory(FormatName, OutFileData.GetData() + Header.HeaderSize, CompressedSize,
+                                                 Working.GetData() + Header.HeaderSize, PayloadSize, CompressionFlags) &&
+                    CompressedSize < PayloadSize)
+                {
+                    Header.Codec = (uint8)Codec;
+                    FMemory::Memcpy(OutFileData.GetData(), &Header, Header.HeaderSize);
+                    OutFileData.SetNum(Header.HeaderSize + CompressedSize);
+                    return;
+                }
+            }
+        }
+
+        // Store sections raw (possibly still delta coded).
+        Header.Codec = (uint8)EGameStateCodec::None;
+        OutFileData = MoveTemp(Working);
+    }
+
+    /**
+     * Reverses Compress(): produces raw sections that FGameStateBinaryView can read in place.
+     * Time Complexity: O(n) + codec cost
+     */
+    inline bool Decode(const uint8* FileData, int64 FileSize, TArray<uint8>& OutRawData)
+    {
+        if (FileData == nullptr || FileSize < (int64)sizeof(FHeader))
+        {
+            return false;
+        }
+
+        const FHeader& FileHeader = *reinterpret_cast<const FHeader*>(FileData);
+        if (FileHeader.Magic != Magic || FileHeader.Version < MinSupportedVersion || FileHeader.Version > CurrentVersion ||
+            FileHeader.HeaderSize != sizeof(FHeader) || FileHeader.TotalSize < FileHeader.HeaderSize)
+        {
+            return false;
+        }
+
+        const int32 RawPayloadSize = FileHeader.TotalSize - FileHeader.HeaderSize;
+        const int64 StoredPayloadSize = FileSize - FileHeader.HeaderSize;
+
+        OutRawData.SetNumUninitialized(FileHeader.TotalSize);
+        FMemory::Memcpy(OutRawData.GetData(), FileData, FileHeader.HeaderSize);
+
+        const FName FormatName = GetCodecFormatName((EGameStateCodec)FileHeader.Codec);
+        if (FormatName == NAME_None)
+        {
+            if (StoredPayloadSize < RawPayloadSize)
+            {
+                return false; // Truncated.
+            }
+            FMemory::Memcpy(OutRawData.GetData() + FileHeader.HeaderSize, FileData + FileHeader.HeaderSize, RawPayloadSize);
+        }
+        else if (!FCompression::UncompressMemory(FormatName, OutRawData.GetData() + FileHeader.HeaderSize, RawPayloadSize,
+                                                 FileData + FileHeader.HeaderSize, (int32)StoredPayloadSize))
+        {
+            return false;
+        }
+
+        FHeader& RawHeader = *reinterpret_cast<FHeader*>(OutRawData.GetData());
+        if ((RawHeader.Flags & FlagDeltaPositions) &&
+            RawHeader.PositionsOffset + (int64)RawHeader.EnemyCount * 3 * sizeof(int16) <= RawHeader.TotalSize)
+        {
+            DeltaDecodePositions(reinterpret_cast<int16*>(OutRawData.GetData() + RawHeader.PositionsOffset), RawHeader.EnemyCount);
+        }
+
+        RawHeader.Codec = (uint8)EGameStateCodec::None;
+        RawHeader.Flags = 0;
+        return true;
+    }
+}
+
+/**
+ * FGameStateBinaryView:
+ * Non-owning, zero-copy view over an encoded snapshot.
+ * Sections are read in place from whatever memory backs the data (mapped file or array).
+ */
+class FGameStateBinaryView
+{
+private:
+    const uint8* Data;
+    int64 DataSize;
+
+    const GameStateBinary::FHeader* Header() const
+    {
+        return reinterpret_cast<const GameStateBinary::FHeader*>(Data);
+    }
+
+public:
+    FGameStateBinaryView()
+        : Data(nullptr), DataSize(0)
+    {
+    }
+
+    /**
+     * Validates the header and section bounds. Does not touch the sections themselves.
+     * Time Complexity: O(1)
+     */
+    bool Initialize(const uint8* InData, int64 InSize)
+    {
+        Data = nullptr;
+        DataSize = 0;
+
+        if (InData == nullptr || InSize < (int64)sizeof(GameStateBinary::FHeader))
+        {
+            return false;
+        }
+
+        const GameStateBinary::FHeader* InHeader = reinterpret_cast<const GameStateBinary::FHeader*>(InData);
+        if (InHeader->Magic != GameStateBinary::Magic ||
+            InHeader->Version < GameStateBinary::MinSupportedVersion ||
+            InHeader->Version > GameStateBinary::CurrentVersion)
+        {
+            return false;
+        }
+
+        // Only raw sections can be read in place; encoded slots go through GameStateBinary::Decode first.
+        if (InHeader->Codec != (uint8)EGameStateCodec::None || InHeader->Flags != 0)
+        {
+            return false;
+        }
+
+        // Reject truncated files and sections that would read past the end.
+        const int64 Count = InHeader->EnemyCount;
+        if ((int64)InHeader->TotalSize > InSize ||
+            InHeader->PositionsOffset + Count * 3 * (int64)sizeof(int16) > InHeader->TotalSize ||
+            InHeader->HealthOffset + Count * (int64)sizeof(uint16) > InHeader->TotalSize)
+        {
+            return false;
+        }
+
+        Data = InData;
+        DataSize = InSize;
+        return true;
+    }
+
+    bool IsValid() const { return Data != nullptr; }
+
+    const GameStateBinary::FHeader& GetHeader() const { return *Header(); }
+    int32 GetEnemyCount() const { return IsValid() ? (int32)Header()->EnemyCount : 0; }
+
+    // Raw SoA sections for callers that want to iterate without dequantizing.
+    const int16* GetPositionsX() const { return reinterpret_cast<const int16*>(Data + Header()->PositionsOffset); }
+    const int16* GetPositionsY() const { return GetPositionsX() + GetEnemyCount(); }
+    const int16* GetPositionsZ() const { return GetPositionsY() + GetEnemyCount(); }
+    const uint16* GetHealthValues() const { return reinterpret_cast<const uint16*>(Data + Header()->HealthOffset); }
+
+    // Dequantize a single enemy position in place.
+    FVector GetEnemyPosition(int32 Index) const
+    {
+        const GameStateBinary::FHeader& H = *Header();
+        return FVector(
+            H.QuantOrigin[0] + GetPositionsX()[Index] * H.QuantStep,
+            H.QuantOrigin[1] + GetPositionsY()[Index] * H.QuantStep,
+            H.QuantOrigin[2] + GetPositionsZ()[Index] * H.QuantStep);
+    }
+
+    int32 GetEnemyHealth(int32 Index) const
+    {
+        return GetHealthValues()[Index];
+    }
+
+    /**
+     * Expands the view into a full FGameStateSnapshot (only needed by Blueprint-facing APIs).
+     * Time Complexity: O(n)
+     */
+    void ToSnapshot(FGameStateSnapshot& OutSnapshot) const
+    {
+        const GameStateBinary::FHeader& H = *Header();
+        OutSnapshot.PlayerHealth = H.PlayerHealth;
+        OutSnapshot.PlayerPoints = H.PlayerPoints;
+        OutSnapshot.CurrentWave = H.CurrentWave;
+        OutSnapshot.WaveKills = H.WaveKills;
+        OutSnapshot.CurrentAmmo = H.CurrentAmmo;
+        OutSnapshot.HolsteredAmmo = H.HolsteredAmmo;
+        OutSnapshot.Timestamp = H.Timestamp;
+
+        const int32 Count = GetEnemyCount();
+        OutSnapshot.EnemyPositions.SetNumUninitialized(Count);
+        OutSnapshot.EnemyHealthValues.SetNumUninitialized(Count);
+        for (int32 i = 0; i < Count; ++i)
+        {
+            OutSnapshot.EnemyPositions[i] = GetEnemyPosition(i);
+            OutSnapshot.EnemyHealthValues[i] = GetEnemyHealth(i);
+        }
+    }
+};
+
+/**
+ * FGameStateBinaryFile:
+ * Owns the memory behind a binary snapshot.
+ * Prefers a read-only memory mapping; falls back to a single bulk read on platforms without mapping support.
+ * Encoded slots (compressed and/or delta-coded) are decoded into an owned buffer before viewing.
+ */
+class FGameStateBinaryFile
+{
+private:
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    TArray<uint8> DecodedData;
+    FGameStateBinaryView View;
+
+public:
+    bool Open(const FString& Path)
+    {
+        Close();
+
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        MappedHandle.Reset(PlatformFile.OpenMapped(*Path));
+        if (MappedHandle.IsValid())
+        {
+            MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+            if (MappedRegion.IsValid())
+            {
+                // Raw slots are read straight out of the mapping.
+                if (View.Initialize(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+                {
+                    return true;
+                }
+
+                // Compressed or delta-coded slots: decode once from the mapping, then drop it.
+                const bool bDecoded = GameStateBinary::Decode(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), DecodedData);
+                MappedRegion.Reset();
+                MappedHandle.Reset();
+                return bDecoded && View.Initialize(DecodedData.GetData(), DecodedData.Num());
+            }
+            MappedHandle.Reset();
+        }
+
+        // Mapping not supported: read the whole file once, still no per-field parsing.
+        TArray<uint8> FileData;
+        if (FFileHelper::LoadFileToArray(FileData, *Path, FILEREAD_Silent) &&
+            GameStateBinary::Decode(FileData.GetData(), FileData.Num(), DecodedData))
+        {
+            return View.Initialize(DecodedData.GetData(), DecodedData.Num());
+        }
+
+        return false;
+    }
+
+    void Close()
+    {
+        View = FGameStateBinaryView();
+        MappedRegion.Reset();
+        MappedHandle.Reset();
+        DecodedData.Empty();
+    }
+
+    bool IsMapped() const { return MappedRegion.IsValid(); }
+    const FGameStateBinaryView& GetView() const { return View; }
+};
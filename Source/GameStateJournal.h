@@ -0,0 +1,419 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "GameStateSnapshot.h"
+#include "GameStateBinaryFormat.h"
+
+/**
+ * FGameStateJournal:
+ * Append-only, crash-safe autosave journal.
+ *
+ * Files (in Saved/SaveGames):
+ * - <Slot>.gsb : Base snapshot in the compact binary format, rewritten only on compaction.
+ * - <Slot>.gsj : Journal. A file header naming the base (by CRC), followed by delta records.
+ *
+ * Record Layout: FRecordHeader { Magic, PayloadSize, PayloadCrc, Sequence } + payload.
+ * The payload only holds the scalars and enemies that changed since the previous record,
+ * so a typical autosave is a few hundred bytes instead of a full slot.
+ *
+ * Crash Safety:
+ * - Records are appended and flushed; recovery stops at the first truncated or corrupt record,
+ *   so a torn write only loses the autosave that was in flight.
+ * - Compaction writes the new base and the new journal to temp files and moves them into place.
+ *   A journal whose BaseCrc does not match the current base is ignored, so a crash between the
+ *   two moves falls back to the (already complete) new base.
+ *
+ * Time Complexity:
+ * - Append: O(n) diff against the previous state, O(k) bytes written for k changes
+ * - Compact: O(n) + one full slot write
+ * - Recover: O(n + r) where r is the number of journal records
+ */
+class FGameStateJournal
+{
+private:
+    static constexpr uint32 FileMagic = 0x314A5347;   // 'GSJ1'
+    static constexpr uint32 RecordMagic = 0x524A5347; // 'GSJR'
+    static constexpr uint32 FileVersion = 1;
+
+    struct FFileHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 BaseCrc;
+        uint32 Reserved;
+    };
+
+    struct FRecordHeader
+    {
+        uint32 Magic;
+        uint32 PayloadSize;
+        uint32 PayloadCrc;
+        uint32 Sequence;
+    };
+
+    // Bits of the scalar change mask stored at the start of every payload.
+    enum EChangedField : uint8
+    {
+        Changed_PlayerHealth  = 1 << 0,
+        Changed_PlayerPoints  = 1 << 1,
+        Changed_CurrentWave   = 1 << 2,
+        Changed_WaveKills     = 1 << 3,
+        Changed_CurrentAmmo   = 1 << 4,
+        Changed_HolsteredAmmo = 1 << 5
+    };
+
+    // Enemies that moved less than this are not journaled.
+    static constexpr float PositionTolerance = 1.0f;
+
+    FString SlotName;
+    TUniquePtr<FArchive> Writer;
+    // True between Open and Close. Writer can be missing meanwhile if a compaction failed half-way;
+    // the next Append retries it.
+    bool bActive;
+    FGameStateSnapshot LastState;
+    uint32 NextSequence;
+    int32 CompactEvery;
+
+    // Statistics.
+    int32 RecordsSinceCompaction;
+    int32 TotalRecords;
+    int64 TotalRecordBytes;
+    int32 Compactions;
+
+    // Write to a temp file and move it over the destination so readers never see a partial file.
+    static bool SaveAtomically(const TArray<uint8>& Data, const FString& Path)
+    {
+        const FString TempPath = Path + TEXT(".tmp");
+        return FFileHelper::SaveArrayToFile(Data, *TempPath) && IFileManager::Get().Move(*Path, *TempPath, true);
+    }
+
+    void CloseWriter()
+    {
+        if (Writer.IsValid())
+        {
+            Writer->Close();
+            Writer.Reset();
+        }
+    }
+
+    static void WriteDelta(const FGameStateSnapshot& From, const FGameStateSnapshot& To, TArray<uint8>& OutPayload)
+    {
+        FMemoryWriter Ar(OutPayload);
+
+        uint8 Mask = 0;
+        if (From.PlayerHealth != To.PlayerHealth)   Mask |= Changed_PlayerHealth;
+        if (From.PlayerPoints != To.PlayerPoints)   Mask |= Changed_PlayerPoints;
+        if (From.CurrentWave != To.CurrentWave)     Mask |= Changed_CurrentWave;
+        if (From.WaveKills != To.WaveKills)         Mask |= Changed_WaveKills;
+        if (From.CurrentAmmo != To.CurrentAmmo)     Mask |= Changed_CurrentAmmo;
+        if (From.HolsteredAmmo != To.HolsteredAmmo) Mask |= Changed_HolsteredAmmo;
+
+        float Timestamp = To.Timestamp;
+        Ar << Mask << Timestamp;
+
+        int32 Value;
+        if (Mask & Changed_PlayerHealth)  { Value = To.PlayerHealth;  Ar << Value; }
+        if (Mask & Changed_PlayerPoints)  { Value = To.PlayerPoints;  Ar << Value; }
+        if (Mask & Changed_CurrentWave)   { Value = To.CurrentWave;   Ar << Value; }
+        if (Mask & Changed_WaveKills)     { Value = To.WaveKills;     Ar << Value; }
+        if (Mask & Changed_CurrentAmmo)   { Value = To.CurrentAmmo;   Ar << Value; }
+        if (Mask & Changed_HolsteredAmmo) { Value = To.HolsteredAmmo; Ar << Value; }
+
+        // Enemy section: new count, then only the enemies that changed.
+        int32 EnemyCount = To.EnemyPositions.Num();
+        Ar << EnemyCount;
+
+        TArray<int32> ChangedIndices;
+        for (int32 i = 0; i < EnemyCount; ++i)
+        {
+            const int32 Health = To.EnemyHealthValues.IsValidIndex(i) ? To.EnemyHealthValues[i] : 0;
+            if (!From.EnemyPositions.IsValidIndex(i) ||
+                !From.EnemyPositions[i].Equals(To.EnemyPositions[i], PositionTolerance) ||
+                !From.EnemyHealthValues.IsValidIndex(i) || From.EnemyHealthValues[i] != Health)
+            {
+                ChangedIndices.Add(i);
+            }
+        }
+
+        int32 NumChanged = ChangedIndices.Num();
+        Ar << NumChanged;
+        for (int32 Index : ChangedIndices)
+        {
+            FVector3f Position(To.EnemyPositions[Index]);
+            int32 Health = To.EnemyHealthValues.IsValidIndex(Index) ? To.EnemyHealthValues[Index] : 0;
+            Ar << Index << Position << Health;
+        }
+    }
+
+    static bool ApplyDelta(const TArray<uint8>& Payload, FGameStateSnapshot& InOutState)
+    {
+        FMemoryReader Ar(Payload);
+
+        uint8 Mask = 0;
+        float Timestamp = 0.0f;
+        Ar << Mask << Timestamp;
+        InOutState.Timestamp = Timestamp;
+
+        if (Mask & Changed_PlayerHealth)  Ar << InOutState.PlayerHealth;
+        if (Mask & Changed_PlayerPoints)  Ar << InOutState.PlayerPoints;
+        if (Mask & Changed_CurrentWave)   Ar << InOutState.CurrentWave;
+        if (Mask & Changed_WaveKills)     Ar << InOutState.WaveKills;
+        if (Mask & Changed_CurrentAmmo)   Ar << InOutState.CurrentAmmo;
+        if (Mask & Changed_HolsteredAmmo) Ar << InOutState.HolsteredAmmo;
+
+        int32 EnemyCount = 0;
+        int32 NumChanged = 0;
+        Ar << EnemyCount << NumChanged;
+        if (Ar.IsError() || EnemyCount < 0 || NumChanged < 0 || NumChanged > EnemyCount)
+        {
+            return false;
+        }
+
+        InOutState.EnemyPositions.SetNumZeroed(EnemyCount);
+        InOutState.EnemyHealthValues.SetNumZeroed(EnemyCount);
+
+        for (int32 i = 0; i < NumChanged; ++i)
+        {
+            int32 Index = 0;
+            FVector3f Position;
+            int32 Health = 0;
+            Ar << Index << Position << Health;
+            if (Ar.IsError() || !InOutState.EnemyPositions.IsValidIndex(Index))
+            {
+                return false;
+            }
+            InOutState.EnemyPositions[Index] = FVector(Position);
+            InOutState.EnemyHealthValues[Index] = Health;
+        }
+
+        return !Ar.IsError();
+    }
+
+public:
+    // Path of the journal file that sits beside the slot's base snapshot.
+    static FString GetJournalPath(const FString& InSlotName)
+    {
+        return FPaths::ProjectSavedDir() / TEXT("SaveGames") / (InSlotName + TEXT(".gsj"));
+    }
+
+    FGameStateJournal()
+        : bActive(false)
+        , NextSequence(0)
+        , CompactEvery(32)
+        , RecordsSinceCompaction(0)
+        , TotalRecords(0)
+        , TotalRecordBytes(0)
+        , Compactions(0)
+    {
+    }
+
+    /**
+     * Start journaling a slot. Writes BaseState as the new base snapshot and an empty journal.
+     * Call Recover first to resume from an existing autosave.
+     */
+    bool Open(const FString& InSlotName, const FGameStateSnapshot& BaseState, int32 InCompactEvery = 32)
+    {
+        Close();
+        SlotName = InSlotName;
+        CompactEvery = FMath::Max(1, InCompactEvery);
+        bActive = true;
+        if (!Compact(BaseState))
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void Close()
+    {
+        CloseWriter();
+        bActive = false;
+    }
+
+    bool IsOpen() const { return bActive; }
+
+    /**
+     * Append the difference between the last journaled state and State.
+     * Compacts into a full base snapshot every CompactEvery records, and retries a failed
+     * compaction on every append until it succeeds (no deltas are written meanwhile).
+     */
+    bool Append(const FGameStateSnapshot& State)
+    {
+        if (!IsOpen())
+        {
+            return false;
+        }
+
+        if (RecordsSinceCompaction >= CompactEvery || !Writer.IsValid())
+        {
+            return Compact(State);
+        }
+
+        TArray<uint8> Payload;
+        WriteDelta(LastState, State, Payload);
+
+        FRecordHeader Header;
+        Header.Magic = RecordMagic;
+        Header.PayloadSize = Payload.Num();
+        Header.PayloadCrc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+        Header.Sequence = NextSequence++;
+
+        // Header and payload go out in one contiguous write, then flush to disk.
+        TArray<uint8> Record;
+        Record.Reserve(sizeof(FRecordHeader) + Payload.Num());
+        Record.Append(reinterpret_cast<const uint8*>(&Header), sizeof(FRecordHeader));
+        Record.Append(Payload);
+
+        Writer->Serialize(Record.GetData(), Record.Num());
+        Writer->Flush();
+        if (Writer->IsError())
+        {
+            return false;
+        }
+
+        // Track what recovery will rebuild, not State: enemies within PositionTolerance were skipped,
+        // so their last journaled position stays the baseline and slow drift is still caught.
+        ApplyDelta(Payload, LastState);
+        RecordsSinceCompaction++;
+        TotalRecords++;
+        TotalRecordBytes += Record.Num();
+        return true;
+    }
+
+    /**
+     * Fold everything into a new base snapshot and start an empty journal for it.
+     * The current journal stays open until the new journal header is staged and the new base is on
+     * disk; if any step fails the caller's next Append retries the compaction.
+     */
+    bool Compact(const FGameStateSnapshot& State)
+    {
+        TArray<uint8> RawData;
+        TArray<uint8> BaseData;
+        GameStateBinary::Encode(State, RawData);
+        GameStateBinary::Compress(RawData, EGameStateCodec::LZ4, true, BaseData);
+
+        // Stage the new journal, bound to the base about to be written.
+        FFileHeader FileHeader;
+        FileHeader.Magic = FileMagic;
+        FileHeader.Version = FileVersion;
+        FileHeader.BaseCrc = FCrc::MemCrc32(BaseData.GetData(), BaseData.Num());
+        FileHeader.Reserved = 0;
+
+        TArray<uint8> HeaderData(reinterpret_cast<const uint8*>(&FileHeader), sizeof(FFileHeader));
+        const FString JournalPath = GetJournalPath(SlotName);
+        const FString TempJournalPath = JournalPath + TEXT(".tmp");
+        if (!FFileHelper::SaveArrayToFile(HeaderData, *TempJournalPath))
+        {
+            return false;
+        }
+
+        // Until the base is replaced the old base and journal still match, so the writer stays open.
+        if (!SaveAtomically(BaseData, GameStateBinary::GetSlotPath(SlotName)))
+        {
+            return false;
+        }
+
+        // The old journal no longer matches the new base (Recover ignores it); close it so it can be
+        // replaced. If that fails, Writer stays closed and Append retries instead of writing deltas to it.
+        CloseWriter();
+        if (!IFileManager::Get().Move(*JournalPath, *TempJournalPath, true))
+        {
+            return false;
+        }
+
+        Writer.Reset(IFileManager::Get().CreateFileWriter(*JournalPath, FILEWRITE_Append));
+        if (!Writer.IsValid())
+        {
+            return false;
+        }
+
+        LastState = State;
+        NextSequence = 0;
+        RecordsSinceCompaction = 0;
+        Compactions++;
+        return true;
+    }
+
+    /**
+     * Rebuild the latest autosaved state: load the base snapshot, then replay the journal tail.
+     * Stops at the first torn or corrupt record.
+     */
+    static bool Recover(const FString& InSlotName, FGameStateSnapshot& OutState, int32& OutReplayedRecords)
+    {
+        OutReplayedRecords = 0;
+
+        TArray<uint8> BaseData;
+        TArray<uint8> RawData;
+        FGameStateBinaryView View;
+        if (!FFileHelper::LoadFileToArray(BaseData, *GameStateBinary::GetSlotPath(InSlotName), FILEREAD_Silent) ||
+            !GameStateBinary::Decode(BaseData.GetData(), BaseData.Num(), RawData) ||
+            !View.Initialize(RawData.GetData(), RawData.Num()))
+        {
+            return false;
+        }
+        View.ToSnapshot(OutState);
+
+        TArray<uint8> JournalData;
+        if (!FFileHelper::LoadFileToArray(JournalData, *GetJournalPath(InSlotName), FILEREAD_Silent) ||
+            JournalData.Num() < (int32)sizeof(FFileHeader))
+        {
+            return true; // Base only.
+        }
+
+        const FFileHeader& FileHeader = *reinterpret_cast<const FFileHeader*>(JournalData.GetData());
+        if (FileHeader.Magic != FileMagic || FileHeader.Version != FileVersion ||
+            FileHeader.BaseCrc != FCrc::MemCrc32(BaseData.GetData(), BaseData.Num()))
+        {
+            // Journal belongs to an older base (crash during compaction); the base already has its data.
+            return true;
+        }
+
+        int64 Offset = sizeof(FFileHeader);
+        uint32 ExpectedSequence = 0;
+        TArray<uint8> Payload;
+
+        while (Offset + (int64)sizeof(FRecordHeader) <= JournalData.Num())
+        {
+            FRecordHeader RecordHeader;
+            FMemory::Memcpy(&RecordHeader, JournalData.GetData() + Offset, sizeof(FRecordHeader));
+            Offset += sizeof(FRecordHeader);
+
+            if (RecordHeader.Magic != RecordMagic || RecordHeader.Sequence != ExpectedSequence ||
+                Offset + (int64)RecordHeader.PayloadSize > JournalData.Num() ||
+                RecordHeader.PayloadCrc != FCrc::MemCrc32(JournalData.GetData() + Offset, RecordHeader.PayloadSize))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[Journal] Slot '%s': discarding torn tail after record %d"),
+                    *InSlotName, OutReplayedRecords);
+                break;
+            }
+
+            Payload.SetNumUninitialized(RecordHeader.PayloadSize);
+            FMemory::Memcpy(Payload.GetData(), JournalData.GetData() + Offset, RecordHeader.PayloadSize);
+            Offset += RecordHeader.PayloadSize;
+
+            FGameStateSnapshot Next = OutState;
+            if (!ApplyDelta(Payload, Next))
+            {
+                break;
+            }
+            OutState = MoveTemp(Next);
+            OutReplayedRecords++;
+            ExpectedSequence++;
+        }
+
+        return true;
+    }
+
+    // Getters for journal statistics.
+    int32 GetTotalRecords() const { return TotalRecords; }
+    int32 GetCompactions() const { return Compactions; }
+    float GetAverageRecordBytes() const { return TotalRecords > 0 ? (float)TotalRecordBytes / TotalRecords : 0.0f; }
+};
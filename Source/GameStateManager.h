@@ -5,75 +5,22 @@
 #include "CoreMinimal.h"
 #include "GameFramework/SaveGame.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/FileManager.h"
 #include "CustomStack.h"
 #include "CustomHashMap.h"
+#include "CustomLRUCache.h"
+#include "CustomCuckooFilter.h"
+#include "CustomPersistentVector.h"
+#include "CustomPersistentMap.h"
+#include "GameStateSnapshot.h"
+#include "GameStateBinaryFormat.h"
+#include "GameStateJournal.h"
+#include "ReplayRecorder.h"
 #include "GameStateManager.generated.h"
 
-/**
- * FGameStateSnapshot:
- * Represents a complete snapshot of the game state at a given time.
- * Used for undo/redo functionality, quick saves, and state restoration.
- */
-USTRUCT(BlueprintType)
-struct FGameStateSnapshot
-{
-    GENERATED_BODY()
-
-    // Player's current health
-    UPROPERTY()
-    int32 PlayerHealth;
-
-    // Player's current points
-    UPROPERTY()
-    int32 PlayerPoints;
-
-    // Current wave index in the game
-    UPROPERTY()
-    int32 CurrentWave;
-
-    // Number of kills in the current wave
-    UPROPERTY()
-    int32 WaveKills;
-
-    // Ammo in the currently equipped weapon
-    UPROPERTY()
-    int32 CurrentAmmo;
-
-    // Ammo in reserve / holstered
-    UPROPERTY()
-    int32 HolsteredAmmo;
-
-    // Positions of all active enemies in the level
-    UPROPERTY()
-    TArray<FVector> EnemyPositions;
-
-    // Health values of all active enemies
-    UPROPERTY()
-    TArray<int32> EnemyHealthValues;
-
-    // Timestamp used to identify this snapshot
-    UPROPERTY()
-    float Timestamp;
-
-    // Default constructor initializing safe defaults
-    FGameStateSnapshot()
-        : PlayerHealth(100)
-        , PlayerPoints(0)
-        , CurrentWave(0)
-        , WaveKills(0)
-        , CurrentAmmo(0)
-        , HolsteredAmmo(0)
-        , Timestamp(0.0f)
-    {
-    }
-
-    // Equality operator to compare snapshots based on timestamp
-    bool operator==(const FGameStateSnapshot& Other) const
-    {
-        return FMath::IsNearlyEqual(Timestamp, Other.Timestamp, 0.01f);
-    }
-};
-
 /**
  * UGameStateSaveGame:
  * Unreal SaveGame object for persisting a single game state snapshot to disk.
@@ -104,13 +51,80 @@ public:
     }
 };
 
+/**
+ * FGameStateHistoryEntry:
+ * One undo/redo history entry. The scalars are stored inline and the enemy arrays as persistent vectors,
+ * so an entry shares every 32-enemy chunk that did not change with the entry before it.
+ * Copying an entry is O(1); building one from a snapshot allocates only the chunks that changed.
+ */
+struct FGameStateHistoryEntry
+{
+    int32 PlayerHealth = 100;
+    int32 PlayerPoints = 0;
+    int32 CurrentWave = 0;
+    int32 WaveKills = 0;
+    int32 CurrentAmmo = 0;
+    int32 HolsteredAmmo = 0;
+    float Timestamp = 0.0f;
+    CustomPersistentVector<FVector> EnemyPositions;
+    CustomPersistentVector<int32> EnemyHealthValues;
+
+    // Persistent form of Snapshot, sharing unchanged chunks with Previous. O(n) compare.
+    static FGameStateHistoryEntry FromSnapshot(const FGameStateSnapshot& Snapshot, const FGameStateHistoryEntry& Previous)
+    {
+        FGameStateHistoryEntry Entry;
+        Entry.PlayerHealth = Snapshot.PlayerHealth;
+        Entry.PlayerPoints = Snapshot.PlayerPoints;
+        Entry.CurrentWave = Snapshot.CurrentWave;
+        Entry.WaveKills = Snapshot.WaveKills;
+        Entry.CurrentAmmo = Snapshot.CurrentAmmo;
+        Entry.HolsteredAmmo = Snapshot.HolsteredAmmo;
+        Entry.Timestamp = Snapshot.Timestamp;
+        Entry.EnemyPositions = Previous.EnemyPositions.WithValues(Snapshot.EnemyPositions);
+        Entry.EnemyHealthValues = Previous.EnemyHealthValues.WithValues(Snapshot.EnemyHealthValues);
+        return Entry;
+    }
+
+    // Expand back into a flat snapshot. O(n).
+    void ToSnapshot(FGameStateSnapshot& OutSnapshot) const
+    {
+        OutSnapshot.PlayerHealth = PlayerHealth;
+        OutSnapshot.PlayerPoints = PlayerPoints;
+        OutSnapshot.CurrentWave = CurrentWave;
+        OutSnapshot.WaveKills = WaveKills;
+        OutSnapshot.CurrentAmmo = CurrentAmmo;
+        OutSnapshot.HolsteredAmmo = HolsteredAmmo;
+        OutSnapshot.Timestamp = Timestamp;
+        EnemyPositions.ToArray(OutSnapshot.EnemyPositions);
+        EnemyHealthValues.ToArray(OutSnapshot.EnemyHealthValues);
+    }
+
+    // Bytes of this entry not already counted in Visited (shared chunks are counted once).
+    void CountUniqueBytes(TSet<const void*>& Visited, int64& InOutBytes) const
+    {
+        InOutBytes += sizeof(FGameStateHistoryEntry);
+        EnemyPositions.CountUniqueBytes(Visited, InOutBytes);
+        EnemyHealthValues.CountUniqueBytes(Visited, InOutBytes);
+    }
+};
+
+// Replay recording: the next frame is a keyframe; answer with SubmitReplayKeyframe.
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnReplayKeyframeDue);
+
+// Replay seeking: the keyframe the world should be reset to, then one deterministic step per fast-forwarded frame.
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnReplayKeyframeRestored, const FGameStateSnapshot&, State);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnReplayStep, int32, Frame, float, DeltaTime, const TArray<FReplayInputEvent>&, Inputs);
+
 /**
  * UGameStateManager:
  * 
  * Handles:
- * - Undo/Redo history using CustomStack (O(1) push/pop)
- * - Quick save/load caching using CustomHashMap (O(1) lookup)
- * - Save/load to disk via UE5 USaveGame
+ * - Undo/Redo history using CustomStack (O(1) push/pop) of structurally shared entries (CustomPersistentVector)
+ * - Quick save/load caching using a bounded CustomLRUCache (O(1) lookup, validated against the slot file)
+ * - "Slot definitely does not exist" answered by a CustomCuckooFilter per save format (no I/O when bTrustSlotFilter)
+ * - Save/load to disk via UE5 USaveGame or the compact binary format (GameStateBinaryFormat.h)
+ * - Journaled autosave: CaptureState appends small deltas to a crash-safe journal (GameStateJournal.h)
+ * - Deterministic replays: per-frame RNG seeds, inputs and periodic keyframes (ReplayRecorder.h)
  * - Performance metrics tracking for saves and loads
  */
 UCLASS(Blueprintable, BlueprintType)
@@ -120,13 +134,16 @@ class PROJECT_GOLDFISH_API UGameStateManager : public UObject
 
 private:
     // Undo stack storing previous states
-    CustomStack<FGameStateSnapshot> UndoStack;
+    CustomStack<FGameStateHistoryEntry> UndoStack;
     
     // Redo stack storing undone states
-    CustomStack<FGameStateSnapshot> RedoStack;
+    CustomStack<FGameStateHistoryEntry> RedoStack;
+
+    // Persistent form of the state most recently moved into or out of history; new entries are diffed against it
+    FGameStateHistoryEntry LastHistoryEntry;
 
-    // Quick lookup cache for saved states
-    CustomHashMap<FString, FGameStateSnapshot> StateCache;
+    // Quick lookup cache for saved states (bounded by entry count and bytes, LRU eviction)
+    CustomLRUCache<FString, FGameStateSnapshot> StateCache;
 
     // Current active game state
     FGameStateSnapshot CurrentState;
@@ -134,16 +151,190 @@ private:
     // Maximum number of undo states stored
     int32 MaxUndoHistory;
 
+    // Append-only autosave journal; active between EnableJournaledAutosave and DisableJournaledAutosave
+    FGameStateJournal AutosaveJournal;
+
+    // Replay being recorded / the last replay opened for playback
+    FReplayRecorder ReplayRecorder;
+    FReplayPlayer ReplayPlayer;
+
+    // World whose frames are being recorded. Frames begin natively at its tick start, ahead of any
+    // gameplay code (and GameplayRandom roll); keyframe requests go out after its actors have ticked.
+    TWeakObjectPtr<UWorld> ReplayWorld;
+    FDelegateHandle ReplayTickStartHandle;
+    FDelegateHandle ReplayPostActorTickHandle;
+
+    // Snapshot handed in through SubmitReplayKeyframe for the next keyframe frame.
+    FGameStateSnapshot PendingReplayKeyframe;
+    bool bReplayKeyframeSubmitted = false;
+
+    // Slot files on disk, one filter per format. Built by a directory scan on first use; afterwards every
+    // slot file this manager writes or deletes is added or removed exactly once. Files written by anything
+    // else (another manager, SaveGameToSlot, copied in) are only picked up when a miss is checked on disk.
+    CustomCuckooFilter<FString> SaveGameSlotFilter;
+    CustomCuckooFilter<FString> BinarySlotFilter;
+    bool bSlotFiltersBuilt = false;
+
+    // Lookups the filters answered without I/O, misses confirmed on disk, "maybe" answers the disk then
+    // contradicted, and misses the disk contradicted (slot written behind this manager's back).
+    int32 SlotFilterSkippedLookups = 0;
+    int32 SlotFilterConfirmedMisses = 0;
+    int32 SlotFilterFalsePositives = 0;
+    int32 SlotFilterStaleMisses = 0;
+
     // Performance metrics
     int32 TotalSaves;
     int32 TotalLoads;
     float AverageSaveTime;
     float AverageLoadTime;
 
+    // Path UGameplayStatics uses for a USaveGame slot (user index 0).
+    static FString GetSaveGameSlotPath(const FString& SlotName)
+    {
+        return FPaths::ProjectSavedDir() / TEXT("SaveGames") / (SlotName + TEXT(".sav"));
+    }
+
+    // Cache validation stamp derived from the file's modification time and size (0 if missing).
+    static uint64 GetFileStamp(const FString& Path)
+    {
+        const FFileStatData StatData = IFileManager::Get().GetStatData(*Path);
+        if (!StatData.bIsValid)
+        {
+            return 0;
+        }
+        return (uint64)StatData.ModificationTime.GetTicks() ^ ((uint64)StatData.FileSize * 0x9E3779B97F4A7C15ull);
+    }
+
+    // Approximate memory held by a cached snapshot.
+    static int64 GetSnapshotBytes(const FString& SlotName, const FGameStateSnapshot& Snapshot)
+    {
+        return sizeof(FGameStateSnapshot)
+            + Snapshot.EnemyPositions.GetAllocatedSize()
+            + Snapshot.EnemyHealthValues.GetAllocatedSize()
+            + SlotName.GetAllocatedSize();
+    }
+
+    // Cache CurrentState for a slot, stamped with the file that was just written or read.
+    void CacheSnapshot(const FString& SlotName, const FString& Path)
+    {
+        StateCache.Insert(SlotName, CurrentState, GetSnapshotBytes(SlotName, CurrentState), GetFileStamp(Path));
+    }
+
+    // Fill both slot filters from the save directory (sized for twice the slots found, so saves have room).
+    void RebuildSlotFilters()
+    {
+        const FString SaveDir = FPaths::GetPath(GetSaveGameSlotPath(TEXT("Slot")));
+        TArray<FString> SaveGameFiles;
+        TArray<FString> BinaryFiles;
+        IFileManager::Get().FindFiles(SaveGameFiles, *SaveDir, TEXT(".sav"));
+        IFileManager::Get().FindFiles(BinaryFiles, *SaveDir, GameStateBinary::FileExtension);
+
+        SaveGameSlotFilter = CustomCuckooFilter<FString>(FMath::Max(64, SaveGameFiles.Num() * 2));
+        BinarySlotFilter = CustomCuckooFilter<FString>(FMath::Max(64, BinaryFiles.Num() * 2));
+        for (const FString& File : SaveGameFiles)
+        {
+            SaveGameSlotFilter.Add(FPaths::GetBaseFilename(File));
+        }
+        for (const FString& File : BinaryFiles)
+        {
+            BinarySlotFilter.Add(FPaths::GetBaseFilename(File));
+        }
+        bSlotFiltersBuilt = true;
+
+        UE_LOG(LogTemp, Log, TEXT("[Slot Filter] Tracking %d USaveGame and %d binary slots (%lld bytes)"),
+            SaveGameFiles.Num(), BinaryFiles.Num(), SaveGameSlotFilter.GetMemoryBytes() + BinarySlotFilter.GetMemoryBytes());
+    }
+
+    // False if the slot has no file in this format. True means "check the disk".
+    // A filter miss is final only with bTrustSlotFilter; otherwise it is confirmed at Path, and a file
+    // found there is added to the filter.
+    bool MaySlotExist(CustomCuckooFilter<FString>& Filter, const FString& SlotName, const FString& Path)
+    {
+        if (!bSlotFiltersBuilt)
+        {
+            RebuildSlotFilters();
+        }
+        if (Filter.MayContain(SlotName))
+        {
+            return true;
+        }
+        if (bTrustSlotFilter)
+        {
+            SlotFilterSkippedLookups++;
+            return false;
+        }
+        if (!IFileManager::Get().FileExists(*Path))
+        {
+            SlotFilterConfirmedMisses++;
+            return false;
+        }
+
+        UE_LOG(LogTemp, Verbose, TEXT("[Slot Filter] Slot '%s' was written outside this manager"), *SlotName);
+        SlotFilterStaleMisses++;
+        AddSlotToFilter(Filter, SlotName);
+        return true;
+    }
+
+    // Call before writing a slot file: true if the file is new and must be added to the filter once written.
+    // A slot already on disk is in the filter already, so re-saves never add duplicates.
+    bool IsNewSlotFile(const CustomCuckooFilter<FString>& Filter, const FString& SlotName, const FString& Path)
+    {
+        if (!bSlotFiltersBuilt)
+        {
+            RebuildSlotFilters();
+        }
+        return !Filter.MayContain(SlotName) || !IFileManager::Get().FileExists(*Path);
+    }
+
+    // Record a newly written slot file. A full filter is rebuilt from disk, which already includes the new file.
+    void AddSlotToFilter(CustomCuckooFilter<FString>& Filter, const FString& SlotName)
+    {
+        if (!Filter.Add(SlotName))
+        {
+            RebuildSlotFilters();
+        }
+    }
+
+    void HandleReplayTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+    {
+        // Paused worlds only tick viewports; no gameplay runs, so no frame is recorded.
+        if (World != ReplayWorld.Get() || TickType == LEVELTICK_ViewportsOnly || !ReplayRecorder.IsRecording())
+        {
+            return;
+        }
+
+        const AWorldSettings* WorldSettings = World->GetWorldSettings();
+        const float DeltaTime = DeltaSeconds * (WorldSettings != nullptr ? WorldSettings->GetEffectiveTimeDilation() : 1.0f);
+        ReplayRecorder.BeginFrame(DeltaTime, bReplayKeyframeSubmitted ? &PendingReplayKeyframe : nullptr);
+        bReplayKeyframeSubmitted = false;
+    }
+
+    void HandleReplayPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+    {
+        if (World == ReplayWorld.Get() && TickType != LEVELTICK_ViewportsOnly && IsReplayKeyframeDue())
+        {
+            OnReplayKeyframeDue.Broadcast();
+        }
+    }
+
+    // History entry for CurrentState, sharing unchanged enemy chunks with the previous entry
+    FGameStateHistoryEntry MakeHistoryEntry()
+    {
+        LastHistoryEntry = FGameStateHistoryEntry::FromSnapshot(CurrentState, LastHistoryEntry);
+        return LastHistoryEntry;
+    }
+
 public:
+    /**
+     * Treat slot filter misses as final and skip the filesystem. Only safe when every slot file is written
+     * and deleted through this manager; otherwise misses are confirmed on disk.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Game State")
+    bool bTrustSlotFilter = false;
+
     // Constructor: initializes undo stack and metrics
     UGameStateManager()
-        : MaxUndoHistory(50)
+        : MaxUndoHistory(500)
         , TotalSaves(0)
         , TotalLoads(0)
         , AverageSaveTime(0.0f)
@@ -152,10 +343,18 @@ public:
         UndoStack.SetMaxCapacity(MaxUndoHistory);
     }
 
+    // Stops a replay recording still in progress and unhooks it from the world.
+    virtual void BeginDestroy() override
+    {
+        StopReplayRecording();
+        Super::BeginDestroy();
+    }
+
     /**
      * Capture the current game state.
      * Saves the previous state to the undo stack and clears the redo stack.
-     * Time Complexity: O(1)
+     * Time Complexity: O(n) compare of the enemy arrays; only the changed chunks are allocated
+     * (O(changes * log32 n) memory per history entry).
      */
     UFUNCTION(BlueprintCallable, Category = "Game State")
     void CaptureState(int32 PlayerHealth, int32 PlayerPoints, int32 CurrentWave,
@@ -165,7 +364,7 @@ public:
         // Save previous state if it exists
         if (CurrentState.Timestamp > 0.0f)
         {
-            UndoStack.Push(CurrentState);
+            UndoStack.Push(MakeHistoryEntry());
         }
 
         // Update current state with new values
@@ -181,21 +380,226 @@ public:
 
         // Clear redo history on new state capture
         RedoStack.Clear();
+
+        // Journaled autosave: append only what changed since the last capture
+        if (AutosaveJournal.IsOpen() && !AutosaveJournal.Append(CurrentState))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[Journal] Autosave append failed; last good state is preserved on disk, retrying on the next capture"));
+        }
+    }
+
+    /**
+     * Start journaled autosaves into a slot. The current state becomes the base snapshot and
+     * every following CaptureState appends a delta record. Every CompactEvery records the
+     * journal is folded into a fresh base snapshot.
+     * Use RecoverAutosave first to resume a previous session.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Autosave")
+    bool EnableJournaledAutosave(const FString& SlotName = TEXT("Autosave"), int32 CompactEvery = 32)
+    {
+        // Opening writes the slot's binary base snapshot (which can land on disk even if the journal then fails).
+        const FString BasePath = GameStateBinary::GetSlotPath(SlotName);
+        const bool bNewSlot = IsNewSlotFile(BinarySlotFilter, SlotName, BasePath);
+        const bool bOpened = AutosaveJournal.Open(SlotName, CurrentState, CompactEvery);
+        if (bNewSlot && IFileManager::Get().FileExists(*BasePath))
+        {
+            AddSlotToFilter(BinarySlotFilter, SlotName);
+        }
+        return bOpened;
+    }
+
+    /** Stop journaling. The files on disk stay recoverable. */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Autosave")
+    void DisableJournaledAutosave()
+    {
+        AutosaveJournal.Close();
+    }
+
+    /**
+     * Rebuild the latest autosaved state from the base snapshot plus the journal tail.
+     * Time Complexity: O(n + r) where r is the number of journal records
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Autosave")
+    bool RecoverAutosave(const FString& SlotName, FGameStateSnapshot& OutRecoveredState)
+    {
+        int32 ReplayedRecords = 0;
+        if (!FGameStateJournal::Recover(SlotName, OutRecoveredState, ReplayedRecords))
+        {
+            return false;
+        }
+
+        CurrentState = OutRecoveredState;
+        UE_LOG(LogTemp, Log, TEXT("[Journal] Recovered slot '%s' (%d records replayed)"), *SlotName, ReplayedRecords);
+        return true;
+    }
+
+    /** Autosave journal statistics */
+    UFUNCTION(BlueprintPure, Category = "Game State|Autosave")
+    void GetAutosaveStats(int32& OutRecords, int32& OutCompactions, float& OutAverageRecordBytes) const
+    {
+        OutRecords = AutosaveJournal.GetTotalRecords();
+        OutCompactions = AutosaveJournal.GetCompactions();
+        OutAverageRecordBytes = AutosaveJournal.GetAverageRecordBytes();
+    }
+
+    /**
+     * Broadcast when the next recorded frame is a keyframe: once from StartReplayRecording and then after the
+     * actors of the frame before each keyframe have ticked. Bind it to build a snapshot and SubmitReplayKeyframe.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "Game State|Replay")
+    FOnReplayKeyframeDue OnReplayKeyframeDue;
+
+    /**
+     * Start recording a deterministic replay of the context object's world. Every frame from its next
+     * tick on is recorded automatically: GameplayRandom is reseeded at tick start, before any gameplay
+     * code runs, and the seed is logged. A keyframe is written every KeyframeInterval frames from the
+     * snapshot submitted in response to OnReplayKeyframeDue; those are the points SeekReplay can jump to.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Replay", meta = (WorldContext = "WorldContextObject"))
+    bool StartReplayRecording(const UObject* WorldContextObject, const FString& ReplayName, int32 KeyframeInterval = 300)
+    {
+        StopReplayRecording();
+
+        UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+        if (World == nullptr)
+        {
+            return false;
+        }
+
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(Replay::GetReplayPath(ReplayName)), true);
+        if (!ReplayRecorder.Start(ReplayName, KeyframeInterval))
+        {
+            return false;
+        }
+
+        ReplayWorld = World;
+        bReplayKeyframeSubmitted = false;
+        ReplayTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UGameStateManager::HandleReplayTickStart);
+        ReplayPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UGameStateManager::HandleReplayPostActorTick);
+
+        // Frame 0 is a keyframe.
+        OnReplayKeyframeDue.Broadcast();
+        return true;
+    }
+
+    UFUNCTION(BlueprintCallable, Category = "Game State|Replay")
+    void StopReplayRecording()
+    {
+        if (ReplayRecorder.IsRecording())
+        {
+            UE_LOG(LogTemp, Log, TEXT("[Replay] Recorded %u frames (%lld bytes)"),
+                   ReplayRecorder.GetNumFrames(), ReplayRecorder.GetBytesWritten());
+        }
+        ReplayRecorder.Stop();
+
+        FWorldDelegates::OnWorldTickStart.Remove(ReplayTickStartHandle);
+        FWorldDelegates::OnWorldPostActorTick.Remove(ReplayPostActorTickHandle);
+        ReplayTickStartHandle.Reset();
+        ReplayPostActorTickHandle.Reset();
+        ReplayWorld.Reset();
+    }
+
+    /** True if the next recorded frame writes a keyframe and therefore needs a live snapshot. */
+    UFUNCTION(BlueprintPure, Category = "Game State|Replay")
+    bool IsReplayKeyframeDue() const
+    {
+        return ReplayRecorder.IsRecording() && ReplayRecorder.IsKeyframeDue();
+    }
+
+    /**
+     * Hand in the live world state for the upcoming keyframe (see OnReplayKeyframeDue). Ignored when no
+     * keyframe is due. A keyframe frame without a submitted snapshot is skipped with a warning.
+     * Time Complexity: O(n) copy; the snapshot is encoded when the keyframe frame begins
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Replay")
+    void SubmitReplayKeyframe(const FGameStateSnapshot& LiveState)
+    {
+        if (IsReplayKeyframeDue())
+        {
+            PendingReplayKeyframe = LiveState;
+            bReplayKeyframeSubmitted = true;
+        }
+    }
+
+    /** Log a player input for the frame being recorded (ActionId is defined by the caller). */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Replay")
+    void RecordReplayInput(int32 ActionId, FVector Value)
+    {
+        ReplayRecorder.RecordInput(ActionId, Value);
+    }
+
+    /** Load a replay and index its keyframes. Returns the number of recorded frames (0 on failure). */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Replay")
+    int32 OpenReplay(const FString& ReplayName)
+    {
+        if (!ReplayPlayer.Open(ReplayName))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[Replay] Could not open replay '%s'"), *ReplayName);
+            return 0;
+        }
+        return (int32)ReplayPlayer.GetTotalFrames();
+    }
+
+    /** Broadcast by SeekReplay with the keyframe it restored; apply it to the world. */
+    UPROPERTY(BlueprintAssignable, Category = "Game State|Replay")
+    FOnReplayKeyframeRestored OnReplayKeyframeRestored;
+
+    /**
+     * Broadcast by SeekReplay once per fast-forwarded frame, with GameplayRandom already seeded
+     * for it; run one deterministic simulation step applying Inputs.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "Game State|Replay")
+    FOnReplayStep OnReplayStep;
+
+    /**
+     * Jump to a frame of the opened replay: restores the nearest earlier keyframe into OutState
+     * and the current state (OnReplayKeyframeRestored), then steps every frame between it and
+     * the target (OnReplayStep). On return GameplayRandom is seeded for Frame, ready to run it.
+     * Time Complexity: O(log k + f)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Replay")
+    bool SeekReplay(int32 Frame, FGameStateSnapshot& OutState)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        int32 SteppedFrames = 0;
+        int32 SteppedInputs = 0;
+
+        const bool bSuccess = ReplayPlayer.Seek((uint32)FMath::Max(0, Frame), OutState,
+            [this](const FGameStateSnapshot& Keyframe)
+            {
+                CurrentState = Keyframe;
+                OnReplayKeyframeRestored.Broadcast(Keyframe);
+            },
+            [this, &SteppedFrames, &SteppedInputs](uint32 StepFrame, float DeltaTime, const TArray<FReplayInputEvent>& Inputs)
+            {
+                OnReplayStep.Broadcast((int32)StepFrame, DeltaTime, Inputs);
+                SteppedFrames++;
+                SteppedInputs += Inputs.Num();
+            });
+
+        if (bSuccess)
+        {
+            UE_LOG(LogTemp, Log, TEXT("[Replay] Seek to frame %d: %d frames (%d inputs) fast-forwarded in %.3f ms"),
+                   Frame, SteppedFrames, SteppedInputs, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        }
+
+        return bSuccess;
     }
 
     /**
      * Undo to previous state.
      * Pops from UndoStack and pushes current state to RedoStack.
-     * Time Complexity: O(1)
+     * Time Complexity: O(n) to expand the restored entry into CurrentState
      */
     UFUNCTION(BlueprintCallable, Category = "Game State")
     bool Undo(FGameStateSnapshot& OutPreviousState)
     {
-        FGameStateSnapshot PreviousState;
+        FGameStateHistoryEntry PreviousState;
         if (UndoStack.Pop(PreviousState))
         {
-            RedoStack.Push(CurrentState); // Save current state to redo stack
-            CurrentState = PreviousState; // Restore previous state
+            RedoStack.Push(MakeHistoryEntry()); // Save current state to redo stack
+            PreviousState.ToSnapshot(CurrentState); // Restore previous state
+            LastHistoryEntry = PreviousState;
             OutPreviousState = CurrentState;
             return true;
         }
@@ -205,16 +609,17 @@ public:
     /**
      * Redo to next state.
      * Pops from RedoStack and pushes current state to UndoStack.
-     * Time Complexity: O(1)
+     * Time Complexity: O(n) to expand the restored entry into CurrentState
      */
     UFUNCTION(BlueprintCallable, Category = "Game State")
     bool Redo(FGameStateSnapshot& OutNextState)
     {
-        FGameStateSnapshot NextState;
+        FGameStateHistoryEntry NextState;
         if (RedoStack.Pop(NextState))
         {
-            UndoStack.Push(CurrentState); // Save current state to undo stack
-            CurrentState = NextState;     // Restore next state
+            UndoStack.Push(MakeHistoryEntry()); // Save current state to undo stack
+            NextState.ToSnapshot(CurrentState); // Restore next state
+            LastHistoryEntry = NextState;
             OutNextState = CurrentState;
             return true;
         }
@@ -241,12 +646,18 @@ public:
             SaveGameInstance->CurrentState = CurrentState;
             SaveGameInstance->SaveSlotName = SlotName;
 
+            const bool bNewSlot = IsNewSlotFile(SaveGameSlotFilter, SlotName, GetSaveGameSlotPath(SlotName));
             bool bSuccess = UGameplayStatics::SaveGameToSlot(SaveGameInstance, SlotName, 0);
 
             if (bSuccess)
             {
+                if (bNewSlot)
+                {
+                    AddSlotToFilter(SaveGameSlotFilter, SlotName);
+                }
+
                 // Cache the state for fast future loads
-                StateCache.Insert(SlotName, CurrentState);
+                CacheSnapshot(SlotName, GetSaveGameSlotPath(SlotName));
 
                 // Update metrics
                 double EndTime = FPlatformTime::Seconds();
@@ -273,9 +684,16 @@ public:
     {
         double StartTime = FPlatformTime::Seconds();
 
-        // Attempt to load from cache first
+        // Unknown slot: answered by the filter (without touching the filesystem if it is trusted)
+        if (!MaySlotExist(SaveGameSlotFilter, SlotName, GetSaveGameSlotPath(SlotName)))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("[Slot Filter] Slot '%s' does not exist"), *SlotName);
+            return false;
+        }
+
+        // Attempt to load from cache first (only if the slot file is unchanged)
         FGameStateSnapshot CachedState;
-        if (StateCache.Find(SlotName, CachedState))
+        if (StateCache.Find(SlotName, GetFileStamp(GetSaveGameSlotPath(SlotName)), CachedState))
         {
             CurrentState = CachedState;
             OutLoadedState = CurrentState;
@@ -296,7 +714,7 @@ public:
                 OutLoadedState = CurrentState;
 
                 // Update cache
-                StateCache.Insert(SlotName, CurrentState);
+                CacheSnapshot(SlotName, GetSaveGameSlotPath(SlotName));
 
                 // Update performance metrics
                 double EndTime = FPlatformTime::Seconds();
@@ -308,26 +726,319 @@ public:
                 return true;
             }
         }
+        else
+        {
+            SlotFilterFalsePositives++;
+        }
 
         return false;
     }
 
-    /** Delete a save slot from disk and cache */
+    /**
+     * Save the current game state using the compact binary format (GameStateBinaryFormat.h).
+     * Codec and delta coding are chosen per slot and recorded in the slot header.
+     * Also caches the saved state in memory.
+     * Time Complexity: O(n) encode + compression + disk I/O
+     */
     UFUNCTION(BlueprintCallable, Category = "Game State")
-    bool DeleteSaveGame(const FString& SlotName)
+    bool SaveGameStateBinary(const FString& SlotName = TEXT("QuickSave"),
+                             EGameStateCodec Codec = EGameStateCodec::LZ4, bool bDeltaPositions = true)
     {
-        if (UGameplayStatics::DoesSaveGameExist(SlotName, 0))
+        double StartTime = FPlatformTime::Seconds();
+
+        TArray<uint8> RawData;
+        GameStateBinary::Encode(CurrentState, RawData);
+
+        TArray<uint8> Data;
+        GameStateBinary::Compress(RawData, Codec, bDeltaPositions, Data);
+
+        const bool bNewSlot = IsNewSlotFile(BinarySlotFilter, SlotName, GameStateBinary::GetSlotPath(SlotName));
+        bool bSuccess = FFileHelper::SaveArrayToFile(Data, *GameStateBinary::GetSlotPath(SlotName));
+        if (bSuccess)
         {
-            bool bSuccess = UGameplayStatics::DeleteGameInSlot(SlotName, 0);
-            
-            if (bSuccess)
+            if (bNewSlot)
             {
-                StateCache.Remove(SlotName); // Remove from cache
+                AddSlotToFilter(BinarySlotFilter, SlotName);
             }
-            
-            return bSuccess;
+            CacheSnapshot(SlotName, GameStateBinary::GetSlotPath(SlotName));
+
+            double EndTime = FPlatformTime::Seconds();
+            float SaveTime = static_cast<float>(EndTime - StartTime);
+            AverageSaveTime = (AverageSaveTime * TotalSaves + SaveTime) / (TotalSaves + 1);
+            TotalSaves++;
+
+            UE_LOG(LogTemp, Log, TEXT("[Binary Snapshot] Saved slot '%s' (%d -> %d bytes) in %.4f seconds"),
+                *SlotName, RawData.Num(), Data.Num(), SaveTime);
         }
-        return false;
+
+        return bSuccess;
+    }
+
+    /**
+     * Load a binary save slot from cache or disk.
+     * The file is memory-mapped and read in place; only the final copy into the snapshot touches each field.
+     * Time Complexity: O(n) + disk I/O
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State")
+    bool LoadGameStateBinary(const FString& SlotName, FGameStateSnapshot& OutLoadedState)
+    {
+        double StartTime = FPlatformTime::Seconds();
+
+        if (!MaySlotExist(BinarySlotFilter, SlotName, GameStateBinary::GetSlotPath(SlotName)))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("[Slot Filter] Binary slot '%s' does not exist"), *SlotName);
+            return false;
+        }
+
+        FGameStateSnapshot CachedState;
+        if (StateCache.Find(SlotName, GetFileStamp(GameStateBinary::GetSlotPath(SlotName)), CachedState))
+        {
+            CurrentState = CachedState;
+            OutLoadedState = CurrentState;
+            UE_LOG(LogTemp, Log, TEXT("Game state loaded from cache for slot '%s'"), *SlotName);
+            return true;
+        }
+
+        FGameStateBinaryFile File;
+        if (!File.Open(GameStateBinary::GetSlotPath(SlotName)))
+        {
+            if (!IFileManager::Get().FileExists(*GameStateBinary::GetSlotPath(SlotName)))
+            {
+                SlotFilterFalsePositives++;
+            }
+            return false;
+        }
+
+        File.GetView().ToSnapshot(CurrentState);
+        OutLoadedState = CurrentState;
+        CacheSnapshot(SlotName, GameStateBinary::GetSlotPath(SlotName));
+
+        double EndTime = FPlatformTime::Seconds();
+        float LoadTime = static_cast<float>(EndTime - StartTime);
+        AverageLoadTime = (AverageLoadTime * TotalLoads + LoadTime) / (TotalLoads + 1);
+        TotalLoads++;
+
+        UE_LOG(LogTemp, Log, TEXT("[Binary Snapshot] Loaded slot '%s' (%s) in %.4f seconds"),
+            *SlotName, File.IsMapped() ? TEXT("mapped") : TEXT("buffered"), LoadTime);
+        return true;
+    }
+
+    /**
+     * Benchmark: saves the current state through both the USaveGame path and the binary format,
+     * then loads each from disk (bypassing the cache) Iterations times.
+     * Reports file sizes and average load times in milliseconds.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Performance")
+    void BenchmarkSaveFormats(const FString& SlotName, int32 Iterations,
+                              int32& OutSaveGameBytes, int32& OutBinaryBytes,
+                              float& OutSaveGameLoadMs, float& OutBinaryLoadMs)
+    {
+        OutSaveGameBytes = OutBinaryBytes = 0;
+        OutSaveGameLoadMs = OutBinaryLoadMs = 0.0f;
+        Iterations = FMath::Max(1, Iterations);
+
+        // Write both formats.
+        UGameStateSaveGame* SaveGameInstance = Cast<UGameStateSaveGame>(
+            UGameplayStatics::CreateSaveGameObject(UGameStateSaveGame::StaticClass())
+        );
+        if (SaveGameInstance == nullptr)
+        {
+            return;
+        }
+        SaveGameInstance->CurrentState = CurrentState;
+        SaveGameInstance->SaveSlotName = SlotName;
+
+        TArray<uint8> SaveGameData;
+        const bool bNewSaveGameSlot = IsNewSlotFile(SaveGameSlotFilter, SlotName, GetSaveGameSlotPath(SlotName));
+        if (!UGameplayStatics::SaveGameToMemory(SaveGameInstance, SaveGameData) ||
+            !UGameplayStatics::SaveDataToSlot(SaveGameData, SlotName, 0))
+        {
+            return;
+        }
+        if (bNewSaveGameSlot)
+        {
+            AddSlotToFilter(SaveGameSlotFilter, SlotName);
+        }
+
+        TArray<uint8> BinaryData;
+        GameStateBinary::Encode(CurrentState, BinaryData);
+        const FString BinaryPath = GameStateBinary::GetSlotPath(SlotName);
+        const bool bNewBinarySlot = IsNewSlotFile(BinarySlotFilter, SlotName, BinaryPath);
+        if (!FFileHelper::SaveArrayToFile(BinaryData, *BinaryPath))
+        {
+            return;
+        }
+        if (bNewBinarySlot)
+        {
+            AddSlotToFilter(BinarySlotFilter, SlotName);
+        }
+
+        OutSaveGameBytes = SaveGameData.Num();
+        OutBinaryBytes = BinaryData.Num();
+
+        // USaveGame path: read slot, deserialize into a UObject, copy out the snapshot.
+        FGameStateSnapshot Scratch;
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            UGameStateSaveGame* LoadedGame = Cast<UGameStateSaveGame>(UGameplayStatics::LoadGameFromSlot(SlotName, 0));
+            if (LoadedGame)
+            {
+                Scratch = LoadedGame->CurrentState;
+            }
+        }
+        OutSaveGameLoadMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations);
+
+        // Binary path: map the file and expand the view.
+        StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            FGameStateBinaryFile File;
+            if (File.Open(BinaryPath))
+            {
+                File.GetView().ToSnapshot(Scratch);
+            }
+        }
+        OutBinaryLoadMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations);
+
+        UE_LOG(LogTemp, Log, TEXT("[Binary Snapshot] %d enemies | USaveGame: %d bytes, %.4f ms | Binary: %d bytes, %.4f ms"),
+            CurrentState.EnemyPositions.Num(), OutSaveGameBytes, OutSaveGameLoadMs, OutBinaryBytes, OutBinaryLoadMs);
+    }
+
+    /**
+     * Benchmark: runs every codec (with delta coding) over the given slots and reports
+     * compression ratio plus encode/decode throughput. Slots are loaded as recorded snapshots,
+     * so point this at late-wave saves; with no loadable slots the current state is used.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Performance")
+    TArray<FGameStateCodecStats> BenchmarkCodecs(const TArray<FString>& SlotNames, int32 Iterations = 20)
+    {
+        Iterations = FMath::Max(1, Iterations);
+
+        // Gather raw encodings of the recorded snapshots (bypassing the cache to read what is on disk).
+        TArray<TArray<uint8>> RawSnapshots;
+        for (const FString& SlotName : SlotNames)
+        {
+            FGameStateSnapshot Snapshot;
+            FGameStateBinaryFile File;
+            if (File.Open(GameStateBinary::GetSlotPath(SlotName)))
+            {
+                File.GetView().ToSnapshot(Snapshot);
+            }
+            else if (UGameStateSaveGame* LoadedGame = Cast<UGameStateSaveGame>(UGameplayStatics::LoadGameFromSlot(SlotName, 0)))
+            {
+                Snapshot = LoadedGame->CurrentState;
+            }
+            else
+            {
+                continue;
+            }
+            GameStateBinary::Encode(Snapshot, RawSnapshots.AddDefaulted_GetRef());
+        }
+
+        if (RawSnapshots.Num() == 0)
+        {
+            GameStateBinary::Encode(CurrentState, RawSnapshots.AddDefaulted_GetRef());
+        }
+
+        int64 RawBytes = 0;
+        for (const TArray<uint8>& Raw : RawSnapshots)
+        {
+            RawBytes += Raw.Num();
+        }
+
+        TArray<FGameStateCodecStats> Results;
+        const EGameStateCodec Codecs[] = { EGameStateCodec::None, EGameStateCodec::LZ4, EGameStateCodec::Oodle, EGameStateCodec::Zlib };
+
+        for (EGameStateCodec Codec : Codecs)
+        {
+            if (!GameStateBinary::IsCodecAvailable(Codec))
+            {
+                UE_LOG(LogTemp, Log, TEXT("[Codec Benchmark] %s unavailable on this platform"),
+                    *GameStateBinary::GetCodecFormatName(Codec).ToString());
+                continue;
+            }
+
+            TArray<TArray<uint8>> Encoded;
+            Encoded.SetNum(RawSnapshots.Num());
+
+            double StartTime = FPlatformTime::Seconds();
+            for (int32 Iter = 0; Iter < Iterations; ++Iter)
+            {
+                for (int32 i = 0; i < RawSnapshots.Num(); ++i)
+                {
+                    GameStateBinary::Compress(RawSnapshots[i], Codec, true, Encoded[i]);
+                }
+            }
+            const double EncodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+            TArray<uint8> Decoded;
+            StartTime = FPlatformTime::Seconds();
+            for (int32 Iter = 0; Iter < Iterations; ++Iter)
+            {
+                for (const TArray<uint8>& File : Encoded)
+                {
+                    GameStateBinary::Decode(File.GetData(), File.Num(), Decoded);
+                }
+            }
+            const double DecodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+            int64 StoredBytes = 0;
+            for (const TArray<uint8>& File : Encoded)
+            {
+                StoredBytes += File.Num();
+            }
+
+            const double Megabytes = (double)RawBytes * Iterations / (1024.0 * 1024.0);
+            FGameStateCodecStats& Stats = Results.AddDefaulted_GetRef();
+            Stats.Codec = Codec;
+            Stats.Ratio = StoredBytes > 0 ? (float)((double)RawBytes / StoredBytes) : 1.0f;
+            Stats.EncodeMBps = EncodeSeconds > 0.0 ? (float)(Megabytes / EncodeSeconds) : 0.0f;
+            Stats.DecodeMBps = DecodeSeconds > 0.0 ? (float)(Megabytes / DecodeSeconds) : 0.0f;
+
+            UE_LOG(LogTemp, Log, TEXT("[Codec Benchmark] %-6s | %d snapshots | Ratio %.2fx | Encode %.1f MB/s | Decode %.1f MB/s"),
+                Codec == EGameStateCodec::None ? TEXT("None") : *GameStateBinary::GetCodecFormatName(Codec).ToString(),
+                RawSnapshots.Num(), Stats.Ratio, Stats.EncodeMBps, Stats.DecodeMBps);
+        }
+
+        return Results;
+    }
+
+    /** Delete a save slot (USaveGame, binary and autosave journal files) from disk and cache */
+    UFUNCTION(BlueprintCallable, Category = "Game State")
+    bool DeleteSaveGame(const FString& SlotName)
+    {
+        bool bSuccess = false;
+
+        // Each filter drops the slot only once its file is really gone, so every file on disk stays represented.
+        if (MaySlotExist(SaveGameSlotFilter, SlotName, GetSaveGameSlotPath(SlotName)) && UGameplayStatics::DoesSaveGameExist(SlotName, 0)
+            && UGameplayStatics::DeleteGameInSlot(SlotName, 0))
+        {
+            SaveGameSlotFilter.Remove(SlotName);
+            bSuccess = true;
+        }
+
+        const FString BinaryPath = GameStateBinary::GetSlotPath(SlotName);
+        if (MaySlotExist(BinarySlotFilter, SlotName, BinaryPath) && IFileManager::Get().FileExists(*BinaryPath)
+            && IFileManager::Get().Delete(*BinaryPath))
+        {
+            BinarySlotFilter.Remove(SlotName);
+            bSuccess = true;
+        }
+
+        // Autosave journal bound to the slot (not tracked by the filters).
+        const FString JournalPath = FGameStateJournal::GetJournalPath(SlotName);
+        if (IFileManager::Get().FileExists(*JournalPath))
+        {
+            bSuccess |= IFileManager::Get().Delete(*JournalPath);
+        }
+
+        if (bSuccess)
+        {
+            StateCache.Remove(SlotName); // Remove from cache
+        }
+
+        return bSuccess;
     }
 
     /** Get all currently cached save slots */
@@ -378,6 +1089,35 @@ public:
     {
         UndoStack.Clear();
         RedoStack.Clear();
+        LastHistoryEntry = FGameStateHistoryEntry();
+    }
+
+    /**
+     * Memory held by the undo/redo history. OutHistoryBytes counts chunks shared between entries once;
+     * OutFlatBytes is what the same entries would take as full FGameStateSnapshot copies.
+     */
+    UFUNCTION(BlueprintPure, Category = "Game State")
+    void GetHistoryMemoryStats(int32& OutEntries, int32& OutHistoryBytes, int32& OutFlatBytes) const
+    {
+        TSet<const void*> Visited;
+        int64 HistoryBytes = 0;
+        int64 FlatBytes = 0;
+        auto CountStack = [&](const CustomStack<FGameStateHistoryEntry>& Stack)
+        {
+            for (const FGameStateHistoryEntry& Entry : Stack.GetElements())
+            {
+                Entry.CountUniqueBytes(Visited, HistoryBytes);
+                FlatBytes += sizeof(FGameStateSnapshot)
+                    + Entry.EnemyPositions.Num() * sizeof(FVector)
+                    + Entry.EnemyHealthValues.Num() * sizeof(int32);
+            }
+        };
+        CountStack(UndoStack);
+        CountStack(RedoStack);
+
+        OutEntries = UndoStack.Size() + RedoStack.Size();
+        OutHistoryBytes = (int32)FMath::Min<int64>(HistoryBytes, MAX_int32);
+        OutFlatBytes = (int32)FMath::Min<int64>(FlatBytes, MAX_int32);
     }
 
     /** Retrieves performance metrics for debugging or UI display */
@@ -391,11 +1131,216 @@ public:
         OutAvgLoadTime = AverageLoadTime;
     }
 
+    /** Bounds the save slot cache; entries over either limit are evicted least recently used first */
+    UFUNCTION(BlueprintCallable, Category = "Game State")
+    void SetCacheLimits(int32 MaxCachedStates, int32 MaxCacheKilobytes)
+    {
+        StateCache.SetLimits(MaxCachedStates, (int64)MaxCacheKilobytes * 1024);
+    }
+
     /** Returns cache statistics for monitoring memory and performance */
     UFUNCTION(BlueprintPure, Category = "Game State")
-    void GetCacheStats(int32& OutCachedStates, float& OutCacheLoadFactor) const
+    void GetCacheStats(int32& OutCachedStates, float& OutCacheLoadFactor, int32& OutCachedBytes,
+                       int32& OutHits, int32& OutMisses, int32& OutEvictions) const
     {
         OutCachedStates = StateCache.GetSize();
         OutCacheLoadFactor = StateCache.GetLoadFactor();
+        OutCachedBytes = (int32)StateCache.GetBytes();
+        OutHits = StateCache.GetHits();
+        OutMisses = StateCache.GetMisses();
+        OutEvictions = StateCache.GetEvictions();
+    }
+
+    /**
+     * Slot filter statistics. The estimated false-positive rate is the filters' upper bound at their current load;
+     * the observed rate is the share of lookups for missing slots that still had to go to disk. Stale misses are
+     * slots the filter did not know about but the disk had (always 0 with bTrustSlotFilter, where they go unseen).
+     */
+    UFUNCTION(BlueprintPure, Category = "Game State")
+    void GetSlotFilterStats(int32& OutTrackedSlots, int32& OutFilterBytes, float& OutEstimatedFalsePositiveRate,
+                            float& OutObservedFalsePositiveRate, int32& OutSkippedLookups, int32& OutStaleMisses) const
+    {
+        OutTrackedSlots = SaveGameSlotFilter.Num() + BinarySlotFilter.Num();
+        OutFilterBytes = (int32)(SaveGameSlotFilter.GetMemoryBytes() + BinarySlotFilter.GetMemoryBytes());
+        OutEstimatedFalsePositiveRate = FMath::Max(SaveGameSlotFilter.GetEstimatedFalsePositiveRate(),
+                                                   BinarySlotFilter.GetEstimatedFalsePositiveRate());
+        const int32 MissingLookups = SlotFilterSkippedLookups + SlotFilterConfirmedMisses + SlotFilterFalsePositives;
+        OutObservedFalsePositiveRate = MissingLookups > 0 ? (float)SlotFilterFalsePositives / MissingLookups : 0.0f;
+        OutSkippedLookups = SlotFilterSkippedLookups;
+        OutStaleMisses = SlotFilterStaleMisses;
+    }
+
+    /**
+     * Benchmark: adds NumKeys slot-like names to a CustomBloomFilter (1% target) and a CustomCuckooFilter, probes
+     * NumKeys names that were never added, and logs measured false-positive rate, memory per key and lookup cost
+     * next to DoesSaveGameExist for the same kind of miss.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Performance")
+    void BenchmarkMembershipFilters(int32 NumKeys = 10000)
+    {
+        NumKeys = FMath::Max(1, NumKeys);
+
+        CustomBloomFilter<FString> Bloom(NumKeys, 0.01f);
+        CustomCuckooFilter<FString> Cuckoo(NumKeys);
+        for (int32 i = 0; i < NumKeys; ++i)
+        {
+            const FString Key = FString::Printf(TEXT("Slot_%d"), i);
+            Bloom.Add(Key);
+            Cuckoo.Add(Key);
+        }
+
+        TArray<FString> Probes;
+        Probes.Reserve(NumKeys);
+        for (int32 i = 0; i < NumKeys; ++i)
+        {
+            Probes.Add(FString::Printf(TEXT("Missing_%d"), i));
+        }
+
+        int32 BloomFalsePositives = 0;
+        double StartTime = FPlatformTime::Seconds();
+        for (const FString& Probe : Probes)
+        {
+            BloomFalsePositives += Bloom.MayContain(Probe) ? 1 : 0;
+        }
+        const double BloomNs = (FPlatformTime::Seconds() - StartTime) * 1000000000.0 / NumKeys;
+
+        int32 CuckooFalsePositives = 0;
+        StartTime = FPlatformTime::Seconds();
+        for (const FString& Probe : Probes)
+        {
+            CuckooFalsePositives += Cuckoo.MayContain(Probe) ? 1 : 0;
+        }
+        const double CuckooNs = (FPlatformTime::Seconds() - StartTime) * 1000000000.0 / NumKeys;
+
+        // The filesystem is orders of magnitude slower; a small sample is enough.
+        const int32 DiskProbes = FMath::Min(NumKeys, 100);
+        StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < DiskProbes; ++i)
+        {
+            UGameplayStatics::DoesSaveGameExist(Probes[i], 0);
+        }
+        const double DiskNs = (FPlatformTime::Seconds() - StartTime) * 1000000000.0 / DiskProbes;
+
+        UE_LOG(LogTemp, Log, TEXT("[Slot Filter] Bloom:  %d keys, %.2f bits/key, k=%d | FP %.4f%% (est. %.4f%%) | %.1f ns/lookup"),
+            NumKeys, Bloom.GetMemoryBytes() * 8.0 / NumKeys, Bloom.GetNumHashes(),
+            100.0 * BloomFalsePositives / NumKeys, 100.0 * Bloom.GetEstimatedFalsePositiveRate(), BloomNs);
+        UE_LOG(LogTemp, Log, TEXT("[Slot Filter] Cuckoo: %d keys, %.2f bits/key, load %.2f | FP %.4f%% (est. %.4f%%) | %.1f ns/lookup"),
+            NumKeys, Cuckoo.GetMemoryBytes() * 8.0 / NumKeys, Cuckoo.GetLoadFactor(),
+            100.0 * CuckooFalsePositives / NumKeys, 100.0 * Cuckoo.GetEstimatedFalsePositiveRate(), CuckooNs);
+        UE_LOG(LogTemp, Log, TEXT("[Slot Filter] DoesSaveGameExist miss: %.1f ns"), DiskNs);
+    }
+
+    /**
+     * Benchmark: records NumEntries history versions of NumEnemies enemy health values, changing ChangesPerEntry
+     * of them between versions, as TArray copies against CustomPersistentVector versions, and as TMap copies
+     * (enemy ID -> health) against CustomPersistentMap versions. Logs total memory and time per snapshot.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Game State|Performance")
+    void BenchmarkPersistentHistory(int32 NumEntries = 500, int32 NumEnemies = 1000, int32 ChangesPerEntry = 10)
+    {
+        NumEntries = FMath::Max(1, NumEntries);
+        NumEnemies = FMath::Max(1, NumEnemies);
+        FRandomStream Random(NumEnemies);
+
+        // Flat copies.
+        TArray<int32> Health;
+        Health.Init(100, NumEnemies);
+        TArray<TArray<int32>> FlatHistory;
+        FlatHistory.Reserve(NumEntries);
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+        {
+            for (int32 Change = 0; Change < ChangesPerEntry; ++Change)
+            {
+                Health[Random.RandHelper(NumEnemies)] -= 1;
+            }
+            FlatHistory.Add(Health);
+        }
+        const double FlatMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        int64 FlatBytes = FlatHistory.GetAllocatedSize();
+        for (const TArray<int32>& Version : FlatHistory)
+        {
+            FlatBytes += Version.GetAllocatedSize();
+        }
+
+        // Persistent vector versions (same change sequence).
+        Random.Reset();
+        Health.Init(100, NumEnemies);
+        CustomPersistentVector<int32> HealthVersion(Health);
+        TArray<CustomPersistentVector<int32>> VectorHistory;
+        VectorHistory.Reserve(NumEntries);
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+        {
+            for (int32 Change = 0; Change < ChangesPerEntry; ++Change)
+            {
+                const int32 Index = Random.RandHelper(NumEnemies);
+                HealthVersion = HealthVersion.Set(Index, HealthVersion[Index] - 1);
+            }
+            VectorHistory.Add(HealthVersion);
+        }
+        const double VectorMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        TSet<const void*> Visited;
+        int64 VectorBytes = VectorHistory.GetAllocatedSize();
+        for (const CustomPersistentVector<int32>& Version : VectorHistory)
+        {
+            Version.CountUniqueBytes(Visited, VectorBytes);
+        }
+
+        // Keyed state: TMap copies.
+        Random.Reset();
+        TMap<int32, int32> HealthByID;
+        CustomPersistentMap<int32, int32> HealthByIDVersion;
+        for (int32 ID = 0; ID < NumEnemies; ++ID)
+        {
+            HealthByID.Add(ID, 100);
+            HealthByIDVersion = HealthByIDVersion.Set(ID, 100);
+        }
+        TArray<TMap<int32, int32>> MapHistory;
+        MapHistory.Reserve(NumEntries);
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+        {
+            for (int32 Change = 0; Change < ChangesPerEntry; ++Change)
+            {
+                HealthByID[Random.RandHelper(NumEnemies)] -= 1;
+            }
+            MapHistory.Add(HealthByID);
+        }
+        const double MapMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        int64 MapBytes = MapHistory.GetAllocatedSize();
+        for (const TMap<int32, int32>& Version : MapHistory)
+        {
+            MapBytes += Version.GetAllocatedSize();
+        }
+
+        // Persistent map versions (same change sequence).
+        Random.Reset();
+        TArray<CustomPersistentMap<int32, int32>> PersistentMapHistory;
+        PersistentMapHistory.Reserve(NumEntries);
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+        {
+            for (int32 Change = 0; Change < ChangesPerEntry; ++Change)
+            {
+                const int32 ID = Random.RandHelper(NumEnemies);
+                HealthByIDVersion = HealthByIDVersion.Set(ID, *HealthByIDVersion.Find(ID) - 1);
+            }
+            PersistentMapHistory.Add(HealthByIDVersion);
+        }
+        const double PersistentMapMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        Visited.Reset();
+        int64 PersistentMapBytes = PersistentMapHistory.GetAllocatedSize();
+        for (const CustomPersistentMap<int32, int32>& Version : PersistentMapHistory)
+        {
+            Version.CountUniqueBytes(Visited, PersistentMapBytes);
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("[Persistent History] %d entries x %d enemies, %d changes per entry"),
+            NumEntries, NumEnemies, ChangesPerEntry);
+        UE_LOG(LogTemp, Log, TEXT("[Persistent History] TArray copies: %.1f KB, %.4f ms/entry | CustomPersistentVector: %.1f KB, %.4f ms/entry"),
+            FlatBytes / 1024.0, FlatMs / NumEntries, VectorBytes / 1024.0, VectorMs / NumEntries);
+        UE_LOG(LogTemp, Log, TEXT("[Persistent History] TMap copies: %.1f KB, %.4f ms/entry | CustomPersistentMap: %.1f KB, %.4f ms/entry"),
+            MapBytes / 1024.0, MapMs / NumEntries, PersistentMapBytes / 1024.0, PersistentMapMs / NumEntries);
     }
 };
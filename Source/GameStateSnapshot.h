@@ -0,0 +1,72 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameStateSnapshot.generated.h"
+
+/**
+ * FGameStateSnapshot:
+ * Represents a complete snapshot of the game state at a given time.
+ * Used for undo/redo functionality, quick saves, and state restoration.
+ * Lives in its own header so the save formats can use it without pulling in UGameStateManager.
+ */
+USTRUCT(BlueprintType)
+struct FGameStateSnapshot
+{
+    GENERATED_BODY()
+
+    // Player's current health
+    UPROPERTY()
+    int32 PlayerHealth;
+
+    // Player's current points
+    UPROPERTY()
+    int32 PlayerPoints;
+
+    // Current wave index in the game
+    UPROPERTY()
+    int32 CurrentWave;
+
+    // Number of kills in the current wave
+    UPROPERTY()
+    int32 WaveKills;
+
+    // Ammo in the currently equipped weapon
+    UPROPERTY()
+    int32 CurrentAmmo;
+
+    // Ammo in reserve / holstered
+    UPROPERTY()
+    int32 HolsteredAmmo;
+
+    // Positions of all active enemies in the level
+    UPROPERTY()
+    TArray<FVector> EnemyPositions;
+
+    // Health values of all active enemies
+    UPROPERTY()
+    TArray<int32> EnemyHealthValues;
+
+    // Timestamp used to identify this snapshot
+    UPROPERTY()
+    float Timestamp;
+
+    // Default constructor initializing safe defaults
+    FGameStateSnapshot()
+        : PlayerHealth(100)
+        , PlayerPoints(0)
+        , CurrentWave(0)
+        , WaveKills(0)
+        , CurrentAmmo(0)
+        , HolsteredAmmo(0)
+        , Timestamp(0.0f)
+    {
+    }
+
+    // Equality operator to compare snapshots based on timestamp
+    bool operator==(const FGameStateSnapshot& Other) const
+    {
+        return FMath::IsNearlyEqual(Timestamp, Other.Timestamp, 0.01f);
+    }
+};
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameplayDataSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+
+void UGameplayDataSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Opening only validates the header, so this costs the same however large the tables get.
+	Reload();
+}
+
+void UGameplayDataSubsystem::Deinitialize()
+{
+	m_File.Close();
+
+	Super::Deinitialize();
+}
+
+const FGameplayDataView* UGameplayDataSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* pWorld = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* pGameInstance = pWorld != nullptr ? pWorld->GetGameInstance() : nullptr;
+	const UGameplayDataSubsystem* pSubsystem = pGameInstance != nullptr ? pGameInstance->GetSubsystem<UGameplayDataSubsystem>() : nullptr;
+	return pSubsystem != nullptr ? pSubsystem->GetData() : nullptr;
+}
+
+const FGameplayDataView* UGameplayDataSubsystem::GetData() const
+{
+	return m_File.GetView().IsValid() ? &m_File.GetView() : nullptr;
+}
+
+bool UGameplayDataSubsystem::Reload()
+{
+	const FString path = GameplayData::GetDefaultPath();
+
+	double startTime = FPlatformTime::Seconds();
+	const bool bOpened = m_File.Open(path);
+	m_fOpenTime = FPlatformTime::Seconds() - startTime;
+
+	if (bOpened)
+	{
+		const FGameplayDataView& view = m_File.GetView();
+		UE_LOG(LogTemp, Log, TEXT("[Gameplay Data] Opened %s (%s, %lld bytes) in %.3f ms: %d enemies, %d weapons, %d waves"),
+			*path, m_File.IsMapped() ? TEXT("mapped") : TEXT("read"), view.GetSize(), m_fOpenTime * 1000.0f,
+			view.GetNumRecords(GameplayData::Enemies), view.GetNumRecords(GameplayData::Weapons), view.GetNumRecords(GameplayData::Waves));
+	}
+	else if (IFileManager::Get().FileExists(*path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Gameplay Data] %s is invalid or from an older format; rerun -run=CompileGameplayData"), *path);
+	}
+
+	return bOpened;
+}
+
+void UGameplayDataSubsystem::GetLoadStats(bool& bOutLoaded, bool& bOutMapped, float& OutOpenTimeMs, int32& OutFileBytes,
+	int32& OutEnemies, int32& OutWeapons, int32& OutWaves) const
+{
+	const FGameplayDataView& view = m_File.GetView();
+	bOutLoaded = view.IsValid();
+	bOutMapped = m_File.IsMapped();
+	OutOpenTimeMs = m_fOpenTime * 1000.0f;
+	OutFileBytes = (int32)view.GetSize();
+	OutEnemies = view.GetNumRecords(GameplayData::Enemies);
+	OutWeapons = view.GetNumRecords(GameplayData::Weapons);
+	OutWaves = view.GetNumRecords(GameplayData::Waves);
+}
+
+void UGameplayDataSubsystem::BenchmarkAgainstDataTable(TSoftObjectPtr<UDataTable> EnemyTable, int32 NumLookups)
+{
+	NumLookups = FMath::Max(1, NumLookups);
+
+	// DataTable: the load is only cold if nothing has loaded the asset yet.
+	const bool bAlreadyLoaded = EnemyTable.Get() != nullptr;
+	const uint64 usedBefore = FPlatformMemory::GetStats().UsedPhysical;
+	double startTime = FPlatformTime::Seconds();
+	UDataTable* pTable = EnemyTable.LoadSynchronous();
+	const double tableLoadMs = (FPlatformTime::Seconds() - startTime) * 1000.0;
+	const int64 tableResidentDelta = (int64)FPlatformMemory::GetStats().UsedPhysical - (int64)usedBefore;
+
+	if (pTable == nullptr || pTable->GetRowNames().Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Gameplay Data] Benchmark needs a DataTable with FGameplayEnemyStatsRow rows"));
+		return;
+	}
+
+	// Cooked file: a fresh open of the same data the subsystem maps at startup.
+	FGameplayDataFile file;
+	startTime = FPlatformTime::Seconds();
+	const bool bOpened = file.Open(GameplayData::GetDefaultPath());
+	const double fileOpenMs = (FPlatformTime::Seconds() - startTime) * 1000.0;
+
+	if (!bOpened)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Gameplay Data] Benchmark needs cooked tables at %s"), *GameplayData::GetDefaultPath());
+		return;
+	}
+
+	// Row lookups by name, cycling through the DataTable's rows.
+	const TArray<FName> rowNames = pTable->GetRowNames();
+
+	int32 tableFound = 0;
+	startTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumLookups; ++i)
+	{
+		tableFound += pTable->FindRow<FGameplayEnemyStatsRow>(rowNames[i % rowNames.Num()], TEXT("Benchmark"), false) != nullptr ? 1 : 0;
+	}
+	const double tableLookupNs = (FPlatformTime::Seconds() - startTime) * 1000000000.0 / NumLookups;
+
+	int32 fileFound = 0;
+	startTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumLookups; ++i)
+	{
+		fileFound += file.GetView().FindEnemy(rowNames[i % rowNames.Num()]) != nullptr ? 1 : 0;
+	}
+	const double fileLookupNs = (FPlatformTime::Seconds() - startTime) * 1000000000.0 / NumLookups;
+
+	UE_LOG(LogTemp, Log, TEXT("[Gameplay Data] DataTable '%s': %s load %.3f ms, %lld bytes (resident delta %lld), lookup %.1f ns (%d/%d found)"),
+		*pTable->GetName(), bAlreadyLoaded ? TEXT("warm") : TEXT("cold"), tableLoadMs,
+		pTable->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal), tableResidentDelta, tableLookupNs, tableFound, NumLookups);
+	UE_LOG(LogTemp, Log, TEXT("[Gameplay Data] Cooked file (%s): open %.3f ms, %lld bytes, lookup %.1f ns (%d/%d found)"),
+		file.IsMapped() ? TEXT("mapped") : TEXT("read"), fileOpenMs, file.GetView().GetSize(), fileLookupNs, fileFound, NumLookups);
+}
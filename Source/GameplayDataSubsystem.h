@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/DataTable.h"
+#include "GameplayDataTable.h"
+#include "GameplayDataSubsystem.generated.h"
+
+/**
+ * FGameplayEnemyStatsRow:
+ * DataTable row with the same columns as the cooked enemy table, so the enemy CSV can also be
+ * imported as a DataTable asset and compared against the cooked file (BenchmarkAgainstDataTable).
+ */
+USTRUCT(BlueprintType)
+struct FGameplayEnemyStatsRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float InitialHealth = 30.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float AttackDamage = 33.4f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float AttackRange = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float BaseSpeed = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float PointsPerHit = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float PointsFromDeath = 150.0f;
+};
+
+/**
+ * UGameplayDataSubsystem:
+ * Maps the cooked gameplay tables (GameplayDataTable.h, built by UCompileGameplayDataCommandlet) once per game instance.
+ * Enemies, weapons and the enhanced director look up their tuning by row name or wave number; anything without
+ * a row, or a missing file, keeps its UPROPERTY defaults and Blueprint overrides.
+ */
+UCLASS()
+class PROJECT_GOLDFISH_API UGameplayDataSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Cooked tables of the context object's game instance, or nullptr if none are loaded.
+	static const FGameplayDataView* Get(const UObject* WorldContextObject);
+
+	// Cooked tables, or nullptr if none are loaded.
+	const FGameplayDataView* GetData() const;
+
+	// Reopen the cooked tables (e.g. after rerunning the commandlet while the editor is open).
+	UFUNCTION(BlueprintCallable, Category="Gameplay Data")
+	bool Reload();
+
+	// Whether the tables are loaded (and mapped), how long opening took and what they hold.
+	UFUNCTION(BlueprintPure, Category="Performance")
+	void GetLoadStats(bool& bOutLoaded, bool& bOutMapped, float& OutOpenTimeMs, int32& OutFileBytes,
+		int32& OutEnemies, int32& OutWeapons, int32& OutWaves) const;
+
+	// Load time, memory and NumLookups row lookups of a DataTable asset (imported from the enemy CSV)
+	// against opening and querying the cooked file.
+	UFUNCTION(BlueprintCallable, Category="Performance")
+	void BenchmarkAgainstDataTable(TSoftObjectPtr<UDataTable> EnemyTable, int32 NumLookups = 100000);
+
+	// USubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	FGameplayDataFile m_File;
+
+	// Stats.
+	float m_fOpenTime = 0.0f;
+};
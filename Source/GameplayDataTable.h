@@ -0,0 +1,595 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Crc.h"
+#include "Serialization/Csv/CsvParser.h"
+
+/**
+ * GameplayData:
+ * Cooked, read-only binary tables for gameplay tuning (enemy stats, weapon damage, wave curves),
+ * compiled from CSV by UCompileGameplayDataCommandlet and read in place from a memory mapping.
+ *
+ * File Layout (little-endian, every section 4-byte aligned):
+ * - FHeader        : fixed size, one FTableEntry per table (record offset/count/size, index offset).
+ * - Records        : fixed-layout structs per table (FEnemyStatsRecord, FWeaponRecord, FWaveRecord).
+ * - Indices        : per named table, FIndexEntry[n] sorted by case-insensitive name hash.
+ * - String Table   : NUL-terminated UTF-8 row names referenced by offset from the records.
+ * Wave records carry no name; they are stored sorted by wave number and searched directly.
+ *
+ * Opening a table validates the header and section bounds only; nothing is parsed or copied,
+ * so startup cost and resident memory are the pages actually touched.
+ *
+ * Time Complexity:
+ * - Open: O(1) (header validation only)
+ * - Find by name / wave: O(log n)
+ * - Compile: O(n log n) (index sort)
+ */
+namespace GameplayData
+{
+    // 'GDT1' read as a little-endian uint32.
+    static constexpr uint32 Magic = 0x31544447;
+
+    // Bump whenever the header or a record layout changes (the commandlet must be rerun).
+    static constexpr uint16 CurrentVersion = 1;
+
+    static constexpr uint32 SectionAlignment = 4;
+
+    enum ETable : uint32
+    {
+        Enemies = 0,
+        Weapons = 1,
+        Waves = 2,
+        NumTables = 3
+    };
+
+    struct FTableEntry
+    {
+        uint32 RecordsOffset;
+        uint32 RecordCount;
+        uint32 RecordSize;
+        // 0 for tables without a name index (waves).
+        uint32 IndexOffset;
+    };
+
+    struct FHeader
+    {
+        uint32 Magic;
+        uint16 Version;
+        uint16 HeaderSize;
+        uint32 TotalSize;
+        uint32 StringsOffset;
+        uint32 StringsSize;
+        FTableEntry Tables[NumTables];
+    };
+
+    struct FIndexEntry
+    {
+        uint32 NameHash;
+        uint32 Record;
+    };
+
+    // Columns: Name, InitialHealth, AttackDamage, AttackRange, BaseSpeed, PointsPerHit, PointsFromDeath
+    struct FEnemyStatsRecord
+    {
+        uint32 NameOffset;
+        float InitialHealth;
+        float AttackDamage;
+        float AttackRange;
+        float BaseSpeed;
+        float PointsPerHit;
+        float PointsFromDeath;
+    };
+
+    // Columns: Name, DamageMin, DamageMax, PelletsPerShot, SpreadAngle, Range
+    struct FWeaponRecord
+    {
+        uint32 NameOffset;
+        float DamageMin;
+        float DamageMax;
+        int32 PelletsPerShot;
+        float SpreadAngle;
+        float Range;
+    };
+
+    // Columns: Wave, WaveSize, ArenaCapacity, MinWalkSpeed, MaxWalkSpeed
+    struct FWaveRecord
+    {
+        int32 Wave;
+        int32 WaveSize;
+        int32 ArenaCapacity;
+        float MinWalkSpeed;
+        float MaxWalkSpeed;
+    };
+
+    static_assert(sizeof(FHeader) == 68, "GameplayData::FHeader layout changed; bump CurrentVersion.");
+    static_assert(sizeof(FEnemyStatsRecord) == 28 && sizeof(FWeaponRecord) == 24 && sizeof(FWaveRecord) == 20,
+        "GameplayData record layout changed; bump CurrentVersion.");
+
+    // Default location of the cooked tables (stage Content/Data as a non-UFS directory so it can be mapped).
+    inline FString GetDefaultPath()
+    {
+        return FPaths::ProjectContentDir() / TEXT("Data/GameplayData.gdt");
+    }
+
+    inline uint32 AlignSection(uint32 Offset)
+    {
+        return (Offset + SectionAlignment - 1) & ~(SectionAlignment - 1);
+    }
+
+    // Row names are matched case-insensitively, like FName.
+    inline uint32 HashName(const FString& Name)
+    {
+        const FTCHARToUTF8 Utf8(*Name.ToLower());
+        return FCrc::MemCrc32(Utf8.Get(), Utf8.Length());
+    }
+
+    /**
+     * FCsvTable:
+     * A parsed CSV file with a header row. Columns are looked up by header name (case-insensitive).
+     */
+    struct FCsvTable
+    {
+        FCsvParser Parser;
+        TArray<FString> Columns;
+
+        explicit FCsvTable(const FString& Text)
+            : Parser(Text)
+        {
+            const FCsvParser::FRows& Rows = Parser.GetRows();
+            if (Rows.Num() > 0)
+            {
+                for (const TCHAR* Cell : Rows[0])
+                {
+                    Columns.Add(FString(Cell).TrimStartAndEnd());
+                }
+            }
+        }
+
+        int32 NumRows() const
+        {
+            return FMath::Max(0, Parser.GetRows().Num() - 1);
+        }
+
+        // Column index for Name, or INDEX_NONE after appending an error.
+        int32 FindColumn(const TCHAR* Name, const TCHAR* TableName, FString& OutError) const
+        {
+            const int32 Column = Columns.IndexOfByPredicate([Name](const FString& Header) { return Header.Equals(Name, ESearchCase::IgnoreCase); });
+            if (Column == INDEX_NONE)
+            {
+                OutError += FString::Printf(TEXT("%s: missing column '%s'\n"), TableName, Name);
+            }
+            return Column;
+        }
+
+        FString GetString(int32 Row, int32 Column) const
+        {
+            const TArray<const TCHAR*>& Cells = Parser.GetRows()[Row + 1];
+            return Cells.IsValidIndex(Column) ? FString(Cells[Column]).TrimStartAndEnd() : FString();
+        }
+
+        float GetFloat(int32 Row, int32 Column) const
+        {
+            return FCString::Atof(*GetString(Row, Column));
+        }
+
+        int32 GetInt(int32 Row, int32 Column) const
+        {
+            return FCString::Atoi(*GetString(Row, Column));
+        }
+    };
+
+    /**
+     * Compiles the three CSV sources into one cooked file. An empty source produces an empty table.
+     * Fails (with every problem listed in OutError) on missing columns, empty or duplicate names and duplicate waves.
+     */
+    inline bool Compile(const FString& EnemiesCsv, const FString& WeaponsCsv, const FString& WavesCsv, TArray<uint8>& OutData, FString& OutError)
+    {
+        OutError.Reset();
+
+        TArray<uint8> Strings;
+        TMap<FString, uint32> StringOffsets;
+        auto AddString = [&Strings, &StringOffsets](const FString& Value) -> uint32
+        {
+            if (const uint32* Existing = StringOffsets.Find(Value))
+            {
+                return *Existing;
+            }
+            const uint32 Offset = Strings.Num();
+            const FTCHARToUTF8 Utf8(*Value);
+            Strings.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+            Strings.Add(0);
+            StringOffsets.Add(Value, Offset);
+            return Offset;
+        };
+
+        // Named rows: records in CSV order plus a hash index.
+        auto ReadNames = [&OutError](const FCsvTable& Csv, const TCHAR* TableName, TArray<FString>& OutNames, TArray<FIndexEntry>& OutIndex)
+        {
+            const int32 NameColumn = Csv.FindColumn(TEXT("Name"), TableName, OutError);
+            if (NameColumn == INDEX_NONE)
+            {
+                return;
+            }
+
+            TSet<FString> Seen;
+            for (int32 Row = 0; Row < Csv.NumRows(); ++Row)
+            {
+                const FString Name = Csv.GetString(Row, NameColumn);
+                bool bDuplicate = false;
+                Seen.Add(Name.ToLower(), &bDuplicate);
+                if (Name.IsEmpty() || bDuplicate)
+                {
+                    OutError += FString::Printf(TEXT("%s: row %d has an empty or duplicate name '%s'\n"), TableName, Row + 2, *Name);
+                }
+                OutNames.Add(Name);
+                OutIndex.Add({ HashName(Name), (uint32)Row });
+            }
+            OutIndex.Sort([](const FIndexEntry& A, const FIndexEntry& B) { return A.NameHash < B.NameHash; });
+        };
+
+        // Enemies.
+        const FCsvTable EnemiesTable(EnemiesCsv);
+        TArray<FString> EnemyNames;
+        TArray<FIndexEntry> EnemyIndex;
+        TArray<FEnemyStatsRecord> EnemyRecords;
+        if (EnemiesTable.NumRows() > 0)
+        {
+            ReadNames(EnemiesTable, TEXT("Enemies"), EnemyNames, EnemyIndex);
+            const int32 Health = EnemiesTable.FindColumn(TEXT("InitialHealth"), TEXT("Enemies"), OutError);
+            const int32 Damage = EnemiesTable.FindColumn(TEXT("AttackDamage"), TEXT("Enemies"), OutError);
+            const int32 Range = EnemiesTable.FindColumn(TEXT("AttackRange"), TEXT("Enemies"), OutError);
+            const int32 Speed = EnemiesTable.FindColumn(TEXT("BaseSpeed"), TEXT("Enemies"), OutError);
+            const int32 PerHit = EnemiesTable.FindColumn(TEXT("PointsPerHit"), TEXT("Enemies"), OutError);
+            const int32 PerDeath = EnemiesTable.FindColumn(TEXT("PointsFromDeath"), TEXT("Enemies"), OutError);
+            if (OutError.IsEmpty())
+            {
+                for (int32 Row = 0; Row < EnemiesTable.NumRows(); ++Row)
+                {
+                    EnemyRecords.Add({ AddString(EnemyNames[Row]),
+                        EnemiesTable.GetFloat(Row, Health), EnemiesTable.GetFloat(Row, Damage),
+                        EnemiesTable.GetFloat(Row, Range), EnemiesTable.GetFloat(Row, Speed),
+                        EnemiesTable.GetFloat(Row, PerHit), EnemiesTable.GetFloat(Row, PerDeath) });
+                }
+            }
+        }
+
+        // Weapons.
+        const FCsvTable WeaponsTable(WeaponsCsv);
+        TArray<FString> WeaponNames;
+        TArray<FIndexEntry> WeaponIndex;
+        TArray<FWeaponRecord> WeaponRecords;
+        if (WeaponsTable.NumRows() > 0)
+        {
+            ReadNames(WeaponsTable, TEXT("Weapons"), WeaponNames, WeaponIndex);
+            const int32 DamageMin = WeaponsTable.FindColumn(TEXT("DamageMin"), TEXT("Weapons"), OutError);
+            const int32 DamageMax = WeaponsTable.FindColumn(TEXT("DamageMax"), TEXT("Weapons"), OutError);
+            const int32 Pellets = WeaponsTable.FindColumn(TEXT("PelletsPerShot"), TEXT("Weapons"), OutError);
+            const int32 Spread = WeaponsTable.FindColumn(TEXT("SpreadAngle"), TEXT("Weapons"), OutError);
+            const int32 Range = WeaponsTable.FindColumn(TEXT("Range"), TEXT("Weapons"), OutError);
+            if (OutError.IsEmpty())
+            {
+                for (int32 Row = 0; Row < WeaponsTable.NumRows(); ++Row)
+                {
+                    WeaponRecords.Add({ AddString(WeaponNames[Row]),
+                        WeaponsTable.GetFloat(Row, DamageMin), WeaponsTable.GetFloat(Row, DamageMax),
+                        FMath::Max(1, WeaponsTable.GetInt(Row, Pellets)), WeaponsTable.GetFloat(Row, Spread),
+                        WeaponsTable.GetFloat(Row, Range) });
+                }
+            }
+        }
+
+        // Waves (sorted by wave number).
+        const FCsvTable WavesTable(WavesCsv);
+        TArray<FWaveRecord> WaveRecords;
+        if (WavesTable.NumRows() > 0)
+        {
+            const int32 Wave = WavesTable.FindColumn(TEXT("Wave"), TEXT("Waves"), OutError);
+            const int32 Size = WavesTable.FindColumn(TEXT("WaveSize"), TEXT("Waves"), OutError);
+            const int32 Capacity = WavesTable.FindColumn(TEXT("ArenaCapacity"), TEXT("Waves"), OutError);
+            const int32 MinSpeed = WavesTable.FindColumn(TEXT("MinWalkSpeed"), TEXT("Waves"), OutError);
+            const int32 MaxSpeed = WavesTable.FindColumn(TEXT("MaxWalkSpeed"), TEXT("Waves"), OutError);
+            if (OutError.IsEmpty())
+            {
+                for (int32 Row = 0; Row < WavesTable.NumRows(); ++Row)
+                {
+                    WaveRecords.Add({ WavesTable.GetInt(Row, Wave), WavesTable.GetInt(Row, Size), WavesTable.GetInt(Row, Capacity),
+                        WavesTable.GetFloat(Row, MinSpeed), WavesTable.GetFloat(Row, MaxSpeed) });
+                }
+                WaveRecords.Sort([](const FWaveRecord& A, const FWaveRecord& B) { return A.Wave < B.Wave; });
+                for (int32 i = 0; i < WaveRecords.Num(); ++i)
+                {
+                    if (WaveRecords[i].Wave < 1 || (i > 0 && WaveRecords[i].Wave == WaveRecords[i - 1].Wave))
+                    {
+                        OutError += FString::Printf(TEXT("Waves: invalid or duplicate wave %d\n"), WaveRecords[i].Wave);
+                    }
+                }
+            }
+        }
+
+        if (!OutError.IsEmpty())
+        {
+            OutData.Reset();
+            return false;
+        }
+
+        // Lay out the sections.
+        FHeader Header = {};
+        Header.Magic = Magic;
+        Header.Version = CurrentVersion;
+        Header.HeaderSize = sizeof(FHeader);
+
+        uint32 Offset = AlignSection(sizeof(FHeader));
+        auto PlaceTable = [&Offset, &Header](ETable Table, int32 Count, uint32 RecordSize, bool bIndexed)
+        {
+            FTableEntry& Entry = Header.Tables[Table];
+            Entry.RecordCount = Count;
+            Entry.RecordSize = RecordSize;
+            Entry.RecordsOffset = Offset;
+            Offset = AlignSection(Offset + Count * RecordSize);
+            Entry.IndexOffset = bIndexed ? Offset : 0;
+            Offset = bIndexed ? AlignSection(Offset + Count * sizeof(FIndexEntry)) : Offset;
+        };
+        PlaceTable(Enemies, EnemyRecords.Num(), sizeof(FEnemyStatsRecord), true);
+        PlaceTable(Weapons, WeaponRecords.Num(), sizeof(FWeaponRecord), true);
+        PlaceTable(Waves, WaveRecords.Num(), sizeof(FWaveRecord), false);
+        Header.StringsOffset = Offset;
+        Header.StringsSize = Strings.Num();
+        Header.TotalSize = AlignSection(Offset + Strings.Num());
+
+        OutData.SetNumZeroed(Header.TotalSize);
+        auto Write = [&OutData](uint32 At, const void* Source, int64 Bytes)
+        {
+            if (Bytes > 0)
+            {
+                FMemory::Memcpy(OutData.GetData() + At, Source, Bytes);
+            }
+        };
+        Write(0, &Header, sizeof(FHeader));
+        Write(Header.Tables[Enemies].RecordsOffset, EnemyRecords.GetData(), EnemyRecords.Num() * sizeof(FEnemyStatsRecord));
+        Write(Header.Tables[Enemies].IndexOffset, EnemyIndex.GetData(), EnemyIndex.Num() * sizeof(FIndexEntry));
+        Write(Header.Tables[Weapons].RecordsOffset, WeaponRecords.GetData(), WeaponRecords.Num() * sizeof(FWeaponRecord));
+        Write(Header.Tables[Weapons].IndexOffset, WeaponIndex.GetData(), WeaponIndex.Num() * sizeof(FIndexEntry));
+        Write(Header.Tables[Waves].RecordsOffset, WaveRecords.GetData(), WaveRecords.Num() * sizeof(FWaveRecord));
+        Write(Header.StringsOffset, Strings.GetData(), Strings.Num());
+        return true;
+    }
+}
+
+/**
+ * FGameplayDataView:
+ * Non-owning, zero-copy view over a cooked gameplay data file.
+ * Records and names are read in place from whatever memory backs the data (mapped file or array).
+ */
+class FGameplayDataView
+{
+private:
+    const uint8* Data;
+    int64 DataSize;
+
+    const GameplayData::FHeader& Header() const
+    {
+        return *reinterpret_cast<const GameplayData::FHeader*>(Data);
+    }
+
+    template<typename RecordType>
+    const RecordType* Records(GameplayData::ETable Table) const
+    {
+        return reinterpret_cast<const RecordType*>(Data + Header().Tables[Table].RecordsOffset);
+    }
+
+    // Binary search of the name index; hash collisions are resolved by comparing the stored names.
+    template<typename RecordType>
+    const RecordType* FindNamed(GameplayData::ETable Table, const FName& Name) const
+    {
+        const int32 Count = GetNumRecords(Table);
+        if (Count == 0 || Name.IsNone())
+        {
+            return nullptr;
+        }
+
+        const FString NameString = Name.ToString();
+        const uint32 Hash = GameplayData::HashName(NameString);
+        const FTCHARToUTF8 Utf8Name(*NameString);
+        const GameplayData::FIndexEntry* Index = reinterpret_cast<const GameplayData::FIndexEntry*>(Data + Header().Tables[Table].IndexOffset);
+
+        int32 Low = 0;
+        int32 High = Count;
+        while (Low < High)
+        {
+            const int32 Mid = Low + (High - Low) / 2;
+            if (Index[Mid].NameHash < Hash)
+            {
+                Low = Mid + 1;
+            }
+            else
+            {
+                High = Mid;
+            }
+        }
+
+        for (int32 i = Low; i < Count && Index[i].NameHash == Hash; ++i)
+        {
+            const RecordType& Record = Records<RecordType>(Table)[Index[i].Record];
+            if (FCStringAnsi::Stricmp(GetString(Record.NameOffset), Utf8Name.Get()) == 0)
+            {
+                return &Record;
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    FGameplayDataView()
+        : Data(nullptr), DataSize(0)
+    {
+    }
+
+    /**
+     * Validates the header and section bounds. Does not touch the records themselves.
+     * Time Complexity: O(1)
+     */
+    bool Initialize(const uint8* InData, int64 InSize)
+    {
+        Data = nullptr;
+        DataSize = 0;
+
+        if (InData == nullptr || InSize < (int64)sizeof(GameplayData::FHeader))
+        {
+            return false;
+        }
+
+        const GameplayData::FHeader& InHeader = *reinterpret_cast<const GameplayData::FHeader*>(InData);
+        if (InHeader.Magic != GameplayData::Magic || InHeader.Version != GameplayData::CurrentVersion ||
+            InHeader.HeaderSize != sizeof(GameplayData::FHeader) || (int64)InHeader.TotalSize > InSize)
+        {
+            return false;
+        }
+
+        // Record sizes must match this build's structs, and no section may read past the end.
+        static constexpr uint32 RecordSizes[GameplayData::NumTables] =
+        {
+            sizeof(GameplayData::FEnemyStatsRecord), sizeof(GameplayData::FWeaponRecord), sizeof(GameplayData::FWaveRecord)
+        };
+        for (uint32 Table = 0; Table < GameplayData::NumTables; ++Table)
+        {
+            const GameplayData::FTableEntry& Entry = InHeader.Tables[Table];
+            if (Entry.RecordSize != RecordSizes[Table] ||
+                Entry.RecordsOffset % GameplayData::SectionAlignment != 0 ||
+                (int64)Entry.RecordsOffset + (int64)Entry.RecordCount * Entry.RecordSize > InHeader.TotalSize ||
+                (Table != GameplayData::Waves &&
+                 (Entry.IndexOffset % GameplayData::SectionAlignment != 0 ||
+                  (int64)Entry.IndexOffset + (int64)Entry.RecordCount * sizeof(GameplayData::FIndexEntry) > InHeader.TotalSize)))
+            {
+                return false;
+            }
+
+            // Every index entry must point at a record of its table; lookups then trust them unchecked.
+            if (Table != GameplayData::Waves)
+            {
+                const GameplayData::FIndexEntry* Index = reinterpret_cast<const GameplayData::FIndexEntry*>(InData + Entry.IndexOffset);
+                for (uint32 i = 0; i < Entry.RecordCount; ++i)
+                {
+                    if (Index[i].Record >= Entry.RecordCount)
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        // The string table must end in a terminator so every name read stays inside it.
+        if ((int64)InHeader.StringsOffset + InHeader.StringsSize > InHeader.TotalSize ||
+            (InHeader.StringsSize > 0 && InData[InHeader.StringsOffset + InHeader.StringsSize - 1] != 0))
+        {
+            return false;
+        }
+
+        Data = InData;
+        DataSize = InSize;
+        return true;
+    }
+
+    bool IsValid() const { return Data != nullptr; }
+
+    int32 GetNumRecords(GameplayData::ETable Table) const
+    {
+        return IsValid() ? (int32)Header().Tables[Table].RecordCount : 0;
+    }
+
+    int64 GetSize() const { return IsValid() ? Header().TotalSize : 0; }
+
+    // NUL-terminated UTF-8 name from the string table ("" for an out-of-range offset).
+    const ANSICHAR* GetString(uint32 Offset) const
+    {
+        const GameplayData::FHeader& H = Header();
+        return Offset < H.StringsSize ? reinterpret_cast<const ANSICHAR*>(Data + H.StringsOffset + Offset) : "";
+    }
+
+    const GameplayData::FEnemyStatsRecord* FindEnemy(const FName& Name) const
+    {
+        return FindNamed<GameplayData::FEnemyStatsRecord>(GameplayData::Enemies, Name);
+    }
+
+    const GameplayData::FWeaponRecord* FindWeapon(const FName& Name) const
+    {
+        return FindNamed<GameplayData::FWeaponRecord>(GameplayData::Weapons, Name);
+    }
+
+    // Record for Wave, or the last record before it (later waves reuse the last defined entry). Null if none.
+    const GameplayData::FWaveRecord* FindWave(int32 Wave) const
+    {
+        const GameplayData::FWaveRecord* Waves = Records<GameplayData::FWaveRecord>(GameplayData::Waves);
+        int32 Low = 0;
+        int32 High = GetNumRecords(GameplayData::Waves);
+        while (Low < High)
+        {
+            const int32 Mid = Low + (High - Low) / 2;
+            if (Waves[Mid].Wave <= Wave)
+            {
+                Low = Mid + 1;
+            }
+            else
+            {
+                High = Mid;
+            }
+        }
+        return Low > 0 ? &Waves[Low - 1] : nullptr;
+    }
+};
+
+/**
+ * FGameplayDataFile:
+ * Owns the memory behind a cooked gameplay data file.
+ * Prefers a read-only memory mapping; falls back to a single bulk read on platforms (or pak files) without mapping support.
+ */
+class FGameplayDataFile
+{
+private:
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    TArray<uint8> LoadedData;
+    FGameplayDataView View;
+
+public:
+    bool Open(const FString& Path)
+    {
+        Close();
+
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        MappedHandle.Reset(PlatformFile.OpenMapped(*Path));
+        if (MappedHandle.IsValid())
+        {
+            MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+            if (MappedRegion.IsValid() && View.Initialize(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+            {
+                return true;
+            }
+            MappedRegion.Reset();
+            MappedHandle.Reset();
+        }
+
+        // Mapping not supported: read the whole file once, still no per-field parsing.
+        if (FFileHelper::LoadFileToArray(LoadedData, *Path, FILEREAD_Silent))
+        {
+            return View.Initialize(LoadedData.GetData(), LoadedData.Num());
+        }
+        return false;
+    }
+
+    void Close()
+    {
+        View = FGameplayDataView();
+        MappedRegion.Reset();
+        MappedHandle.Reset();
+        LoadedData.Empty();
+    }
+
+    bool IsMapped() const { return MappedRegion.IsValid(); }
+    const FGameplayDataView& GetView() const { return View; }
+};
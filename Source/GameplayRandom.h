@@ -0,0 +1,54 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+/**
+ * GameplayRandom:
+ * Single seedable random stream for every gameplay roll (spawn points, walk speeds, damage, sound variations).
+ * Unlike FMath::RandRange, the sequence is fully determined by the seed, so a replay that restores
+ * the recorded seed each frame reproduces the same rolls.
+ *
+ * Use Case: Deterministic replay recording/playback (ReplayRecorder.h).
+ */
+namespace GameplayRandom
+{
+    // The shared stream (game thread only).
+    inline FRandomStream& GetStream()
+    {
+        static FRandomStream Stream(FPlatformTime::Cycles());
+        return Stream;
+    }
+
+    // Reset the stream to a known seed.
+    inline void Seed(int32 NewSeed)
+    {
+        GetStream().Initialize(NewSeed);
+    }
+
+    // Draw a fresh seed from the stream itself (used by the recorder to reseed each frame).
+    inline int32 NextSeed()
+    {
+        return (int32)GetStream().GetUnsignedInt();
+    }
+
+    // Integer in [Min, Max], same contract as FMath::RandRange.
+    inline int32 RandRange(int32 Min, int32 Max)
+    {
+        return GetStream().RandRange(Min, Max);
+    }
+
+    // Float in [Min, Max], same contract as FMath::FRandRange.
+    inline float FRandRange(float Min, float Max)
+    {
+        return GetStream().FRandRange(Min, Max);
+    }
+
+    // Random unit vector within a cone around Dir (half angle in radians), used for weapon spread.
+    inline FVector VRandCone(const FVector& Dir, float ConeHalfAngleRad)
+    {
+        return GetStream().VRandCone(Dir, ConeHalfAngleRad);
+    }
+}
@@ -0,0 +1,245 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HitscanResolver.h"
+#include "EnemyDirectorEnhanced.h"
+#include "Enemy.h"
+#include "HealthInterface.h"
+#include "CombatAudioScheduler.h"
+#include "Components/CapsuleComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "DrawDebugHelpers.h"
+
+int32 UHitscanResolver::BeginShot(const FCollisionQueryParams& QueryParams, USoundBase* MissSound, const FVector& SoundLocation, bool bDrawDebug)
+{
+	FShot& shot = PendingShots.AddDefaulted_GetRef();
+	shot.QueryParams = QueryParams;
+	shot.MissSound = MissSound;
+	shot.SoundLocation = SoundLocation;
+	shot.bDrawDebug = bDrawDebug;
+	return PendingShots.Num() - 1;
+}
+
+void UHitscanResolver::AddRay(int32 ShotIndex, const FVector& Start, const FVector& End, float Damage)
+{
+	if (!PendingShots.IsValidIndex(ShotIndex))
+		return;
+
+	FRay& ray = PendingRays.AddDefaulted_GetRef();
+	ray.ShotIndex = ShotIndex;
+	ray.Start = Start;
+	ray.End = End;
+	ray.Damage = Damage;
+}
+
+void UHitscanResolver::GetResolveStats(int32& OutRaysResolved, int32& OutEnemyHits, float& OutResolveTimeMs) const
+{
+	OutRaysResolved = m_iRaysResolved;
+	OutEnemyHits = m_iEnemyHits;
+	OutResolveTimeMs = m_fResolveTime * 1000.0f;
+}
+
+void UHitscanResolver::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// The enhanced director owns the enemy Quadtree. Levels using the old director fall back to traces.
+	m_pDirector = Cast<AEnemyDirectorEnhanced>(UGameplayStatics::GetActorOfClass(&InWorld, AEnemyDirectorEnhanced::StaticClass()));
+}
+
+void UHitscanResolver::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Last frame's traces have completed by now; resolve them before submitting this frame's batch.
+	if (InFlightRays.Num() > 0)
+	{
+		ResolveInFlightRays();
+	}
+
+	if (PendingRays.Num() > 0)
+	{
+		SubmitPendingRays();
+	}
+	else
+	{
+		PendingShots.Reset();
+	}
+}
+
+TStatId UHitscanResolver::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHitscanResolver, STATGROUP_Tickables);
+}
+
+void UHitscanResolver::SubmitPendingRays()
+{
+	UWorld* pWorld = GetWorld();
+	const bool bUseIndex = m_pDirector.IsValid();
+
+	if (bUseIndex)
+	{
+		TestRaysAgainstEnemyIndex();
+	}
+
+	// Enemies are already covered by the index, so the world traces only need to find occluders.
+	FCollisionObjectQueryParams occluders;
+	occluders.AddObjectTypesToQuery(ECC_WorldStatic);
+	occluders.AddObjectTypesToQuery(ECC_WorldDynamic);
+
+	for (FRay& ray : PendingRays)
+	{
+		const FCollisionQueryParams& queryParams = PendingShots[ray.ShotIndex].QueryParams;
+		ray.TraceHandle = bUseIndex
+			? pWorld->AsyncLineTraceByObjectType(EAsyncTraceType::Single, ray.Start, ray.End, occluders, queryParams)
+			: pWorld->AsyncLineTraceByChannel(EAsyncTraceType::Single, ray.Start, ray.End, ECC_Pawn, queryParams);
+	}
+
+	// Hand the batch over; the arrays swap so their allocations are reused.
+	Swap(InFlightShots, PendingShots);
+	Swap(InFlightRays, PendingRays);
+	m_bInFlightUsesIndex = bUseIndex;
+	PendingShots.Reset();
+	PendingRays.Reset();
+}
+
+void UHitscanResolver::TestRaysAgainstEnemyIndex()
+{
+	// One Quadtree query covering the XY bounds of every ray in the batch.
+	FBox2D bounds(ForceInit);
+	for (const FRay& ray : PendingRays)
+	{
+		bounds += FVector2D(ray.Start.X, ray.Start.Y);
+		bounds += FVector2D(ray.End.X, ray.End.Y);
+	}
+	bounds = bounds.ExpandBy(m_fEnemyQueryPadding);
+
+	m_pCandidates.Reset();
+	m_pDirector->QueryEnemiesInBox(bounds.Min, bounds.Max, m_pCandidates);
+
+	for (AActor* pActor : m_pCandidates)
+	{
+		AEnemy* pEnemy = Cast<AEnemy>(pActor);
+		if (pEnemy == nullptr || !pEnemy->BInArena)
+			continue;
+
+		// Capsule as an axis segment plus radius.
+		const UCapsuleComponent* pCapsule = pEnemy->GetCapsuleComponent();
+		const FVector center = pCapsule->GetComponentLocation();
+		const FVector axis = pCapsule->GetUpVector() * pCapsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+		const float fRadius = pCapsule->GetScaledCapsuleRadius();
+
+		for (FRay& ray : PendingRays)
+		{
+			FVector closestOnRay;
+			FVector closestOnAxis;
+			FMath::SegmentDistToSegmentSafe(ray.Start, ray.End, center - axis, center + axis, closestOnRay, closestOnAxis);
+			if (FVector::DistSquared(closestOnRay, closestOnAxis) > fRadius * fRadius)
+				continue;
+
+			const float fLength = FVector::Dist(ray.Start, ray.End);
+			const float fTime = fLength > KINDA_SMALL_NUMBER ? (float)(FVector::Dist(ray.Start, closestOnRay) / fLength) : 0.0f;
+			if (fTime < ray.EnemyHitTime || !ray.EnemyHit.IsValid())
+			{
+				ray.EnemyHit = pEnemy;
+				ray.EnemyHitTime = fTime;
+			}
+		}
+	}
+}
+
+void UHitscanResolver::ResolveInFlightRays()
+{
+	double startTime = FPlatformTime::Seconds();
+	UWorld* pWorld = GetWorld();
+
+	m_DamageQueue.Reset();
+	m_iEnemyHits = 0;
+
+	for (const FRay& ray : InFlightRays)
+	{
+		FShot& shot = InFlightShots[ray.ShotIndex];
+
+		// Read back the async trace; if it is no longer available (e.g. a hitch skipped a frame), trace now.
+		FHitResult worldHit;
+		bool bWorldHit = false;
+		FTraceDatum datum;
+		if (pWorld->QueryTraceData(ray.TraceHandle, datum))
+		{
+			bWorldHit = datum.OutHits.Num() > 0 && datum.OutHits[0].bBlockingHit;
+			if (bWorldHit)
+			{
+				worldHit = datum.OutHits[0];
+			}
+		}
+		else if (m_bInFlightUsesIndex)
+		{
+			FCollisionObjectQueryParams occluders;
+			occluders.AddObjectTypesToQuery(ECC_WorldStatic);
+			occluders.AddObjectTypesToQuery(ECC_WorldDynamic);
+			bWorldHit = pWorld->LineTraceSingleByObjectType(worldHit, ray.Start, ray.End, occluders, shot.QueryParams);
+		}
+		else
+		{
+			bWorldHit = pWorld->LineTraceSingleByChannel(worldHit, ray.Start, ray.End, ECC_Pawn, shot.QueryParams);
+		}
+
+		// An enemy from the index counts only if nothing in the world blocks the ray before it.
+		AActor* pTarget = nullptr;
+		float fHitTime = bWorldHit ? worldHit.Time : 1.0f;
+		if (m_bInFlightUsesIndex)
+		{
+			if (ray.EnemyHit.IsValid() && ray.EnemyHitTime <= fHitTime)
+			{
+				pTarget = ray.EnemyHit.Get();
+				fHitTime = ray.EnemyHitTime;
+			}
+		}
+		else if (bWorldHit)
+		{
+			pTarget = worldHit.GetActor();
+		}
+
+		if (Cast<IHealthInterface>(pTarget) != nullptr)
+		{
+			m_DamageQueue.Add({ pTarget, ray.Damage });
+		}
+		else
+		{
+			shot.bMissed = true;
+		}
+
+#if ENABLE_DRAW_DEBUG
+		if (shot.bDrawDebug)
+		{
+			const FVector impact = FMath::Lerp(ray.Start, ray.End, fHitTime);
+			DrawDebugLine(pWorld, ray.Start, impact, pTarget ? FColor::Green : FColor::Red, false, 1.0f, 5, 2.0f);
+		}
+#endif
+	}
+
+	// Single damage pass. Targets killed by an earlier pellet ignore the rest (AEnemy::ApplyQueuedDamage drops them when UDamageEventQueue flushes).
+	for (const FPendingDamage& damage : m_DamageQueue)
+	{
+		if (IHealthInterface* pHealth = Cast<IHealthInterface>(damage.Target.Get()))
+		{
+			pHealth->ReceiveDamage(damage.Damage);
+			m_iEnemyHits++;
+		}
+	}
+
+	// One environmental sound per trigger pull, however many pellets missed.
+	UCombatAudioScheduler* pAudio = pWorld->GetSubsystem<UCombatAudioScheduler>();
+	for (const FShot& shot : InFlightShots)
+	{
+		if (shot.bMissed)
+		{
+			pAudio->RequestSound(shot.MissSound, shot.SoundLocation, ECombatSoundCategory::Impact, 0.5f);
+		}
+	}
+
+	m_iRaysResolved = InFlightRays.Num();
+	InFlightShots.Reset();
+	InFlightRays.Reset();
+
+	m_fResolveTime = static_cast<float>(FPlatformTime::Seconds() - startTime);
+}
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "HitscanResolver.generated.h"
+
+class AEnemyDirectorEnhanced;
+class USoundBase;
+
+/**
+ * UHitscanResolver:
+ * Collects every hitscan ray fired during a frame (bullets, shotgun pellets) and resolves them as one batch.
+ * - Enemies: one Quadtree box query over the whole batch (AEnemyDirectorEnhanced), then segment vs capsule tests.
+ * - World geometry: one batch of async line traces against static/dynamic objects only, read back next frame.
+ * - Damage: applied in a single pass once both results are known. At most one miss sound per trigger pull.
+ * Without an enhanced director in the level, rays fall back to async traces on the Pawn channel.
+ * Rays queued in frame N deal their damage in frame N+1.
+ */
+UCLASS()
+class PROJECT_GOLDFISH_API UHitscanResolver : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Start a trigger pull. Returns the shot index to pass to AddRay.
+	int32 BeginShot(const FCollisionQueryParams& QueryParams, USoundBase* MissSound, const FVector& SoundLocation, bool bDrawDebug);
+
+	// Queue one ray (bullet or pellet) belonging to a shot.
+	void AddRay(int32 ShotIndex, const FVector& Start, const FVector& End, float Damage);
+
+	// Rays resolved and time spent in the last resolve pass.
+	UFUNCTION(BlueprintPure, Category="Performance")
+	void GetResolveStats(int32& OutRaysResolved, int32& OutEnemyHits, float& OutResolveTimeMs) const;
+
+	// UTickableWorldSubsystem
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	// Extra XY margin added to the batch bounds so enemies whose capsule overlaps a ray are not culled.
+	float m_fEnemyQueryPadding = 100.0f;
+
+private:
+	// One trigger pull.
+	struct FShot
+	{
+		FCollisionQueryParams QueryParams;
+		USoundBase* MissSound = nullptr;
+		FVector SoundLocation = FVector::ZeroVector;
+		bool bDrawDebug = false;
+		bool bMissed = false;
+	};
+
+	// One bullet or pellet.
+	struct FRay
+	{
+		int32 ShotIndex = 0;
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		float Damage = 0.0f;
+
+		// Closest enemy along the ray from the spatial index (null if none), as a 0..1 fraction of the ray.
+		TWeakObjectPtr<AActor> EnemyHit;
+		float EnemyHitTime = 1.0f;
+
+		// Async world trace submitted for this ray.
+		FTraceHandle TraceHandle;
+	};
+
+	// A resolved hit waiting for the damage pass.
+	struct FPendingDamage
+	{
+		TWeakObjectPtr<AActor> Target;
+		float Damage = 0.0f;
+	};
+
+	// Rays queued this frame, and the batch whose traces are in flight.
+	TArray<FShot> PendingShots;
+	TArray<FRay> PendingRays;
+	TArray<FShot> InFlightShots;
+	TArray<FRay> InFlightRays;
+	bool m_bInFlightUsesIndex = false;
+
+	// Scratch buffers reused every frame.
+	TArray<AActor*> m_pCandidates;
+	TArray<FPendingDamage> m_DamageQueue;
+
+	TWeakObjectPtr<AEnemyDirectorEnhanced> m_pDirector;
+
+	// Stats from the last resolve pass.
+	int32 m_iRaysResolved = 0;
+	int32 m_iEnemyHits = 0;
+	float m_fResolveTime = 0.0f;
+
+	// Test the pending rays against the enemy index and submit their world traces.
+	void SubmitPendingRays();
+
+	// Read back the in-flight traces, pick a target per ray and apply damage in one pass.
+	void ResolveInFlightRays();
+
+	// Fill EnemyHit/EnemyHitTime for every pending ray using one Quadtree query.
+	void TestRaysAgainstEnemyIndex();
+};
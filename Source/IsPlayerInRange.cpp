@@ -5,8 +5,10 @@
 #include "Kismet/GameplayStatics.h"
 #include "Enemy_Controller.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
 #include "EnemyKeys.h"
 #include "Enemy.h"
+#include "PlayerCache.h"
 
 /**
  * Constructor
@@ -36,14 +38,17 @@ void UIsPlayerInRange::OnBecomeRelevant(UBehaviorTreeComponent& behaviorTreeComp
     APawn* pEnemyPawn = pAiController->GetPawn();
     AEnemy* pEnemy = Cast<AEnemy>(pEnemyPawn);
 
-    // Get Player Controller & Pawn.
-    APlayerController* pPlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-    AActor* pPlayerPawn = pPlayerController->GetPawn();
+    // Get the cached player pawn.
+    AActor* pPlayerPawn = GetWorld()->GetSubsystem<UPlayerCache>()->GetPlayerPawn();
+    if (pPlayerPawn == nullptr)
+    {
+        return;
+    }
 
     // Calculate distance between enemy and player
     float fDistanceBetweenPawns = pEnemyPawn->GetDistanceTo(pPlayerPawn);
     // Check if the player is within attack range
     bool bWithinRange = fDistanceBetweenPawns <= pEnemy->GetAttackRange();
     // Update the AI blackboard key with the result
-    pAiController->GetBlackboard()->SetValueAsBool(EnemyKeys::IsPlayerInRange, bWithinRange);
+    pAiController->GetBlackboard()->SetValue<UBlackboardKeyType_Bool>(pAiController->GetBlackboardKeys().IsPlayerInRange, bWithinRange);
 }
@@ -0,0 +1,370 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "JobSystem.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+    // Which job system (if any) owns the current thread, and its slot there.
+    thread_local const FJobSystem* GCurrentJobSystem = nullptr;
+    thread_local int32 GCurrentJobSlot = INDEX_NONE;
+
+    // Nesting depth of Execute on this thread (nested waits must not count busy time twice).
+    thread_local int32 GJobExecuteDepth = 0;
+}
+
+class FJobSystem::FWorker : public FRunnable
+{
+public:
+    FWorker(FJobSystem* InSystem, int32 InSlot)
+        : System(InSystem)
+        , Slot(InSlot)
+    {
+    }
+
+    virtual uint32 Run() override
+    {
+        System->WorkerLoop(Slot);
+        return 0;
+    }
+
+private:
+    FJobSystem* System;
+    int32 Slot;
+};
+
+FJobSystem::FJobSystem(int32 NumWorkers)
+{
+    if (NumWorkers < 0)
+    {
+        NumWorkers = FMath::Clamp(FPlatformMisc::NumberOfCores() - 1, 0, 8);
+    }
+
+    // Worker slots, then the external slot.
+    for (int32 i = 0; i <= NumWorkers; ++i)
+    {
+        Queues.Add(MakeUnique<FWorkQueue>());
+    }
+
+    WorkAvailable = FPlatformProcess::GetSynchEventFromPool(false);
+
+    for (int32 i = 0; i < NumWorkers; ++i)
+    {
+        Workers.Add(MakeUnique<FWorker>(this, i));
+        Threads.Add(FRunnableThread::Create(Workers.Last().Get(), *FString::Printf(TEXT("JobWorker %d"), i), 0, TPri_Normal));
+    }
+}
+
+FJobSystem::~FJobSystem()
+{
+    bStopping = true;
+
+    for (int32 i = 0; i < Threads.Num(); ++i)
+    {
+        WorkAvailable->Trigger();
+    }
+    for (FRunnableThread* Thread : Threads)
+    {
+        Thread->WaitForCompletion();
+        delete Thread;
+    }
+    Threads.Reset();
+    Workers.Reset();
+
+    FPlatformProcess::ReturnSynchEventToPool(WorkAvailable);
+    WorkAvailable = nullptr;
+}
+
+int32 FJobSystem::GetCurrentSlot() const
+{
+    return GCurrentJobSystem == this ? GCurrentJobSlot : Queues.Num() - 1;
+}
+
+void FJobSystem::Submit(FJobTask* Task)
+{
+    FWorkQueue& Queue = *Queues[GetCurrentSlot()];
+    {
+        FScopeLock Lock(&Queue.Lock);
+        Queue.Tasks.PushLast(Task);
+    }
+    WorkAvailable->Trigger();
+}
+
+FJobTask* FJobSystem::FindTask(int32 Slot)
+{
+    // Own work first, newest first.
+    {
+        FWorkQueue& Own = *Queues[Slot];
+        FScopeLock Lock(&Own.Lock);
+        if (!Own.Tasks.IsEmpty())
+        {
+            FJobTask* Task = Own.Tasks.Last();
+            Own.Tasks.PopLast();
+            return Task;
+        }
+    }
+
+    // Steal the oldest task from the other slots.
+    const int32 NumSlots = Queues.Num();
+    for (int32 Offset = 1; Offset < NumSlots; ++Offset)
+    {
+        FWorkQueue& Victim = *Queues[(Slot + Offset) % NumSlots];
+        FScopeLock Lock(&Victim.Lock);
+        if (!Victim.Tasks.IsEmpty())
+        {
+            FJobTask* Task = Victim.Tasks.First();
+            Victim.Tasks.PopFirst();
+            return Task;
+        }
+    }
+
+    return nullptr;
+}
+
+void FJobSystem::Execute(FJobTask* Task, int32 Slot)
+{
+    // Copy what we need: once Counter is decremented the owner may free the task.
+    const TCHAR* Name = Task->Name;
+    std::atomic<int32>* Counter = Task->Counter;
+
+    GJobExecuteDepth++;
+    const double StartSeconds = FPlatformTime::Seconds();
+
+    if (Task->Function != nullptr)
+    {
+        Task->Function(Task->Context, Task->Param);
+    }
+    else
+    {
+        Task->Work();
+    }
+    if (Task->OnFinished)
+    {
+        Task->OnFinished();
+    }
+
+    const double EndSeconds = FPlatformTime::Seconds();
+    GJobExecuteDepth--;
+
+    FWorkQueue& Queue = *Queues[Slot];
+    if (GJobExecuteDepth == 0)
+    {
+        Queue.BusySeconds += EndSeconds - StartSeconds;
+    }
+    if (bTracing.load(std::memory_order_relaxed))
+    {
+        Queue.Trace.Add({ Name, Slot, StartSeconds, EndSeconds });
+    }
+
+    if (Counter != nullptr)
+    {
+        Counter->fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void FJobSystem::WorkerLoop(int32 Slot)
+{
+    GCurrentJobSystem = this;
+    GCurrentJobSlot = Slot;
+
+    while (!bStopping)
+    {
+        if (FJobTask* Task = FindTask(Slot))
+        {
+            Execute(Task, Slot);
+        }
+        else
+        {
+            // Timed wait: a missed trigger costs at most a couple of milliseconds.
+            WorkAvailable->Wait(2);
+        }
+    }
+
+    GCurrentJobSystem = nullptr;
+    GCurrentJobSlot = INDEX_NONE;
+}
+
+void FJobSystem::WaitFor(const std::atomic<int32>& Counter)
+{
+    const int32 Slot = GetCurrentSlot();
+    while (Counter.load(std::memory_order_acquire) > 0)
+    {
+        if (FJobTask* Task = FindTask(Slot))
+        {
+            Execute(Task, Slot);
+        }
+        else
+        {
+            // Remaining tasks are running on other threads.
+            FPlatformProcess::YieldThread();
+        }
+    }
+}
+
+void FJobSystem::ParallelFor(const TCHAR* Name, int32 Num, int32 MinBatchSize, TFunctionRef<void(int32)> Body)
+{
+    if (Num <= 0)
+        return;
+
+    // A few batches per slot leaves room for stealing to even out uneven batches.
+    const int32 MaxBatches = GetNumSlots() * 4;
+    int32 NumBatches = FMath::Clamp(FMath::DivideAndRoundUp(Num, FMath::Max(1, MinBatchSize)), 1, MaxBatches);
+    if (NumBatches == 1 || GetNumWorkers() == 0)
+    {
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Body(i);
+        }
+        return;
+    }
+
+    const int32 BatchSize = FMath::DivideAndRoundUp(Num, NumBatches);
+    NumBatches = FMath::DivideAndRoundUp(Num, BatchSize);
+
+    // Batches run through a plain function pointer so a ParallelFor never touches the heap
+    // (up to 64 batches fit the inline task storage).
+    struct FBatchContext
+    {
+        TFunctionRef<void(int32)>* Body;
+        int32 BatchSize;
+        int32 Num;
+    };
+    FBatchContext Context{ &Body, BatchSize, Num };
+
+    std::atomic<int32> Remaining(NumBatches);
+    TArray<FJobTask, TInlineAllocator<64>> Tasks;
+    Tasks.SetNum(NumBatches);
+
+    for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+    {
+        FJobTask& Task = Tasks[Batch];
+        Task.Name = Name;
+        Task.Counter = &Remaining;
+        Task.Context = &Context;
+        Task.Param = Batch;
+        Task.Function = [](void* InContext, int32 InBatch)
+        {
+            const FBatchContext& BatchContext = *static_cast<const FBatchContext*>(InContext);
+            const int32 Begin = InBatch * BatchContext.BatchSize;
+            const int32 End = FMath::Min(BatchContext.Num, Begin + BatchContext.BatchSize);
+            for (int32 i = Begin; i < End; ++i)
+            {
+                (*BatchContext.Body)(i);
+            }
+        };
+    }
+
+    // Publish all but the first batch, run that one here, then help with the rest.
+    for (int32 Batch = 1; Batch < NumBatches; ++Batch)
+    {
+        Submit(&Tasks[Batch]);
+    }
+    Execute(&Tasks[0], GetCurrentSlot());
+    WaitFor(Remaining);
+}
+
+void FJobSystem::BeginTrace()
+{
+    for (TUniquePtr<FWorkQueue>& Queue : Queues)
+    {
+        Queue->Trace.Reset();
+        Queue->BusySeconds = 0.0;
+    }
+    TraceStartSeconds = FPlatformTime::Seconds();
+    bTracing = true;
+}
+
+void FJobSystem::EndTrace(TArray<FJobTraceEvent>& OutEvents, TArray<float>& OutUtilization)
+{
+    bTracing = false;
+    const double WindowSeconds = FMath::Max(FPlatformTime::Seconds() - TraceStartSeconds, UE_SMALL_NUMBER);
+
+    OutEvents.Reset();
+    OutUtilization.Reset();
+    for (TUniquePtr<FWorkQueue>& Queue : Queues)
+    {
+        OutEvents.Append(Queue->Trace);
+        OutUtilization.Add(static_cast<float>(Queue->BusySeconds / WindowSeconds));
+        Queue->Trace.Reset();
+    }
+}
+
+bool FJobSystem::SaveChromeTrace(const FString& Path, const TArray<FJobTraceEvent>& Events, double OriginSeconds)
+{
+    // Complete events ("ph":"X") in microseconds; tid is the slot so each worker gets its own row.
+    FString Json = TEXT("{\"traceEvents\":[\n");
+    for (int32 i = 0; i < Events.Num(); ++i)
+    {
+        const FJobTraceEvent& Event = Events[i];
+        Json += FString::Printf(TEXT("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}%s\n"),
+            Event.Name, Event.Slot,
+            (Event.StartSeconds - OriginSeconds) * 1000000.0,
+            (Event.EndSeconds - Event.StartSeconds) * 1000000.0,
+            i + 1 < Events.Num() ? TEXT(",") : TEXT(""));
+    }
+    Json += TEXT("]}\n");
+
+    return FFileHelper::SaveStringToFile(Json, *Path);
+}
+
+FJobList::FHandle FJobList::Add(const TCHAR* Name, TFunction<void()> Work, std::initializer_list<FHandle> Dependencies)
+{
+    const FHandle Handle = Nodes.Num();
+
+    TUniquePtr<FNode> Node = MakeUnique<FNode>();
+    Node->Task.Name = Name;
+    Node->Task.Work = MoveTemp(Work);
+    Node->Task.Counter = &Remaining;
+    Node->Task.OnFinished = [this, Handle]() { ReleaseDependents(Handle); };
+
+    for (FHandle Dependency : Dependencies)
+    {
+        check(Dependency >= 0 && Dependency < Handle);
+        Nodes[Dependency]->Dependents.Add(Handle);
+        Node->NumDependencies++;
+    }
+
+    Nodes.Add(MoveTemp(Node));
+    return Handle;
+}
+
+void FJobList::ReleaseDependents(FHandle Handle)
+{
+    for (FHandle Dependent : Nodes[Handle]->Dependents)
+    {
+        FNode& Node = *Nodes[Dependent];
+        if (Node.PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            RunningSystem->Submit(&Node.Task);
+        }
+    }
+}
+
+void FJobList::Run(FJobSystem& System)
+{
+    if (Nodes.Num() == 0)
+        return;
+
+    // Arm every counter before anything can finish and release a dependent.
+    RunningSystem = &System;
+    Remaining = Nodes.Num();
+    for (TUniquePtr<FNode>& Node : Nodes)
+    {
+        Node->PendingDependencies = Node->NumDependencies;
+    }
+
+    for (TUniquePtr<FNode>& Node : Nodes)
+    {
+        if (Node->NumDependencies == 0)
+        {
+            System.Submit(&Node->Task);
+        }
+    }
+
+    System.WaitFor(Remaining);
+    RunningSystem = nullptr;
+}
@@ -0,0 +1,170 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Deque.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * FJobTask:
+ * One unit of work for FJobSystem. The submitter owns the task and must keep it alive
+ * until Counter (if any) has been decremented; the executing thread never touches the task afterwards.
+ */
+struct FJobTask
+{
+    // Label used in traces.
+    const TCHAR* Name = TEXT("Job");
+
+    // The work itself.
+    TFunction<void()> Work;
+
+    // Allocation-free alternative to Work: runs Function(Context, Param) when set (ParallelFor batches).
+    void (*Function)(void* Context, int32 Param) = nullptr;
+    void* Context = nullptr;
+    int32 Param = 0;
+
+    // Optional: runs right after Work on the executing thread (FJobList releases dependents here).
+    TFunction<void()> OnFinished;
+
+    // Optional: decremented once the task is complete.
+    std::atomic<int32>* Counter = nullptr;
+};
+
+/**
+ * One executed task, as recorded while a trace is active.
+ */
+struct FJobTraceEvent
+{
+    const TCHAR* Name;
+    int32 Slot;
+    double StartSeconds;
+    double EndSeconds;
+};
+
+/**
+ * FJobSystem:
+ * Small standalone work-stealing scheduler (no engine task graph dependency, so it also runs in headless tools).
+ * * Design:
+ * - One deque per worker thread plus one shared "external" slot for submitting threads (the game thread).
+ * - A thread pops its own deque from the back (LIFO, cache warm) and steals from the front of the others (FIFO).
+ * - Waiting threads (WaitFor, ParallelFor) execute queued tasks instead of blocking, so nested waits can't deadlock
+ *   and the game thread contributes while it waits.
+ * - Deques are guarded by a per-slot lock; tasks are coarse (batches, passes), so contention is negligible.
+ * * Time Complexity: Submit/Pop/Steal O(1).
+ */
+class PROJECT_GOLDFISH_API FJobSystem
+{
+public:
+    // NumWorkers < 0 picks one worker per core minus the game thread (capped at 8). Zero runs everything on the caller.
+    explicit FJobSystem(int32 NumWorkers = -1);
+    ~FJobSystem();
+
+    FJobSystem(const FJobSystem&) = delete;
+    FJobSystem& operator=(const FJobSystem&) = delete;
+
+    int32 GetNumWorkers() const { return Threads.Num(); }
+
+    // Worker slots plus the external slot (last index).
+    int32 GetNumSlots() const { return Queues.Num(); }
+
+    // Queue a task on the calling thread's slot.
+    void Submit(FJobTask* Task);
+
+    // Execute queued tasks on the calling thread until Counter reaches zero.
+    void WaitFor(const std::atomic<int32>& Counter);
+
+    // Run Body(Index) for Index in [0, Num), split into batches of at least MinBatchSize. Returns when all are done.
+    void ParallelFor(const TCHAR* Name, int32 Num, int32 MinBatchSize, TFunctionRef<void(int32)> Body);
+
+    // --- Utilization Trace (call between job batches, from the game thread) ---
+
+    // Start recording executed tasks and reset busy time.
+    void BeginTrace();
+
+    // Stop recording. OutUtilization[Slot] is the busy fraction of each slot over the trace window.
+    void EndTrace(TArray<FJobTraceEvent>& OutEvents, TArray<float>& OutUtilization);
+
+    // Write events as Chrome trace JSON (chrome://tracing, Perfetto): one row per slot.
+    static bool SaveChromeTrace(const FString& Path, const TArray<FJobTraceEvent>& Events, double OriginSeconds);
+
+private:
+    struct FWorkQueue
+    {
+        FCriticalSection Lock;
+        TDeque<FJobTask*> Tasks;
+
+        // Written only by the thread executing on this slot.
+        TArray<FJobTraceEvent> Trace;
+        double BusySeconds = 0.0;
+    };
+
+    class FWorker;
+
+    TArray<TUniquePtr<FWorkQueue>> Queues;
+    TArray<TUniquePtr<FWorker>> Workers;
+    TArray<FRunnableThread*> Threads;
+
+    // Signalled on Submit so idle workers wake up.
+    FEvent* WorkAvailable = nullptr;
+
+    std::atomic<bool> bStopping{ false };
+    std::atomic<bool> bTracing{ false };
+    double TraceStartSeconds = 0.0;
+
+    // Slot of the calling thread (its worker index, or the external slot).
+    int32 GetCurrentSlot() const;
+
+    // Own deque first, then steal round-robin from the other slots.
+    FJobTask* FindTask(int32 Slot);
+
+    void Execute(FJobTask* Task, int32 Slot);
+
+    void WorkerLoop(int32 Slot);
+};
+
+/**
+ * FJobList:
+ * A task graph with dependencies, built once and run every frame.
+ * Dependencies must refer to jobs added earlier, so the graph is acyclic by construction.
+ * Run submits the jobs without dependencies, each finished job releases its dependents,
+ * and the calling thread helps until the whole list is done.
+ */
+class PROJECT_GOLDFISH_API FJobList
+{
+public:
+    using FHandle = int32;
+
+    FHandle Add(const TCHAR* Name, TFunction<void()> Work, std::initializer_list<FHandle> Dependencies = {});
+
+    // Execute every job (respecting dependencies) and return once all have finished.
+    void Run(FJobSystem& System);
+
+    void Reset()
+    {
+        Nodes.Reset();
+    }
+
+    int32 Num() const
+    {
+        return Nodes.Num();
+    }
+
+private:
+    struct FNode
+    {
+        FJobTask Task;
+        TArray<FHandle> Dependents;
+        int32 NumDependencies = 0;
+        std::atomic<int32> PendingDependencies{ 0 };
+    };
+
+    TArray<TUniquePtr<FNode>> Nodes;
+    std::atomic<int32> Remaining{ 0 };
+    FJobSystem* RunningSystem = nullptr;
+
+    void ReleaseDependents(FHandle Handle);
+};
@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PlayerCache.h"
+#include "FpsCharacter.h"
+#include "PlayerStats.h"
+#include "TP_WeaponComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+
+UPlayerCache* UPlayerCache::Get(const UObject* WorldContextObject)
+{
+	UWorld* pWorld = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return pWorld ? pWorld->GetSubsystem<UPlayerCache>() : nullptr;
+}
+
+void UPlayerCache::Deinitialize()
+{
+	if (APlayerController* pController = m_pController.Get())
+	{
+		pController->GetOnNewPawnNotifier().Remove(m_hNewPawn);
+	}
+	m_pController.Reset();
+
+	Super::Deinitialize();
+}
+
+void UPlayerCache::ResolveController()
+{
+	if (m_pController.IsValid())
+		return;
+
+	APlayerController* pController = GetWorld()->GetFirstPlayerController();
+	if (pController == nullptr)
+		return;
+
+	// Possession changes (respawn, vehicle, spectate) refresh the pawn-derived references.
+	m_pController = pController;
+	m_hNewPawn = pController->GetOnNewPawnNotifier().AddUObject(this, &UPlayerCache::HandleNewPawn);
+	HandleNewPawn(pController->GetPawn());
+}
+
+void UPlayerCache::HandleNewPawn(APawn* NewPawn)
+{
+	m_pPawn = NewPawn;
+	m_pCharacter = Cast<AFpsCharacter>(NewPawn);
+	m_pStats = m_pCharacter.IsValid() ? m_pCharacter->Stats : nullptr;
+	m_pWeapon = m_pCharacter.IsValid() ? m_pCharacter->PCurrentWeaponComponent : nullptr;
+}
+
+APlayerController* UPlayerCache::GetPlayerController()
+{
+	ResolveController();
+	return m_pController.Get();
+}
+
+APawn* UPlayerCache::GetPlayerPawn()
+{
+	ResolveController();
+	return m_pPawn.Get();
+}
+
+AFpsCharacter* UPlayerCache::GetPlayerCharacter()
+{
+	ResolveController();
+	return m_pCharacter.Get();
+}
+
+APlayerStats* UPlayerCache::GetPlayerStats()
+{
+	ResolveController();
+
+	// The stats actor may be assigned after possession (character BeginPlay).
+	if (!m_pStats.IsValid() && m_pCharacter.IsValid())
+	{
+		m_pStats = m_pCharacter->Stats;
+	}
+	return m_pStats.Get();
+}
+
+UTP_WeaponComponent* UPlayerCache::GetPlayerWeapon()
+{
+	ResolveController();
+
+	AFpsCharacter* pCharacter = m_pCharacter.Get();
+	if (pCharacter == nullptr)
+		return nullptr;
+
+	// Equipping a new weapon swaps the component; a pointer compare keeps the cache honest.
+	if (m_pWeapon.Get() != pCharacter->PCurrentWeaponComponent)
+	{
+		m_pWeapon = pCharacter->PCurrentWeaponComponent;
+	}
+	return m_pWeapon.Get();
+}
+
+bool UPlayerCache::GetPlayerLocation(FVector& OutLocation)
+{
+	APawn* pPawn = GetPlayerPawn();
+	if (pPawn == nullptr)
+		return false;
+
+	OutLocation = pPawn->GetActorLocation();
+	return true;
+}
+
+void UPlayerCache::BenchmarkPlayerLookup(int32 Lookups, float& OutGlobalLookupMs, float& OutCachedLookupMs)
+{
+	UWorld* pWorld = GetWorld();
+	Lookups = FMath::Max(1, Lookups);
+
+	// Accumulate something from each lookup so the loops can't be optimized away.
+	int64 iChecksum = 0;
+
+	double startTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Lookups; i++)
+	{
+		APlayerController* pController = UGameplayStatics::GetPlayerController(pWorld, 0);
+		AFpsCharacter* pCharacter = pController ? Cast<AFpsCharacter>(pController->GetPawn()) : nullptr;
+		iChecksum += (pCharacter != nullptr);
+	}
+	OutGlobalLookupMs = (float)((FPlatformTime::Seconds() - startTime) * 1000.0);
+
+	startTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Lookups; i++)
+	{
+		iChecksum += (GetPlayerCharacter() != nullptr);
+	}
+	OutCachedLookupMs = (float)((FPlatformTime::Seconds() - startTime) * 1000.0);
+
+	UE_LOG(LogTemp, Log, TEXT("[Player Cache] %d lookups: global %.3f ms, cached %.3f ms (%.1fx) [%lld]"),
+		Lookups, OutGlobalLookupMs, OutCachedLookupMs,
+		OutCachedLookupMs > 0.0f ? OutGlobalLookupMs / OutCachedLookupMs : 0.0f, iChecksum);
+}
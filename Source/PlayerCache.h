@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PlayerCache.generated.h"
+
+class APlayerController;
+class APawn;
+class AFpsCharacter;
+class APlayerStats;
+class UTP_WeaponComponent;
+
+/**
+ * UPlayerCache:
+ * Owns weak references to the local player's controller, character, stats actor and weapon component,
+ * so hot paths (behavior tree tasks, enemy attacks, directors, batched subsystems) read a pointer
+ * instead of calling GetPlayerController/GetPlayerCharacter and casting every time.
+ * - The controller is resolved once; the character/stats are refreshed when the controller possesses a new pawn.
+ * - The weapon is re-read only when the character's equipped weapon component changes.
+ * All getters may return null (no player yet, or the pawn was destroyed).
+ */
+UCLASS()
+class PROJECT_GOLDFISH_API UPlayerCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Convenience accessor from any world context object. Returns null without a world.
+	static UPlayerCache* Get(const UObject* WorldContextObject);
+
+	APlayerController* GetPlayerController();
+	APawn* GetPlayerPawn();
+	AFpsCharacter* GetPlayerCharacter();
+	APlayerStats* GetPlayerStats();
+	UTP_WeaponComponent* GetPlayerWeapon();
+
+	// Player pawn location; returns false if there is no pawn.
+	bool GetPlayerLocation(FVector& OutLocation);
+
+	/**
+	 * Compare Lookups global player lookups (GetPlayerController + GetPawn + Cast, as the old call sites did)
+	 * against the same number of cached lookups. Lookups ~ enemies x player queries per enemy per frame.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Performance")
+	void BenchmarkPlayerLookup(int32 Lookups, float& OutGlobalLookupMs, float& OutCachedLookupMs);
+
+	// USubsystem
+	virtual void Deinitialize() override;
+
+private:
+	TWeakObjectPtr<APlayerController> m_pController;
+	TWeakObjectPtr<APawn> m_pPawn;
+	TWeakObjectPtr<AFpsCharacter> m_pCharacter;
+	TWeakObjectPtr<APlayerStats> m_pStats;
+	TWeakObjectPtr<UTP_WeaponComponent> m_pWeapon;
+
+	FDelegateHandle m_hNewPawn;
+
+	// Resolve the controller and bind to its possession notifications (only when not cached yet).
+	void ResolveController();
+
+	// Refresh everything derived from the possessed pawn.
+	void HandleNewPawn(APawn* NewPawn);
+};
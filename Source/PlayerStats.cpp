@@ -34,8 +34,8 @@ int APlayerStats::AddPoints(int amount)
     // Safely update points within valid range
     m_iPoints = FMath::Clamp(m_iPoints + amount, 0, MaximumPoints);
 
-    // Notify all listeners (e.g., UI, gameplay systems)
-    OnPointsChanged.Broadcast(m_iPoints);
+    // Notify all listeners (e.g., UI, gameplay systems), coalesced per frame
+    NotifyPointsChanged();
 
     return m_iPoints;
 }
@@ -49,8 +49,8 @@ int APlayerStats::RemovePoints(int amount)
     // Safely update points within valid range
     m_iPoints = FMath::Clamp(m_iPoints - amount, 0, MaximumPoints);
 
-    // Notify all listeners (e.g., UI, gameplay systems)
-    OnPointsChanged.Broadcast(m_iPoints);
+    // Notify all listeners (e.g., UI, gameplay systems), coalesced per frame
+    NotifyPointsChanged();
 
     return m_iPoints;
 }
@@ -64,10 +64,44 @@ void APlayerStats::BeginPlay()
 {
     Super::BeginPlay();
 
+    // Forward coalesced point updates from the UI event bus
+    if (UUIEventBus* pBus = GetWorld()->GetSubsystem<UUIEventBus>())
+    {
+        pBus->OnChannelChanged.AddDynamic(this, &APlayerStats::HandleUIChannelChanged);
+    }
+
     // Ensure initial point value is communicated to listeners
     OnPointsChanged.Broadcast(m_iPoints);
 }
 
+/**
+ * Marks the Points channel dirty; the bus broadcasts once per flush
+ * however many times points change in between.
+ */
+void APlayerStats::NotifyPointsChanged()
+{
+    UUIEventBus* pBus = GetWorld() ? GetWorld()->GetSubsystem<UUIEventBus>() : nullptr;
+    if (pBus == nullptr)
+    {
+        OnPointsChanged.Broadcast(m_iPoints);
+        return;
+    }
+
+    pBus->Publish(EUIChannel::Points, m_iPoints);
+}
+
+/**
+ * Re-broadcasts flushed point totals on this actor's own delegate,
+ * so existing bindings to OnPointsChanged keep working.
+ */
+void APlayerStats::HandleUIChannelChanged(EUIChannel Channel, int32 Value, int32 SecondaryValue)
+{
+    if (Channel == EUIChannel::Points)
+    {
+        OnPointsChanged.Broadcast(Value);
+    }
+}
+
 /**
  * Called every frame.
  * Currently unused as ticking is disabled.
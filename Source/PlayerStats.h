@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "UIEventBus.h"
 #include "PlayerStats.generated.h"
 
 /**
@@ -33,6 +34,7 @@ public:
 	/**
 	 * Event triggered whenever the player's point total is updated.
 	 * Can be bound to UI widgets or gameplay systems via Blueprints.
+	 * Routed through UUIEventBus, so it fires at most once per flush with the latest total.
 	 */
 	UPROPERTY(BlueprintAssignable)
 	FOnPointsChanged OnPointsChanged;
@@ -87,6 +89,17 @@ public:
 	virtual void Tick(float DeltaTime) override;
 
 private:
+	/**
+	 * Publishes the point total to the UI event bus (or broadcasts directly if there is none).
+	 */
+	void NotifyPointsChanged();
+
+	/**
+	 * Forwards flushed Points channel updates to OnPointsChanged.
+	 */
+	UFUNCTION()
+	void HandleUIChannelChanged(EUIChannel Channel, int32 Value, int32 SecondaryValue);
+
 	/**
 	 * Stores the current number of player points.
 	 * Kept private to enforce controlled access via functions.
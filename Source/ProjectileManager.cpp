@@ -0,0 +1,418 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectileManager.h"
+#include "project_goldfishProjectile.h"
+#include "EnemyDirectorEnhanced.h"
+#include "Enemy.h"
+#include "HealthInterface.h"
+#include "Components/CapsuleComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Math/VectorRegister.h"
+#include "PlayerCache.h"
+
+namespace
+{
+	template<typename T>
+	void RemoveSwap(TArray<T>& Array, int32 Index)
+	{
+		Array.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+bool UProjectileManager::SpawnProjectile(const FVector& Location, const FVector& Velocity, float InDamage, AActor* Instigator)
+{
+	if (PosX.Num() >= m_iMaxProjectiles)
+		return false;
+
+	PosX.Add((float)Location.X);
+	PosY.Add((float)Location.Y);
+	PosZ.Add((float)Location.Z);
+	VelX.Add((float)Velocity.X);
+	VelY.Add((float)Velocity.Y);
+	VelZ.Add((float)Velocity.Z);
+	Damage.Add(InDamage);
+	Bounces.Add(0);
+	Instigators.Add(Instigator);
+
+	const FSlotMapHandle id = m_ProjectileIndices.Insert(PosX.Num() - 1);
+	ProjectileIDs.Add(id);
+	LifetimeTimers.Add(m_LifetimeWheel.Schedule(m_fLifeSpan, id));
+	return true;
+}
+
+void UProjectileManager::SetProxyClass(TSubclassOf<Aproject_goldfishProjectile> InProxyClass)
+{
+	if (InProxyClass == nullptr || InProxyClass == m_cProxyClass)
+		return;
+
+	// Proxies of the old class are released; the pool refills lazily with the new one.
+	for (Aproject_goldfishProjectile* pProxy : m_pProxies)
+	{
+		if (IsValid(pProxy))
+		{
+			pProxy->Destroy();
+		}
+	}
+	m_pProxies.Reset();
+	m_cProxyClass = InProxyClass;
+}
+
+void UProjectileManager::GetSimulationStats(int32& OutProjectiles, int32& OutVisibleProxies, float& OutSimulationTimeMs) const
+{
+	OutProjectiles = PosX.Num();
+	OutVisibleProxies = m_iVisibleProxies;
+	OutSimulationTimeMs = m_fSimulationTime * 1000.0f;
+}
+
+void UProjectileManager::ClearProjectiles()
+{
+	PosX.Reset(); PosY.Reset(); PosZ.Reset();
+	VelX.Reset(); VelY.Reset(); VelZ.Reset();
+	Damage.Reset();
+	Bounces.Reset();
+	Instigators.Reset();
+	ProjectileIDs.Reset();
+	LifetimeTimers.Reset();
+	m_ProjectileIndices.Clear();
+	m_LifetimeWheel.Clear();
+
+	for (Aproject_goldfishProjectile* pProxy : m_pProxies)
+	{
+		if (IsValid(pProxy))
+		{
+			pProxy->SetActorHiddenInGame(true);
+		}
+	}
+	m_iVisibleProxies = 0;
+}
+
+void UProjectileManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	m_pDirector = Cast<AEnemyDirectorEnhanced>(UGameplayStatics::GetActorOfClass(&InWorld, AEnemyDirectorEnhanced::StaticClass()));
+}
+
+void UProjectileManager::Deinitialize()
+{
+	ClearProjectiles();
+	m_pProxies.Reset();
+
+	Super::Deinitialize();
+}
+
+void UProjectileManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	double startTime = FPlatformTime::Seconds();
+
+	if (PosX.Num() > 0)
+	{
+		// Remember where each projectile started this step for the swept tests.
+		const int32 iNum = PosX.Num();
+		PrevPositions.SetNumUninitialized(iNum, EAllowShrinking::No);
+		for (int32 i = 0; i < iNum; i++)
+		{
+			PrevPositions[i] = FVector(PosX[i], PosY[i], PosZ[i]);
+		}
+		bDead.Init(false, iNum);
+
+		Integrate(DeltaTime);
+		ExpireLifetimes(DeltaTime);
+		GatherEnemyCapsules();
+		SweepAndBounce();
+		ApplyHits();
+		RemoveDead();
+	}
+
+	UpdateVisualProxies();
+
+	m_fSimulationTime = static_cast<float>(FPlatformTime::Seconds() - startTime);
+}
+
+TStatId UProjectileManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileManager, STATGROUP_Tickables);
+}
+
+void UProjectileManager::Integrate(float DeltaTime)
+{
+	/*
+	 * Semi-implicit Euler over the SoA buffers, four projectiles per iteration.
+	 * v.z += g * dt; p += v * dt
+	 */
+	const int32 iNum = PosX.Num();
+	float* px = PosX.GetData(); float* py = PosY.GetData(); float* pz = PosZ.GetData();
+	float* vx = VelX.GetData(); float* vy = VelY.GetData(); float* vz = VelZ.GetData();
+
+	const VectorRegister4Float vDeltaTime = VectorSetFloat1(DeltaTime);
+	const VectorRegister4Float vGravityStep = VectorSetFloat1(m_fGravityZ * DeltaTime);
+
+	int32 i = 0;
+	for (; i + 4 <= iNum; i += 4)
+	{
+		const VectorRegister4Float newVz = VectorAdd(VectorLoad(vz + i), vGravityStep);
+		VectorStore(newVz, vz + i);
+
+		VectorStore(VectorMultiplyAdd(VectorLoad(vx + i), vDeltaTime, VectorLoad(px + i)), px + i);
+		VectorStore(VectorMultiplyAdd(VectorLoad(vy + i), vDeltaTime, VectorLoad(py + i)), py + i);
+		VectorStore(VectorMultiplyAdd(newVz, vDeltaTime, VectorLoad(pz + i)), pz + i);
+	}
+
+	// Scalar tail.
+	for (; i < iNum; i++)
+	{
+		vz[i] += m_fGravityZ * DeltaTime;
+		px[i] += vx[i] * DeltaTime;
+		py[i] += vy[i] * DeltaTime;
+		pz[i] += vz[i] * DeltaTime;
+	}
+}
+
+void UProjectileManager::ExpireLifetimes(float DeltaTime)
+{
+	// Only projectiles whose lifespan ran out this step are touched (no per-projectile countdown).
+	m_LifetimeWheel.Advance(DeltaTime, [this](const FSlotMapHandle& id)
+	{
+		if (const int32* pIndex = m_ProjectileIndices.Find(id))
+		{
+			bDead[*pIndex] = true;
+			LifetimeTimers[*pIndex] = FSlotMapHandle();
+		}
+	});
+}
+
+void UProjectileManager::GatherEnemyCapsules()
+{
+	m_EnemyCapsules.Reset();
+	if (!m_pDirector.IsValid())
+		return;
+
+	// One Quadtree query over the XY bounds swept by every projectile this step.
+	FBox2D bounds(ForceInit);
+	for (int32 i = 0; i < PosX.Num(); i++)
+	{
+		bounds += FVector2D(PrevPositions[i].X, PrevPositions[i].Y);
+		bounds += FVector2D(PosX[i], PosY[i]);
+	}
+	bounds = bounds.ExpandBy(100.0f + m_fRadius);
+
+	m_pCandidates.Reset();
+	m_pDirector->QueryEnemiesInBox(bounds.Min, bounds.Max, m_pCandidates);
+
+	for (AActor* pActor : m_pCandidates)
+	{
+		AEnemy* pEnemy = Cast<AEnemy>(pActor);
+		if (pEnemy == nullptr || !pEnemy->BInArena)
+			continue;
+
+		const UCapsuleComponent* pCapsule = pEnemy->GetCapsuleComponent();
+		const FVector center = pCapsule->GetComponentLocation();
+		const FVector axis = pCapsule->GetUpVector() * pCapsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+		const float fRadius = pCapsule->GetScaledCapsuleRadius() + m_fRadius;
+
+		FEnemyCapsule& capsule = m_EnemyCapsules.AddDefaulted_GetRef();
+		capsule.Enemy = pEnemy;
+		capsule.A = center - axis;
+		capsule.B = center + axis;
+		capsule.Radius = fRadius;
+		capsule.Bounds = FBox(capsule.A.ComponentMin(capsule.B), capsule.A.ComponentMax(capsule.B)).ExpandBy(fRadius);
+	}
+}
+
+void UProjectileManager::SweepAndBounce()
+{
+	UWorld* pWorld = GetWorld();
+	const bool bUseIndex = m_pDirector.IsValid();
+
+	// With the enemy index available only occluders need tracing (the same static and dynamic geometry that
+	// blocks hitscan: walls, doors, physics props); otherwise pawns are traced too.
+	FCollisionObjectQueryParams objectParams(ECC_WorldStatic);
+	objectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	if (!bUseIndex)
+	{
+		objectParams.AddObjectTypesToQuery(ECC_Pawn);
+	}
+	FCollisionQueryParams queryParams(SCENE_QUERY_STAT(ProjectileSweep), false);
+
+	for (int32 i = 0; i < PosX.Num(); i++)
+	{
+		if (bDead[i])
+			continue;
+
+		const FVector start = PrevPositions[i];
+		const FVector end(PosX[i], PosY[i], PosZ[i]);
+		AActor* pInstigator = Instigators[i].Get();
+
+		// Enemies: swept sphere vs capsule, culled by bounding boxes first.
+		AActor* pEnemyHit = nullptr;
+		float fEnemyTime = 1.0f;
+		const FBox sweepBounds(start.ComponentMin(end), start.ComponentMax(end));
+		const float fLength = FVector::Dist(start, end);
+		for (const FEnemyCapsule& capsule : m_EnemyCapsules)
+		{
+			if (capsule.Enemy == pInstigator || !capsule.Bounds.Intersect(sweepBounds))
+				continue;
+
+			FVector closestOnPath;
+			FVector closestOnAxis;
+			FMath::SegmentDistToSegmentSafe(start, end, capsule.A, capsule.B, closestOnPath, closestOnAxis);
+			if (FVector::DistSquared(closestOnPath, closestOnAxis) <= capsule.Radius * capsule.Radius)
+			{
+				const float fTime = fLength > KINDA_SMALL_NUMBER ? (float)(FVector::Dist(start, closestOnPath) / fLength) : 0.0f;
+				if (pEnemyHit == nullptr || fTime < fEnemyTime)
+				{
+					pEnemyHit = capsule.Enemy;
+					fEnemyTime = fTime;
+				}
+			}
+		}
+
+		// World geometry.
+		FHitResult worldHit;
+		const bool bWorldHit = pWorld->LineTraceSingleByObjectType(worldHit, start, end, objectParams, queryParams);
+
+		if (pEnemyHit != nullptr && (!bWorldHit || fEnemyTime <= worldHit.Time))
+		{
+			m_HitQueue.Add({ pEnemyHit, Damage[i] });
+			bDead[i] = true;
+			continue;
+		}
+
+		if (!bWorldHit)
+			continue;
+
+		if (!bUseIndex && Cast<IHealthInterface>(worldHit.GetActor()) != nullptr)
+		{
+			m_HitQueue.Add({ worldHit.GetActor(), Damage[i] });
+			bDead[i] = true;
+			continue;
+		}
+
+		// Bounce: reflect the normal component (scaled by bounciness) and damp the tangential one.
+		if (Bounces[i] >= m_iMaxBounces)
+		{
+			bDead[i] = true;
+			continue;
+		}
+
+		const FVector normal = worldHit.ImpactNormal;
+		const FVector velocity(VelX[i], VelY[i], VelZ[i]);
+		const FVector normalVelocity = FVector::DotProduct(velocity, normal) * normal;
+		const FVector newVelocity = (velocity - normalVelocity) * (1.0f - m_fFriction) - normalVelocity * m_fBounciness;
+		const FVector newPosition = worldHit.Location + normal * m_fRadius;
+
+		VelX[i] = (float)newVelocity.X; VelY[i] = (float)newVelocity.Y; VelZ[i] = (float)newVelocity.Z;
+		PosX[i] = (float)newPosition.X; PosY[i] = (float)newPosition.Y; PosZ[i] = (float)newPosition.Z;
+		Bounces[i]++;
+	}
+}
+
+void UProjectileManager::ApplyHits()
+{
+	// Single damage pass once the whole step has been simulated.
+	for (const FProjectileHit& hit : m_HitQueue)
+	{
+		if (IHealthInterface* pHealth = Cast<IHealthInterface>(hit.Target.Get()))
+		{
+			pHealth->ReceiveDamage(hit.Damage);
+		}
+	}
+	m_HitQueue.Reset();
+}
+
+void UProjectileManager::RemoveDead()
+{
+	// Backwards so each swap pulls in an element that has already been checked.
+	for (int32 i = PosX.Num() - 1; i >= 0; i--)
+	{
+		if (!bDead[i])
+			continue;
+
+		// Projectiles removed early (hits, bounces) still have a pending lifetime timer.
+		m_LifetimeWheel.Cancel(LifetimeTimers[i]);
+		m_ProjectileIndices.Remove(ProjectileIDs[i]);
+
+		RemoveSwap(PosX, i); RemoveSwap(PosY, i); RemoveSwap(PosZ, i);
+		RemoveSwap(VelX, i); RemoveSwap(VelY, i); RemoveSwap(VelZ, i);
+		RemoveSwap(Damage, i);
+		RemoveSwap(Bounces, i);
+		RemoveSwap(Instigators, i);
+		RemoveSwap(ProjectileIDs, i);
+		RemoveSwap(LifetimeTimers, i);
+
+		// The last projectile moved into slot i.
+		if (i < PosX.Num())
+		{
+			*m_ProjectileIndices.Find(ProjectileIDs[i]) = i;
+		}
+	}
+}
+
+void UProjectileManager::UpdateVisualProxies()
+{
+	int32 iVisible = 0;
+
+	APlayerController* pController = GetWorld()->GetSubsystem<UPlayerCache>()->GetPlayerController();
+	if (pController != nullptr && pController->PlayerCameraManager != nullptr && m_cProxyClass != nullptr)
+	{
+		const FVector cameraLocation = pController->PlayerCameraManager->GetCameraLocation();
+		const FVector cameraForward = pController->PlayerCameraManager->GetCameraRotation().Vector();
+		// Half the horizontal FOV plus a margin so proxies don't pop at the screen edge.
+		const float fCosHalfFov = FMath::Cos(FMath::DegreesToRadians(pController->PlayerCameraManager->GetFOVAngle() * 0.5f + 10.0f));
+		const float fMaxDistanceSquared = m_fMaxProxyDistance * m_fMaxProxyDistance;
+
+		for (int32 i = 0; i < PosX.Num() && iVisible < m_iMaxVisualProxies; i++)
+		{
+			const FVector location(PosX[i], PosY[i], PosZ[i]);
+			const FVector toProjectile = location - cameraLocation;
+			const double distanceSquared = toProjectile.SizeSquared();
+			if (distanceSquared > fMaxDistanceSquared)
+				continue;
+			if (FVector::DotProduct(toProjectile, cameraForward) < fCosHalfFov * FMath::Sqrt(distanceSquared))
+				continue;
+
+			Aproject_goldfishProjectile* pProxy = GetProxy(iVisible);
+			if (pProxy == nullptr)
+				break;
+
+			pProxy->SetActorLocationAndRotation(location, FVector(VelX[i], VelY[i], VelZ[i]).Rotation());
+			pProxy->SetActorHiddenInGame(false);
+			iVisible++;
+		}
+	}
+
+	// Hide the proxies that weren't needed this frame.
+	for (int32 i = iVisible; i < m_iVisibleProxies && i < m_pProxies.Num(); i++)
+	{
+		if (IsValid(m_pProxies[i]))
+		{
+			m_pProxies[i]->SetActorHiddenInGame(true);
+		}
+	}
+	m_iVisibleProxies = iVisible;
+}
+
+Aproject_goldfishProjectile* UProjectileManager::GetProxy(int32 Index)
+{
+	if (Index < m_pProxies.Num())
+	{
+		return m_pProxies[Index];
+	}
+
+	// Grow the pool lazily; proxies are reused for the rest of the world's lifetime.
+	FActorSpawnParameters spawnParams;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	Aproject_goldfishProjectile* pProxy = GetWorld()->SpawnActor<Aproject_goldfishProjectile>(m_cProxyClass, FTransform::Identity, spawnParams);
+	if (pProxy == nullptr)
+	{
+		return nullptr;
+	}
+
+	pProxy->MakeVisualProxy();
+	m_pProxies.Add(pProxy);
+	return pProxy;
+}
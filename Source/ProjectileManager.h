@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CustomSlotMap.h"
+#include "CustomTimerWheel.h"
+#include "ProjectileManager.generated.h"
+
+class AEnemyDirectorEnhanced;
+class Aproject_goldfishProjectile;
+
+/**
+ * UProjectileManager:
+ * Simulates projectiles as plain data instead of one actor each.
+ * - Storage: Structure of Arrays (positions and velocities in separate float arrays), swap-removal on death.
+ * - Lifetimes: one CustomTimerWheel entry per projectile instead of a per-frame age countdown.
+ * - Integration: 4-wide SIMD (VectorRegister) semi-implicit Euler with gravity, scalar tail.
+ * - Collision: swept segment tests against enemy capsules from one Quadtree query per frame,
+ *   plus a line trace against static world geometry for bounces.
+ * - Rendering: a fixed pool of Aproject_goldfishProjectile actors used as visual proxies,
+ *   assigned each frame only to projectiles in front of the camera and within range.
+ * Damage is applied in one pass after the simulation step.
+ */
+UCLASS()
+class PROJECT_GOLDFISH_API UProjectileManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Launch a projectile. Returns false if the simulation is at capacity.
+	bool SpawnProjectile(const FVector& Location, const FVector& Velocity, float Damage, AActor* Instigator);
+
+	// Actor class used for the pooled visual proxies (usually a Blueprint child with a mesh).
+	void SetProxyClass(TSubclassOf<Aproject_goldfishProjectile> InProxyClass);
+
+	// Number of live simulated projectiles.
+	UFUNCTION(BlueprintPure, Category="Projectiles")
+	int32 GetNumProjectiles() const { return PosX.Num(); }
+
+	// Time spent in the last simulation step, and how many proxies were drawn.
+	UFUNCTION(BlueprintPure, Category="Performance")
+	void GetSimulationStats(int32& OutProjectiles, int32& OutVisibleProxies, float& OutSimulationTimeMs) const;
+
+	// Remove every projectile and hide all proxies.
+	UFUNCTION(BlueprintCallable, Category="Projectiles")
+	void ClearProjectiles();
+
+	// UTickableWorldSubsystem
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Simulation settings (match the old Aproject_goldfishProjectile defaults).
+	int32 m_iMaxProjectiles = 4096;
+	float m_fLifeSpan = 3.0f;
+	float m_fRadius = 5.0f;
+	float m_fGravityZ = -980.0f;
+	float m_fBounciness = 0.6f;
+	float m_fFriction = 0.2f;
+	int32 m_iMaxBounces = 3;
+
+	// Visual proxy settings.
+	int32 m_iMaxVisualProxies = 256;
+	float m_fMaxProxyDistance = 6000.0f;
+
+private:
+	// Hot data: one array per component so the integrator streams contiguous floats.
+	TArray<float> PosX, PosY, PosZ;
+	TArray<float> VelX, VelY, VelZ;
+
+	// Cold data: only touched on hits.
+	TArray<float> Damage;
+	TArray<uint8> Bounces;
+	TArray<TWeakObjectPtr<AActor>> Instigators;
+
+	// Stable projectile IDs and their lifetime timers (both invalidated when the projectile is removed).
+	TArray<FSlotMapHandle> ProjectileIDs;
+	TArray<FSlotMapHandle> LifetimeTimers;
+
+	// Projectile ID -> current SoA index, fixed up on swap-removal so timers survive reordering.
+	CustomSlotMap<int32> m_ProjectileIndices;
+
+	// Fires once per projectile when its lifespan runs out (payload: projectile ID).
+	CustomTimerWheel<FSlotMapHandle> m_LifetimeWheel{ 1.0f / 120.0f };
+
+	// Start-of-step positions for swept tests.
+	TArray<FVector> PrevPositions;
+
+	// Projectiles flagged for removal this step.
+	TArray<bool> bDead;
+
+	// Hits found during the step, applied in one pass afterwards.
+	struct FProjectileHit
+	{
+		TWeakObjectPtr<AActor> Target;
+		float Damage = 0.0f;
+	};
+	TArray<FProjectileHit> m_HitQueue;
+
+	// Enemy capsules gathered once per step from the spatial index.
+	struct FEnemyCapsule
+	{
+		AActor* Enemy;
+		FVector A;
+		FVector B;
+		float Radius;
+		FBox Bounds;
+	};
+	TArray<FEnemyCapsule> m_EnemyCapsules;
+	TArray<AActor*> m_pCandidates;
+
+	UPROPERTY()
+	TSubclassOf<Aproject_goldfishProjectile> m_cProxyClass;
+
+	// Pooled visual proxies; reused for the world's lifetime (replaced only if the proxy class changes).
+	UPROPERTY()
+	TArray<Aproject_goldfishProjectile*> m_pProxies;
+
+	TWeakObjectPtr<AEnemyDirectorEnhanced> m_pDirector;
+
+	// Stats.
+	int32 m_iVisibleProxies = 0;
+	float m_fSimulationTime = 0.0f;
+
+	void Integrate(float DeltaTime);
+	void ExpireLifetimes(float DeltaTime);
+	void GatherEnemyCapsules();
+	void SweepAndBounce();
+	void ApplyHits();
+	void RemoveDead();
+	void UpdateVisualProxies();
+	Aproject_goldfishProjectile* GetProxy(int32 Index);
+};
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "FrameAllocator.h"
+#include "CustomSmallVector.h"
 
 /**
  * Quadtree:
@@ -65,7 +67,9 @@ private:
     static const int32 MAX_DEPTH = 8;
 
     FQuadtreeBounds Boundary;
-    TArray<FQuadtreePoint> Points;
+
+    // Leaf points: MAX_CAPACITY fit inline in the node, only overfull MAX_DEPTH leaves spill to the heap.
+    CustomSmallVector<FQuadtreePoint, MAX_CAPACITY> Points;
     int32 CurrentDepth;
 
     TSharedPtr<FQuadtree> NorthWest;
@@ -98,13 +102,12 @@ private:
 
         bSubdivided = true;
 
-        TArray<FQuadtreePoint> PointsCopy = Points;
-        Points.Empty();
-
-        for (const FQuadtreePoint& Point : PointsCopy)
+        // Children never touch this node's Points, so they can be moved down without a copy.
+        for (const FQuadtreePoint& Point : Points)
         {
             InsertIntoChildren(Point);
         }
+        Points.Reset();
     }
 
     bool InsertIntoChildren(const FQuadtreePoint& Point)
@@ -122,7 +125,6 @@ public:
         , CurrentDepth(Depth)
         , bSubdivided(false)
     {
-        Points.Reserve(MAX_CAPACITY);
     }
 
     bool Insert(const FQuadtreePoint& Point)
@@ -132,7 +134,8 @@ public:
             return false;
         }
 
-        if (!bSubdivided && Points.Num() < MAX_CAPACITY)
+        // Leaves at MAX_DEPTH cannot subdivide, so they keep growing past MAX_CAPACITY instead.
+        if (!bSubdivided && (Points.Num() < MAX_CAPACITY || CurrentDepth >= MAX_DEPTH))
         {
             Points.Add(Point);
             return true;
@@ -146,7 +149,9 @@ public:
         return InsertIntoChildren(Point);
     }
 
-    void Query(const FQuadtreeBounds& Range, TArray<FQuadtreePoint>& OutPoints) const
+    // OutPoints can be any container with Add (TArray with any allocator, CustomSmallVector).
+    template<typename ContainerType>
+    void Query(const FQuadtreeBounds& Range, ContainerType& OutPoints) const
     {
         if (!Boundary.Intersects(Range))
         {
@@ -170,10 +175,13 @@ public:
         }
     }
 
-    void QueryRadius(const FVector2D& Center, float Radius, TArray<FQuadtreePoint>& OutPoints) const
+    template<typename ContainerType>
+    void QueryRadius(const FVector2D& Center, float Radius, ContainerType& OutPoints) const
     {
         FQuadtreeBounds Range(Center, FVector2D(Radius, Radius));
-        TArray<FQuadtreePoint> CandidatePoints;
+
+        // Candidates from the bounding square; usually a handful, so they stay on the stack.
+        CustomSmallVector<FQuadtreePoint, 32> CandidatePoints;
         Query(Range, CandidatePoints);
 
         float RadiusSquared = Radius * Radius;
@@ -187,9 +195,11 @@ public:
         }
     }
 
+    // Removes every point but keeps the nodes and their storage, so rebuilding a similar
+    // distribution every frame allocates nothing. Empty subdivided nodes cost one bounds test per query.
     void Clear()
     {
-        Points.Empty();
+        Points.Reset();
         
         if (bSubdivided)
         {
@@ -197,13 +207,6 @@ public:
             NorthEast->Clear();
             SouthWest->Clear();
             SouthEast->Clear();
-            
-            NorthWest.Reset();
-            NorthEast.Reset();
-            SouthWest.Reset();
-            SouthEast.Reset();
-            
-            bSubdivided = false;
         }
     }
 
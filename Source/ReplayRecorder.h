@@ -0,0 +1,420 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "GameStateSnapshot.h"
+#include "GameStateBinaryFormat.h"
+#include "GameplayRandom.h"
+#include "ReplayRecorder.generated.h"
+
+/**
+ * FReplayInputEvent:
+ * One recorded player input (action id chosen by the caller, plus an analog value).
+ */
+USTRUCT(BlueprintType)
+struct FReplayInputEvent
+{
+    GENERATED_BODY()
+
+    // Frame the input was applied on.
+    UPROPERTY(BlueprintReadOnly)
+    int32 Frame = 0;
+
+    // Caller-defined action identifier (e.g. fire, reload, move).
+    UPROPERTY(BlueprintReadOnly)
+    int32 ActionId = 0;
+
+    // Analog payload (movement axes, look deltas); zero for buttons.
+    UPROPERTY(BlueprintReadOnly)
+    FVector Value = FVector::ZeroVector;
+};
+
+/**
+ * Replay:
+ * Streaming replay file used to reproduce sessions offline.
+ *
+ * File Layout: FFileHeader, then a stream of records { uint8 Type, uint32 Frame, uint32 Size, payload }.
+ * - Frame    : DeltaTime + the GameplayRandom seed used for that frame.
+ * - Input    : ActionId + Value.
+ * - Keyframe : A full snapshot in the compact binary format (GameStateBinaryFormat.h).
+ *
+ * Determinism: the recorder reseeds GameplayRandom at the start of every frame and logs the seed.
+ * Playback restores the same seed, so every roll within the frame is identical regardless of
+ * how many rolls earlier frames made.
+ *
+ * Seeking: jump to the nearest keyframe at or before the target (binary search over the keyframe
+ * index), then fast-forward through the remaining frame/input records headlessly.
+ */
+namespace Replay
+{
+    static constexpr uint32 FileMagic = 0x31525347; // 'GSR1'
+    static constexpr uint32 FileVersion = 1;
+
+    enum class ERecordType : uint8
+    {
+        Frame    = 1,
+        Input    = 2,
+        Keyframe = 3
+    };
+
+    struct FFileHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 KeyframeInterval;
+        uint32 Reserved;
+    };
+
+    #pragma pack(push, 1)
+    struct FRecordHeader
+    {
+        uint8 Type;
+        uint32 Frame;
+        uint32 Size;
+    };
+
+    struct FFramePayload
+    {
+        float DeltaTime;
+        int32 Seed;
+    };
+
+    struct FInputPayload
+    {
+        int32 ActionId;
+        float Value[3];
+    };
+    #pragma pack(pop)
+
+    inline FString GetReplayPath(const FString& ReplayName)
+    {
+        return FPaths::ProjectSavedDir() / TEXT("Replays") / (ReplayName + TEXT(".gsr"));
+    }
+}
+
+/**
+ * FReplayRecorder:
+ * Appends frame, input and keyframe records to a replay file as the session runs.
+ */
+class FReplayRecorder
+{
+private:
+    TUniquePtr<FArchive> Writer;
+    // Frame being recorded: stays N from BeginFrame(N) until the next BeginFrame, so inputs land on N.
+    uint32 RecordingFrame;
+    // False until the first BeginFrame after Start; no records are written before it.
+    bool bFrameStarted;
+    uint32 KeyframeInterval;
+    int64 BytesWritten;
+
+    void WriteRecord(Replay::ERecordType Type, const void* Payload, uint32 Size)
+    {
+        Replay::FRecordHeader Header;
+        Header.Type = (uint8)Type;
+        Header.Frame = RecordingFrame;
+        Header.Size = Size;
+        Writer->Serialize(&Header, sizeof(Header));
+        Writer->Serialize(const_cast<void*>(Payload), Size);
+        BytesWritten += sizeof(Header) + Size;
+    }
+
+public:
+    FReplayRecorder()
+        : RecordingFrame(0), bFrameStarted(false), KeyframeInterval(300), BytesWritten(0)
+    {
+    }
+
+    bool Start(const FString& ReplayName, int32 InKeyframeInterval)
+    {
+        Stop();
+
+        Writer.Reset(IFileManager::Get().CreateFileWriter(*Replay::GetReplayPath(ReplayName)));
+        if (!Writer.IsValid())
+        {
+            return false;
+        }
+
+        KeyframeInterval = (uint32)FMath::Max(1, InKeyframeInterval);
+        RecordingFrame = 0;
+        bFrameStarted = false;
+        BytesWritten = 0;
+
+        Replay::FFileHeader Header;
+        Header.Magic = Replay::FileMagic;
+        Header.Version = Replay::FileVersion;
+        Header.KeyframeInterval = KeyframeInterval;
+        Header.Reserved = 0;
+        Writer->Serialize(&Header, sizeof(Header));
+        BytesWritten += sizeof(Header);
+        return true;
+    }
+
+    void Stop()
+    {
+        if (Writer.IsValid())
+        {
+            Writer->Close();
+            Writer.Reset();
+        }
+    }
+
+    bool IsRecording() const { return Writer.IsValid(); }
+
+    /**
+     * Begin a new frame: closes the previous one, picks and applies the frame's RNG seed, and
+     * writes a keyframe of State on keyframe boundaries (see IsKeyframeDue). Call once per frame
+     * before gameplay runs; State must be the world as of the end of the previous frame. Without
+     * one the keyframe is skipped, and seeks fall back to the one before it.
+     */
+    void BeginFrame(float DeltaTime, const FGameStateSnapshot* State)
+    {
+        if (!IsRecording())
+        {
+            return;
+        }
+
+        RecordingFrame = GetNextFrame();
+        bFrameStarted = true;
+
+        if (RecordingFrame % KeyframeInterval == 0 && State == nullptr)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[Replay] No snapshot for the keyframe at frame %u; skipped"), RecordingFrame);
+        }
+        else if (RecordingFrame % KeyframeInterval == 0)
+        {
+            TArray<uint8> Keyframe;
+            GameStateBinary::Encode(*State, Keyframe);
+            WriteRecord(Replay::ERecordType::Keyframe, Keyframe.GetData(), Keyframe.Num());
+
+            // Keyframes are the seek points; make sure they reach disk.
+            Writer->Flush();
+        }
+
+        Replay::FFramePayload Payload;
+        Payload.DeltaTime = DeltaTime;
+        Payload.Seed = GameplayRandom::NextSeed();
+        GameplayRandom::Seed(Payload.Seed);
+        WriteRecord(Replay::ERecordType::Frame, &Payload, sizeof(Payload));
+    }
+
+    // Log an input applied during the frame being recorded. Inputs before the first BeginFrame are dropped.
+    void RecordInput(int32 ActionId, const FVector& Value)
+    {
+        if (!IsRecording() || !bFrameStarted)
+        {
+            return;
+        }
+
+        Replay::FInputPayload Payload;
+        Payload.ActionId = ActionId;
+        Payload.Value[0] = (float)Value.X;
+        Payload.Value[1] = (float)Value.Y;
+        Payload.Value[2] = (float)Value.Z;
+        WriteRecord(Replay::ERecordType::Input, &Payload, sizeof(Payload));
+    }
+
+    // Frame the next BeginFrame will open.
+    uint32 GetNextFrame() const { return bFrameStarted ? RecordingFrame + 1 : 0; }
+
+    // True if the next BeginFrame writes a keyframe, i.e. its State argument will be read.
+    bool IsKeyframeDue() const { return GetNextFrame() % KeyframeInterval == 0; }
+
+    // Number of frames begun since Start.
+    uint32 GetNumFrames() const { return GetNextFrame(); }
+    int64 GetBytesWritten() const { return BytesWritten; }
+};
+
+/**
+ * FReplayPlayer:
+ * Loads a replay, indexes its keyframes, seeks and fast-forwards without rendering.
+ */
+class FReplayPlayer
+{
+private:
+    struct FKeyframeEntry
+    {
+        uint32 Frame;
+        int64 Offset; // Offset of the keyframe record header.
+    };
+
+    TArray<uint8> Data;
+    TArray<FKeyframeEntry> Keyframes;
+    uint32 TotalFrames;
+
+    const Replay::FRecordHeader* RecordAt(int64 Offset) const
+    {
+        if (Offset + (int64)sizeof(Replay::FRecordHeader) > Data.Num())
+        {
+            return nullptr;
+        }
+        const Replay::FRecordHeader* Header = reinterpret_cast<const Replay::FRecordHeader*>(Data.GetData() + Offset);
+        return Offset + (int64)sizeof(Replay::FRecordHeader) + Header->Size <= Data.Num() ? Header : nullptr;
+    }
+
+public:
+    FReplayPlayer()
+        : TotalFrames(0)
+    {
+    }
+
+    /**
+     * Load the file and build the keyframe index by skipping from record to record.
+     * Time Complexity: O(r) where r is the number of records
+     */
+    bool Open(const FString& ReplayName)
+    {
+        Data.Empty();
+        Keyframes.Empty();
+        TotalFrames = 0;
+
+        if (!FFileHelper::LoadFileToArray(Data, *Replay::GetReplayPath(ReplayName), FILEREAD_Silent) ||
+            Data.Num() < (int32)sizeof(Replay::FFileHeader))
+        {
+            return false;
+        }
+
+        const Replay::FFileHeader& Header = *reinterpret_cast<const Replay::FFileHeader*>(Data.GetData());
+        if (Header.Magic != Replay::FileMagic || Header.Version != Replay::FileVersion)
+        {
+            return false;
+        }
+
+        // A truncated tail (session crashed mid-record) simply ends the index.
+        int64 Offset = sizeof(Replay::FFileHeader);
+        while (const Replay::FRecordHeader* Record = RecordAt(Offset))
+        {
+            if (Record->Type == (uint8)Replay::ERecordType::Keyframe)
+            {
+                Keyframes.Add({ Record->Frame, Offset });
+            }
+            else if (Record->Type == (uint8)Replay::ERecordType::Frame)
+            {
+                TotalFrames = Record->Frame + 1;
+            }
+            Offset += sizeof(Replay::FRecordHeader) + Record->Size;
+        }
+
+        return Keyframes.Num() > 0;
+    }
+
+    uint32 GetTotalFrames() const { return TotalFrames; }
+    int32 GetNumKeyframes() const { return Keyframes.Num(); }
+
+    /**
+     * Seek to TargetFrame: restore the nearest keyframe at or before it, then fast-forward.
+     * OnRestored(State) is called once with the keyframe, before any frame is replayed.
+     * OnFrame(Frame, DeltaTime, Inputs) is called for every frame in [keyframe, TargetFrame) with
+     * GameplayRandom reseeded for it and all of its inputs; it should run one simulation step.
+     * On return GameplayRandom is seeded for TargetFrame itself (if it was recorded), so the
+     * caller can simulate it next.
+     * Time Complexity: O(log k) keyframe lookup + O(f) records replayed (f <= keyframe interval)
+     */
+    bool Seek(uint32 TargetFrame, FGameStateSnapshot& OutState,
+              TFunctionRef<void(const FGameStateSnapshot&)> OnRestored,
+              TFunctionRef<void(uint32, float, const TArray<FReplayInputEvent>&)> OnFrame) const
+    {
+        if (Keyframes.Num() == 0)
+        {
+            return false;
+        }
+
+        // Binary search for the last keyframe with Frame <= TargetFrame.
+        int32 Low = 0;
+        int32 High = Keyframes.Num() - 1;
+        int32 Found = 0;
+        while (Low <= High)
+        {
+            const int32 Mid = Low + (High - Low) / 2;
+            if (Keyframes[Mid].Frame <= TargetFrame)
+            {
+                Found = Mid;
+                Low = Mid + 1;
+            }
+            else
+            {
+                High = Mid - 1;
+            }
+        }
+
+        int64 Offset = Keyframes[Found].Offset;
+        const Replay::FRecordHeader* KeyRecord = RecordAt(Offset);
+        FGameStateBinaryView View;
+        if (KeyRecord == nullptr ||
+            !View.Initialize(Data.GetData() + Offset + sizeof(Replay::FRecordHeader), KeyRecord->Size))
+        {
+            return false;
+        }
+        View.ToSnapshot(OutState);
+        OnRestored(OutState);
+        Offset += sizeof(Replay::FRecordHeader) + KeyRecord->Size;
+
+        // A frame's inputs follow its Frame record, so each frame is stepped once the next one starts.
+        bool bFramePending = false;
+        uint32 PendingFrame = 0;
+        Replay::FFramePayload PendingPayload = {};
+        TArray<FReplayInputEvent> PendingInputs;
+
+        auto StepPendingFrame = [&]()
+        {
+            if (bFramePending)
+            {
+                GameplayRandom::Seed(PendingPayload.Seed);
+                OnFrame(PendingFrame, PendingPayload.DeltaTime, PendingInputs);
+                PendingInputs.Reset();
+                bFramePending = false;
+            }
+        };
+
+        // Fast-forward: replay frames [keyframe, TargetFrame) with their recorded seeds and inputs.
+        while (const Replay::FRecordHeader* Record = RecordAt(Offset))
+        {
+            const uint8* Payload = Data.GetData() + Offset + sizeof(Replay::FRecordHeader);
+            const bool bIsFrame = Record->Type == (uint8)Replay::ERecordType::Frame && Record->Size == sizeof(Replay::FFramePayload);
+
+            if (Record->Frame >= TargetFrame)
+            {
+                StepPendingFrame();
+
+                // Leave the RNG ready for TargetFrame; its keyframe (if any) precedes its Frame record.
+                if (Record->Frame > TargetFrame)
+                {
+                    break;
+                }
+                if (bIsFrame)
+                {
+                    Replay::FFramePayload FramePayload;
+                    FMemory::Memcpy(&FramePayload, Payload, sizeof(FramePayload));
+                    GameplayRandom::Seed(FramePayload.Seed);
+                    break;
+                }
+            }
+            else if (bIsFrame)
+            {
+                StepPendingFrame();
+                FMemory::Memcpy(&PendingPayload, Payload, sizeof(PendingPayload));
+                PendingFrame = Record->Frame;
+                bFramePending = true;
+            }
+            else if (Record->Type == (uint8)Replay::ERecordType::Input && Record->Size == sizeof(Replay::FInputPayload))
+            {
+                Replay::FInputPayload InputPayload;
+                FMemory::Memcpy(&InputPayload, Payload, sizeof(InputPayload));
+
+                FReplayInputEvent Event;
+                Event.Frame = Record->Frame;
+                Event.ActionId = InputPayload.ActionId;
+                Event.Value = FVector(InputPayload.Value[0], InputPayload.Value[1], InputPayload.Value[2]);
+                PendingInputs.Add(Event);
+            }
+
+            Offset += sizeof(Replay::FRecordHeader) + Record->Size;
+        }
+
+        // Truncated tail: the last recorded frame still gets its step.
+        StepPendingFrame();
+        return true;
+    }
+};
@@ -21,8 +21,8 @@ namespace SortingAlgorithms
      * Description: Picks a pivot element, partitions the array around the pivot, 
      * and recursively sorts sub-arrays.
      */
-    template<typename T, typename PredicateType>
-    int32 Partition(TArray<T>& Array, int32 Low, int32 High, PredicateType Predicate)
+    template<typename T, typename AllocatorType, typename PredicateType>
+    int32 Partition(TArray<T, AllocatorType>& Array, int32 Low, int32 High, PredicateType Predicate)
     {
         // Choose the last element as the pivot.
         T Pivot = Array[High];
@@ -49,8 +49,8 @@ namespace SortingAlgorithms
         return i + 1; // Return partition index.
     }
 
-    template<typename T, typename PredicateType>
-    void QuickSortRecursive(TArray<T>& Array, int32 Low, int32 High, PredicateType Predicate)
+    template<typename T, typename AllocatorType, typename PredicateType>
+    void QuickSortRecursive(TArray<T, AllocatorType>& Array, int32 Low, int32 High, PredicateType Predicate)
     {
         if (Low < High)
         {
@@ -64,8 +64,9 @@ namespace SortingAlgorithms
     }
 
     // Public wrapper for QuickSort allowing custom predicates (comparison logic).
-    template<typename T, typename PredicateType>
-    void QuickSort(TArray<T>& Array, PredicateType Predicate)
+    // Works with any TArray allocator (e.g. TFrameArray scratch lists).
+    template<typename T, typename AllocatorType, typename PredicateType>
+    void QuickSort(TArray<T, AllocatorType>& Array, PredicateType Predicate)
     {
         if (Array.Num() > 1)
         {
@@ -74,8 +75,8 @@ namespace SortingAlgorithms
     }
 
     // Overload for QuickSort using standard less-than operator.
-    template<typename T>
-    void QuickSort(TArray<T>& Array)
+    template<typename T, typename AllocatorType>
+    void QuickSort(TArray<T, AllocatorType>& Array)
     {
         QuickSort(Array, [](const T& A, const T& B) { return A < B; });
     }
@@ -9,7 +9,11 @@
 #include "Kismet/GameplayStatics.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
-#include "HealthInterface.h"
+#include "HitscanResolver.h"
+#include "ProjectileManager.h"
+#include "CombatAudioScheduler.h"
+#include "GameplayRandom.h"
+#include "GameplayDataSubsystem.h"
 
 // Sets default values for this component's properties
 UTP_WeaponComponent::UTP_WeaponComponent()
@@ -21,8 +25,8 @@ UTP_WeaponComponent::UTP_WeaponComponent()
 
 /**
  * Fire the weapon:
- * - Performs line trace to detect hits
- * - Applies damage to hit targets implementing IHealthInterface
+ * - Queues one ray per pellet with the hitscan resolver (hits and damage are resolved in a batch next frame),
+ *   or launches pellets as simulated projectiles when m_bFireProjectiles is set
  * - Plays sound and visual effects
  * - Decrements ammo
  */
@@ -44,7 +48,7 @@ void UTP_WeaponComponent::Fire()
 		// Check clip is not empty.
 		if (m_iCurrentAmmo <= 0)
 		{    // Play empty clip sound if no ammo
-			UGameplayStatics::PlaySoundAtLocation(world, EmptyClipSound, playerLocation);
+			world->GetSubsystem<UCombatAudioScheduler>()->RequestSound(EmptyClipSound, playerLocation, ECombatSoundCategory::Weapon, 3.0f);
 			return;
 		}
 		
@@ -56,26 +60,33 @@ void UTP_WeaponComponent::Fire()
 		queryParams.AddIgnoredActor(playerController->GetPawn());
 		queryParams.AddIgnoredActor(GetOwner());
 
-		// Setup the hit result.
-		FHitResult outHit;
+		const FVector aimDirection = spawnRotation.Vector();
+		const float fHalfSpread = FMath::DegreesToRadians(m_fSpreadAngle * 0.5f);
+		const int iPellets = FMath::Max(1, m_iPelletsPerShot);
 
-        // Perform line trace for hits along camera forward vector
-		world->LineTraceSingleByChannel(outHit, spawnLocation, spawnLocation + (spawnRotation.Vector() * 3000), ECollisionChannel::ECC_Pawn, queryParams);
-		DrawDebugLine(world, spawnLocation, spawnLocation + (spawnRotation.Vector() * 3000), FColor::Red, false, 1.0f, 5, 10.0f);
-
-		// Try to hit a damageable object.
-		IHealthInterface* pHealth = Cast<IHealthInterface>(outHit.GetActor());
-		if (pHealth != nullptr)
+		if (m_bFireProjectiles)
 		{
-			// Deal damage
-			float damageDealt = GetShotDamage();
-			pHealth->ReceiveDamage(damageDealt);
+			// Projectiles are simulated as data by the manager; no actor is spawned per shot.
+			UProjectileManager* pProjectiles = world->GetSubsystem<UProjectileManager>();
+			pProjectiles->SetProxyClass(ProjectileClass);
+			for (int i = 0; i < iPellets; i++)
+			{
+				const FVector direction = fHalfSpread > 0.0f ? GameplayRandom::VRandCone(aimDirection, fHalfSpread) : aimDirection;
+				pProjectiles->SpawnProjectile(spawnLocation, direction * m_fProjectileSpeed, GetShotDamage(), m_pCharacter);
+			}
 		}
 		else
 		{
-			// Play environmental sounds.
-			auto sound = EnvironmentalSounds[FMath::RandRange(0, EnvironmentalSounds.Num() - 1)];
-			UGameplayStatics::PlaySoundAtLocation(world, sound, playerLocation);
+			// Queue the rays; the resolver batches every shot fired this frame and applies damage in one pass.
+			UHitscanResolver* pResolver = world->GetSubsystem<UHitscanResolver>();
+			USoundBase* missSound = EnvironmentalSounds.Num() > 0 ? EnvironmentalSounds[GameplayRandom::RandRange(0, EnvironmentalSounds.Num() - 1)] : nullptr;
+			const int32 iShot = pResolver->BeginShot(queryParams, missSound, playerLocation, m_bDrawDebugTraces);
+
+			for (int i = 0; i < iPellets; i++)
+			{
+				const FVector direction = fHalfSpread > 0.0f ? GameplayRandom::VRandCone(aimDirection, fHalfSpread) : aimDirection;
+				pResolver->AddRay(iShot, spawnLocation, spawnLocation + (direction * m_fRange), GetShotDamage());
+			}
 		}
 
         // Reduce ammo count
@@ -83,9 +94,9 @@ void UTP_WeaponComponent::Fire()
 	}
 	
     // Play firing sound if assigned
-	if (FireSound != nullptr)
+	if (FireSound != nullptr && world != nullptr)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, FireSound, playerLocation);
+		world->GetSubsystem<UCombatAudioScheduler>()->RequestSound(FireSound, playerLocation, ECombatSoundCategory::Weapon, 3.0f);
 	}
 
     // Spawn muzzle flash particle system if assigned
@@ -128,13 +139,15 @@ bool UTP_WeaponComponent::CanReload()
  * - Attaches mesh to character's weapon socket
  * - Binds input actions using Enhanced Input
  */
-void UT
 void UTP_WeaponComponent::AttachWeapon(AFpsCharacter* TargetCharacter)
 {
 	m_pCharacter = TargetCharacter;
 	if (m_pCharacter == nullptr)
 		return;
 
+	// Cooked tuning data overrides the Blueprint defaults
+	ApplyGameplayData();
+
 	// Attach the weapon to the First Person Character
 	FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, true);
 	USkeletalMeshComponent* pCharacterMesh = m_pCharacter->GetMesh1P();
@@ -159,7 +172,21 @@ void UTP_WeaponComponent::AttachWeapon(AFpsCharacter* TargetCharacter)
 /** Returns a random damage value within the weapon's damage range */
 float UTP_WeaponComponent::GetShotDamage()
 {
-    return FMath::RandRange(m_fDamagePerShotMin, m_fDamagePerShotMax);
+    return GameplayRandom::FRandRange(m_fDamagePerShotMin, m_fDamagePerShotMax);
+}
+/** Reads the weapon's row in place from the mapped gameplay data table */
+void UTP_WeaponComponent::ApplyGameplayData()
+{
+	const FGameplayDataView* pData = UGameplayDataSubsystem::Get(this);
+	const GameplayData::FWeaponRecord* pWeapon = pData != nullptr ? pData->FindWeapon(m_GameplayDataRow) : nullptr;
+	if (pWeapon == nullptr)
+		return;
+
+	m_fDamagePerShotMin = pWeapon->DamageMin;
+	m_fDamagePerShotMax = pWeapon->DamageMax;
+	m_iPelletsPerShot = pWeapon->PelletsPerShot;
+	m_fSpreadAngle = pWeapon->SpreadAngle;
+	m_fRange = pWeapon->Range;
 }
 /** Returns ammo in holstered reserve */
 int UTP_WeaponComponent::GetHolsteredAmmoAvailable()
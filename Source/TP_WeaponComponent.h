@@ -97,6 +97,33 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
 	float m_fDamagePerShotMax;
 
+    /** Rays per trigger pull (1 for rifles, more for shotguns) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	int m_iPelletsPerShot = 1;
+    /** Full spread cone angle in degrees (0 = perfectly accurate) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	float m_fSpreadAngle = 0.0f;
+    /** Maximum hitscan distance */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	float m_fRange = 3000.0f;
+    /** Row in the cooked gameplay data tables overriding the damage settings above (None keeps them) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	FName m_GameplayDataRow;
+
+    /** Fire simulated projectiles (UProjectileManager) instead of hitscan rays */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Projectile")
+	bool m_bFireProjectiles = false;
+    /** Launch speed of fired projectiles */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Projectile")
+	float m_fProjectileSpeed = 3000.0f;
+    /** Visual used for projectiles near the camera (pooled, never spawned per shot) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Projectile")
+	TSubclassOf<class Aproject_goldfishProjectile> ProjectileClass;
+
+    /** Draw resolved shot rays (only in builds with debug drawing enabled) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
+	bool m_bDrawDebugTraces = false;
+
     /** Ammo in the weapon's clip */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ammo")
 	int m_iClipSize = 8;
@@ -111,6 +138,9 @@ protected:
 	int m_iHolsteredAmmo = 0;
 
 private:
+    /** Copy the damage settings of m_GameplayDataRow from the cooked gameplay data, if present */
+	void ApplyGameplayData();
+
     /** Pointer to the character holding this weapon */
 	AFpsCharacter* m_pCharacter;
 };
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UIEventBus.h"
+
+void UUIEventBus::Publish(EUIChannel Channel, int32 Value, int32 SecondaryValue)
+{
+	if (Channel >= EUIChannel::Count)
+		return;
+
+	FChannelState& state = m_Channels[(int32)Channel];
+	m_iPublished++;
+
+	// Already waiting for a flush: this value replaces the pending one.
+	if (state.bDirty)
+	{
+		m_iCoalesced++;
+	}
+
+	state.Value = Value;
+	state.SecondaryValue = SecondaryValue;
+	state.bDirty = true;
+}
+
+void UUIEventBus::SetFlushRate(float FlushesPerSecond)
+{
+	m_fFlushInterval = FlushesPerSecond > 0.0f ? 1.0f / FlushesPerSecond : 0.0f;
+}
+
+void UUIEventBus::Flush()
+{
+	m_fTimeSinceFlush = 0.0f;
+
+	for (int32 i = 0; i < (int32)EUIChannel::Count; i++)
+	{
+		FChannelState& state = m_Channels[i];
+		if (!state.bDirty)
+			continue;
+
+		// Clear first so listeners that publish in response land in the next flush.
+		state.bDirty = false;
+		OnChannelChanged.Broadcast((EUIChannel)i, state.Value, state.SecondaryValue);
+		m_iBroadcasts++;
+	}
+}
+
+void UUIEventBus::GetLatestValue(EUIChannel Channel, int32& OutValue, int32& OutSecondaryValue) const
+{
+	OutValue = 0;
+	OutSecondaryValue = 0;
+	if (Channel < EUIChannel::Count)
+	{
+		OutValue = m_Channels[(int32)Channel].Value;
+		OutSecondaryValue = m_Channels[(int32)Channel].SecondaryValue;
+	}
+}
+
+void UUIEventBus::GetCoalescingStats(int32& OutPublished, int32& OutBroadcasts, int32& OutCoalesced) const
+{
+	OutPublished = m_iPublished;
+	OutBroadcasts = m_iBroadcasts;
+	OutCoalesced = m_iCoalesced;
+}
+
+void UUIEventBus::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	m_fTimeSinceFlush += DeltaTime;
+	if (m_fTimeSinceFlush >= m_fFlushInterval)
+	{
+		Flush();
+	}
+}
+
+TStatId UUIEventBus::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUIEventBus, STATGROUP_Tickables);
+}
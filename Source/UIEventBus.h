@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UIEventBus.generated.h"
+
+// Values the HUD displays.
+UENUM(BlueprintType)
+enum class EUIChannel : uint8
+{
+	Points,
+	// No native publisher yet for Ammo and Health: AFpsCharacter still broadcasts
+	// OnAmmoChanged and OnPlayerHealthChanged directly.
+	Ammo,
+	Health,
+	Wave,
+	Count UMETA(Hidden)
+};
+
+/**
+ * Delegate broadcast when a channel is flushed.
+ *
+ * @param Channel Which value changed.
+ * @param Value Latest value (points, magazine ammo, current health, wave).
+ * @param SecondaryValue Latest secondary value (reserve ammo, max health; 0 otherwise).
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnUIChannelChanged, EUIChannel, Channel, int32, Value, int32, SecondaryValue);
+
+/**
+ * UUIEventBus:
+ * Coalesces HUD updates. Gameplay code publishes values as often as they change; the bus only marks
+ * the channel dirty and keeps the latest value. Dirty channels are broadcast at most once per frame,
+ * or at most m_fFlushInterval seconds apart when a flush rate is set, so widgets update once no matter
+ * how many hits, shots or heals happened in between.
+ */
+UCLASS()
+class PROJECT_GOLDFISH_API UUIEventBus : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Fired once per flush for every dirty channel.
+	UPROPERTY(BlueprintAssignable)
+	FOnUIChannelChanged OnChannelChanged;
+
+	// Record the latest value for a channel. Broadcast happens at the next flush.
+	UFUNCTION(BlueprintCallable, Category="UI")
+	void Publish(EUIChannel Channel, int32 Value, int32 SecondaryValue = 0);
+
+	// Flushes per second; 0 flushes every frame.
+	UFUNCTION(BlueprintCallable, Category="UI")
+	void SetFlushRate(float FlushesPerSecond);
+
+	// Broadcast every dirty channel immediately.
+	UFUNCTION(BlueprintCallable, Category="UI")
+	void Flush();
+
+	// Latest published value of a channel (whether or not it has been flushed).
+	UFUNCTION(BlueprintPure, Category="UI")
+	void GetLatestValue(EUIChannel Channel, int32& OutValue, int32& OutSecondaryValue) const;
+
+	// Total publishes, broadcasts actually sent, and publishes absorbed by coalescing.
+	UFUNCTION(BlueprintPure, Category="Performance")
+	void GetCoalescingStats(int32& OutPublished, int32& OutBroadcasts, int32& OutCoalesced) const;
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FChannelState
+	{
+		int32 Value = 0;
+		int32 SecondaryValue = 0;
+		bool bDirty = false;
+	};
+
+	FChannelState m_Channels[(int32)EUIChannel::Count];
+
+	float m_fFlushInterval = 0.0f;
+	float m_fTimeSinceFlush = 0.0f;
+
+	// Stats.
+	int32 m_iPublished = 0;
+	int32 m_iBroadcasts = 0;
+	int32 m_iCoalesced = 0;
+};
@@ -0,0 +1,182 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Curves/CurveFloat.h"
+#include "WaveCurveTable.generated.h"
+
+/**
+ * Shape used to bake a wave-difficulty curve.
+ * All shapes map wave progress p = (Wave - 1) / GrowthWaves, clamped to [0, 1],
+ * to a fraction of the way from the initial to the final value.
+ */
+UENUM(BlueprintType)
+enum class EWaveCurveShape : uint8
+{
+    // The original linear growth (bit-identical to the old per-wave formula).
+    Linear,
+    // (e^(k p) - 1) / (e^k - 1): slow start, steep finish for k > 0.
+    Exponential,
+    // Linear interpolation through (progress, fraction) control points.
+    Piecewise,
+    // Designer UCurveFloat sampled at progress 0..1, output fraction 0..1.
+    Curve
+};
+
+/**
+ * FWaveCurveSettings:
+ * Designer description of one wave curve. Baked into a TWaveCurve at BeginPlay.
+ */
+USTRUCT(BlueprintType)
+struct FWaveCurveSettings
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves")
+    EWaveCurveShape Shape = EWaveCurveShape::Linear;
+
+    // Steepness k for the Exponential shape (values near 0 approach linear).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves", meta=(EditCondition="Shape == EWaveCurveShape::Exponential"))
+    float Exponent = 3.0f;
+
+    // (progress, fraction) control points for the Piecewise shape, in increasing progress order.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves", meta=(EditCondition="Shape == EWaveCurveShape::Piecewise"))
+    TArray<FVector2D> Points;
+
+    // Curve for the Curve shape.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Waves", meta=(EditCondition="Shape == EWaveCurveShape::Curve"))
+    UCurveFloat* Curve = nullptr;
+};
+
+/**
+ * WaveCurves:
+ * Wave-difficulty tables generated once and indexed by wave number.
+ * * The generators are constexpr, so the default tables below are built at compile time and
+ *   the same code bakes designer settings at BeginPlay.
+ * * Lookups are O(1) and depend only on the wave number (no accumulated state), so any code
+ *   reproducing a session offline (replay fast-forward, a headless simulator) gets identical values.
+ */
+namespace WaveCurves
+{
+    // Number of baked waves. Later waves reuse the last entry (all growth has stopped long before).
+    constexpr int32 TableSize = 256;
+
+    /**
+     * TWaveCurve:
+     * Fixed-size table of per-wave values. Index 0 is wave 1.
+     */
+    template<typename T>
+    struct TWaveCurve
+    {
+        T Values[TableSize] = {};
+
+        constexpr T Get(int32 Wave) const
+        {
+            const int32 Index = Wave < 1 ? 0 : (Wave > TableSize ? TableSize - 1 : Wave - 1);
+            return Values[Index];
+        }
+    };
+
+    // The original linear growth for one wave: Min(Final, Initial + (int)((Wave - 1) * (Final - Initial) / GrowthWaves)).
+    constexpr int32 LinearValue(int32 Initial, int32 Final, int32 GrowthWaves, int32 Wave)
+    {
+        const float RateOfGrowth = GrowthWaves > 0 ? (float)(Final - Initial) / GrowthWaves : 0.0f;
+        const int32 Value = Initial + (int32)((Wave - 1) * RateOfGrowth);
+        return Value < Final ? Value : Final;
+    }
+
+    // Fixed step per wave, clamped to [0, Final] (the old cumulative walk speed increase).
+    constexpr float SteppedValue(float Initial, float Step, float Final, int32 Wave)
+    {
+        const float Value = Initial + Step * Wave;
+        return Value < 0.0f ? 0.0f : (Value > Final ? Final : Value);
+    }
+
+    constexpr TWaveCurve<int32> MakeLinear(int32 Initial, int32 Final, int32 GrowthWaves)
+    {
+        TWaveCurve<int32> Curve;
+        for (int32 i = 0; i < TableSize; ++i)
+        {
+            Curve.Values[i] = LinearValue(Initial, Final, GrowthWaves, i + 1);
+        }
+        return Curve;
+    }
+
+    constexpr TWaveCurve<float> MakeStepped(float Initial, float Step, float Final)
+    {
+        TWaveCurve<float> Curve;
+        for (int32 i = 0; i < TableSize; ++i)
+        {
+            Curve.Values[i] = SteppedValue(Initial, Step, Final, i + 1);
+        }
+        return Curve;
+    }
+
+    // Default director tables (same values as the director property defaults).
+    constexpr TWaveCurve<int32> DefaultWaveSizes = MakeLinear(5, 666, 50);
+    constexpr TWaveCurve<int32> DefaultArenaCapacities = MakeLinear(5, 50, 22);
+    constexpr TWaveCurve<float> DefaultMaxWalkSpeeds = MakeStepped(120.0f, 50.0f, 400.0f);
+    constexpr TWaveCurve<float> DefaultMinWalkSpeeds = MakeStepped(70.0f, 15.0f, 200.0f);
+
+    static_assert(DefaultWaveSizes.Get(1) == 5 && DefaultWaveSizes.Get(51) == 666, "Wave size curve endpoints");
+    static_assert(DefaultArenaCapacities.Get(1) == 5 && DefaultArenaCapacities.Get(23) == 50, "Arena capacity curve endpoints");
+    static_assert(DefaultMaxWalkSpeeds.Get(1) == 170.0f && DefaultMaxWalkSpeeds.Get(TableSize) == 400.0f, "Walk speed curve endpoints");
+
+    // Fraction of the way from initial to final value at progress P for the non-linear shapes.
+    inline float EvaluateFraction(const FWaveCurveSettings& Settings, float P)
+    {
+        switch (Settings.Shape)
+        {
+        case EWaveCurveShape::Exponential:
+            if (FMath::Abs(Settings.Exponent) < UE_KINDA_SMALL_NUMBER)
+                return P;
+            return (FMath::Exp(Settings.Exponent * P) - 1.0f) / (FMath::Exp(Settings.Exponent) - 1.0f);
+
+        case EWaveCurveShape::Piecewise:
+        {
+            const TArray<FVector2D>& Points = Settings.Points;
+            if (Points.Num() == 0)
+                return P;
+            if (P <= Points[0].X)
+                return (float)Points[0].Y;
+
+            for (int32 i = 1; i < Points.Num(); ++i)
+            {
+                if (P <= Points[i].X)
+                {
+                    const double Span = Points[i].X - Points[i - 1].X;
+                    const double Alpha = Span > 0.0 ? (P - Points[i - 1].X) / Span : 1.0;
+                    return (float)FMath::Lerp(Points[i - 1].Y, Points[i].Y, Alpha);
+                }
+            }
+            return (float)Points.Last().Y;
+        }
+
+        case EWaveCurveShape::Curve:
+            return Settings.Curve ? Settings.Curve->GetFloatValue(P) : P;
+
+        case EWaveCurveShape::Linear:
+        default:
+            return P;
+        }
+    }
+
+    /**
+     * Bake a designer curve from Initial (wave 1) to Final (wave GrowthWaves + 1 and beyond).
+     * Linear uses the exact original formula; other shapes are truncated to whole enemies.
+     */
+    inline TWaveCurve<int32> Bake(const FWaveCurveSettings& Settings, int32 Initial, int32 Final, int32 GrowthWaves)
+    {
+        if (Settings.Shape == EWaveCurveShape::Linear)
+            return MakeLinear(Initial, Final, GrowthWaves);
+
+        TWaveCurve<int32> Curve;
+        for (int32 i = 0; i < TableSize; ++i)
+        {
+            const float P = GrowthWaves > 0 ? FMath::Clamp((float)i / GrowthWaves, 0.0f, 1.0f) : 1.0f;
+            Curve.Values[i] = Initial + (int32)((Final - Initial) * EvaluateFraction(Settings, P));
+        }
+        return Curve;
+    }
+}
@@ -58,3 +58,17 @@ void Aproject_goldfishProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* Ot
 		Destroy();
 	}
 }
+
+/**
+ * Strip simulation from a pooled proxy; UProjectileManager moves it directly.
+ */
+void Aproject_goldfishProjectile::MakeVisualProxy()
+{
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+	CollisionComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// Pooled proxies live as long as the world; cancel the 3 second lifespan.
+	SetLifeSpan(0.0f);
+	SetActorHiddenInGame(true);
+}
@@ -44,6 +44,12 @@ public:
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/**
+	 * Turn this actor into a pure visual driven by UProjectileManager:
+	 * no movement component, no collision, no lifespan. Starts hidden.
+	 */
+	void MakeVisualProxy();
+
 	/** Getter for the collision component */
 	USphereComponent* GetCollisionComp() const { return CollisionComp; }
 